@@ -0,0 +1,732 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Microbenchmarks of the hot paths of the library: SpMV (multiply.cu), vector kernels (blas.cu),
+// smoother sweeps, SpGEMM, the AMG setup per level and one V-cycle with and without the fused cycle
+// kernels. Every kernel is compared with the STREAM triad bandwidth measured on the same memory
+// space. A plain run covers the host and the device, results can be written as JSON.
+
+#include <core.h>
+#include <matrix.h>
+#include <vector.h>
+#include <multiply.h>
+#include <blas.h>
+#include <csr_multiply.h>
+#include <matrix_io.h>
+#include <amg_solver.h>
+#include <resources.h>
+#include <solvers/solver.h>
+#include <test_utils.h>
+#include <misc.h>
+#include <problem_generator.h>
+
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/filestream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amgx;
+
+namespace
+{
+
+struct Options
+{
+    std::vector<std::string> modes;
+    std::vector<std::string> matrices;
+    std::vector<std::string> smoothers;
+    std::string json_file;
+    int repeat;
+    int max_levels;
+    bool spmv, blas, smoother, spgemm, setup, cycle;
+
+    Options() : repeat(20), max_levels(8), spmv(true), blas(true), smoother(true), spgemm(true), setup(true), cycle(true)
+    {
+        // the host roofline next to the device one unless a mode is picked
+        modes.push_back("hDDI");
+        modes.push_back("dDDI");
+        smoothers.push_back("JACOBI_L1");
+        smoothers.push_back("BLOCK_JACOBI");
+        smoothers.push_back("MULTICOLOR_GS");
+        smoothers.push_back("MULTICOLOR_DILU");
+    }
+};
+
+struct KernelResult
+{
+    std::string name;
+    double seconds;
+    double bytes;
+    double flops;
+    bool supported;
+};
+
+struct LevelResult
+{
+    int level;
+    int rows;
+    double seconds;
+};
+
+struct MatrixResult
+{
+    std::string name;
+    int rows, nnz, block_size;
+    std::vector<KernelResult> kernels;
+    std::vector<LevelResult> levels;
+};
+
+struct ModeResult
+{
+    std::string mode;
+    double stream;
+    std::vector<MatrixResult> matrices;
+};
+
+void usage()
+{
+    printf("amgx_microbench [options]\n");
+    printf(" --mode LIST          comma separated subset of hDDI, dDDI, hDFI, dDFI, hFFI, dFFI (default hDDI,dDDI)\n");
+    printf(" --matrix SPEC        may be repeated, SPEC is one of\n");
+    printf("                        poisson5:N, poisson7:N, poisson27:N    N^2 or N^3 grid\n");
+    printf("                        aniso:N:EPS                          2D 5-point diffusion with coefficient EPS in x\n");
+    printf("                        randblock:ROWS:BSIZE                 random pattern with BSIZE x BSIZE blocks\n");
+    printf("                        gen:PROBLEM:NXxNYxNZ[:OPTIONS]       in-library generator, e.g. gen:elasticity:32x32x32:nu=0.45\n");
+    printf("                        FILE                                 MatrixMarket or AMGX binary file\n");
+    printf(" --only LIST          comma separated subset of spmv,blas,smoother,spgemm,setup,cycle\n");
+    printf(" --smoothers LIST     comma separated smoother names (default JACOBI_L1,BLOCK_JACOBI,MULTICOLOR_GS,MULTICOLOR_DILU)\n");
+    printf(" --repeat N           timed repetitions per kernel (default 20)\n");
+    printf(" --max-levels N       deepest hierarchy timed by the setup benchmark (default 8)\n");
+    printf(" --json FILE          write the results to FILE\n");
+    exit(1);
+}
+
+double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// one warm-up call, then the average over repeat calls
+template <class F>
+double time_kernel(int repeat, F f)
+{
+    f();
+    cudaDeviceSynchronize();
+    const double start = now();
+
+    for (int r = 0; r < repeat; r++)
+    {
+        f();
+    }
+
+    cudaDeviceSynchronize();
+    return (now() - start) / repeat;
+}
+
+struct triad_op
+{
+    double s;
+
+    triad_op(double _s) : s(_s) {}
+
+    template <typename T>
+    __host__ __device__ T operator()(const T &b, const T &c) const
+    {
+        return b + (T)s * c;
+    }
+};
+
+// STREAM triad a = b + s * c, the bandwidth every kernel is compared against
+template <class TConfig>
+double stream_bandwidth(int repeat)
+{
+    typedef typename TConfig::template setVecPrec<AMGX_vecDouble>::Type TConfig_dbl;
+    const int n = 1 << 25;
+    Vector<TConfig_dbl> a(n, 0.), b(n, 1.), c(n, 2.);
+    double seconds;
+
+    if (TConfig::memSpace == AMGX_host)
+    {
+        double *pa = a.raw();
+        const double *pb = b.raw(), *pc = c.raw();
+        seconds = time_kernel(repeat, [&]()
+        {
+#ifdef AMGX_WITH_OPENMP
+            #pragma omp parallel for
+#endif
+            for (int i = 0; i < n; i++)
+            {
+                pa[i] = pb[i] + 3.0 * pc[i];
+            }
+        });
+    }
+    else
+    {
+        seconds = time_kernel(repeat, [&]()
+        {
+            amgx::thrust::transform(b.begin(), b.end(), c.begin(), a.begin(), triad_op(3.0));
+        });
+    }
+
+    return 3.0 * n * sizeof(double) / seconds;
+}
+
+// 2D 5-point diffusion, -eps in x, -1 in y
+template <class TConfig_h>
+void generate_anisotropic(Matrix<TConfig_h> &A, int nx, double eps)
+{
+    const int n = nx * nx;
+    A.set_initialized(0);
+    A.addProps(CSR);
+    A.resize(n, n, 5 * n - 4 * nx, 1);
+    int nz = 0;
+
+    for (int j = 0; j < nx; j++)
+    {
+        for (int i = 0; i < nx; i++)
+        {
+            const int row = j * nx + i;
+            A.row_offsets[row] = nz;
+
+            if (j > 0) { A.col_indices[nz] = row - nx; A.values[nz++] = -1.; }
+
+            if (i > 0) { A.col_indices[nz] = row - 1; A.values[nz++] = -eps; }
+
+            A.col_indices[nz] = row;
+            A.values[nz++] = 2. + 2. * eps;
+
+            if (i < nx - 1) { A.col_indices[nz] = row + 1; A.values[nz++] = -eps; }
+
+            if (j < nx - 1) { A.col_indices[nz] = row + nx; A.values[nz++] = -1.; }
+        }
+    }
+
+    A.row_offsets[n] = nz;
+    A.set_initialized(1);
+}
+
+// random pattern with the diagonal blocks made dominant, so the smoothers stay finite
+template <class TConfig_h>
+void generate_random_block(Matrix<TConfig_h> &A, int rows, int bsize)
+{
+    srand(12345);
+    generateMatrixRandomStruct<TConfig_h>::generateExact(A, rows, false, bsize, false, 16);
+    A.set_initialized(0);
+    const int bsize_sq = bsize * bsize;
+
+    for (int i = 0; i < rows; i++)
+    {
+        const int row_nnz = A.row_offsets[i + 1] - A.row_offsets[i];
+
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            for (int k = 0; k < bsize_sq; k++)
+            {
+                const bool diag = A.col_indices[jj] == i && k / bsize == k % bsize;
+                A.values[jj * bsize_sq + k] = diag ? row_nnz * bsize + 1. : -(double)rand() / RAND_MAX;
+            }
+        }
+    }
+
+    A.set_initialized(1);
+}
+
+template <class TConfig_h>
+void build_matrix(const std::string &spec, Matrix<TConfig_h> &A)
+{
+    std::vector<std::string> args = split(spec, ':');
+    const std::string &kind = args[0];
+
+    if ((kind == "poisson5" || kind == "poisson7" || kind == "poisson27") && args.size() == 2)
+    {
+        const int n = atoi(args[1].c_str());
+        const int points = atoi(kind.c_str() + 7);
+        generatePoissonForTest(A, 1, false, points, n, n, points == 5 ? 1 : n);
+    }
+    else if (kind == "aniso" && args.size() == 3)
+    {
+        generate_anisotropic(A, atoi(args[1].c_str()), atof(args[2].c_str()));
+    }
+    else if (kind == "randblock" && args.size() == 3)
+    {
+        generate_random_block(A, atoi(args[1].c_str()), atoi(args[2].c_str()));
+    }
+    else if (kind == "gen" && (args.size() == 3 || args.size() == 4))
+    {
+        std::vector<std::string> dims = split(args[2], 'x');
+        const int64_t nx = atoll(dims[0].c_str());
+        const int64_t ny = dims.size() > 1 ? atoll(dims[1].c_str()) : 1;
+        const int64_t nz = dims.size() > 2 ? atoll(dims[2].c_str()) : 1;
+        generateProblem(parseProblem(args[1], nx, ny, nz, args.size() == 4 ? args[3] : ""), A);
+    }
+    else if (MatrixIO<TConfig_h>::readSystem(spec.c_str(), A) != AMGX_OK)
+    {
+        FatalError("Cannot generate or read matrix " + spec, AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    A.computeDiagonal();
+}
+
+// bytes moved by one SpMV: the matrix once, x once and y once
+template <class TConfig>
+double spmv_bytes(const Matrix<TConfig> &A)
+{
+    const double vec = (double)A.get_num_rows() * A.get_block_dimy() * sizeof(typename TConfig::VecPrec);
+    return (double)A.values.size() * sizeof(typename TConfig::MatPrec) +
+           (double)A.col_indices.size() * sizeof(typename TConfig::IndPrec) +
+           (double)A.row_offsets.size() * sizeof(typename TConfig::IndPrec) + 2. * vec;
+}
+
+// multiply-adds of A * A, counted on the host pattern
+template <class TConfig_h>
+double spgemm_flops(const Matrix<TConfig_h> &A)
+{
+    double products = 0.;
+
+    for (int i = 0; i < A.get_num_rows(); i++)
+    {
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const int k = A.col_indices[jj];
+            products += A.row_offsets[k + 1] - A.row_offsets[k];
+        }
+    }
+
+    return 2. * products;
+}
+
+template <AMGX_VecPrecision V, AMGX_MatPrecision M, AMGX_IndPrecision I>
+void spgemm(const Matrix<TemplateConfig<AMGX_host, V, M, I> > &A, Matrix<TemplateConfig<AMGX_host, V, M, I> > &C)
+{
+    multiplyMM(A, A, C);
+}
+
+template <AMGX_VecPrecision V, AMGX_MatPrecision M, AMGX_IndPrecision I>
+void spgemm(const Matrix<TemplateConfig<AMGX_device, V, M, I> > &A, Matrix<TemplateConfig<AMGX_device, V, M, I> > &C)
+{
+    CSR_Multiply<TemplateConfig<AMGX_device, V, M, I> >::csr_multiply(A, A, C, NULL);
+}
+
+// runs f and records it as unsupported if the library rejects the configuration
+template <class F>
+KernelResult run_kernel(const std::string &name, double bytes, double flops, F f)
+{
+    KernelResult r;
+    r.name = name;
+    r.bytes = bytes;
+    r.flops = flops;
+    r.seconds = 0.;
+    r.supported = true;
+
+    try
+    {
+        r.seconds = f();
+    }
+    catch (amgx_exception &e)
+    {
+        r.supported = false;
+    }
+
+    return r;
+}
+
+template <class TConfig>
+MatrixResult run_matrix(const Options &opt, const std::string &spec)
+{
+    typedef typename TConfig::template setMemSpace<AMGX_host>::Type TConfig_h;
+    typedef typename TConfig::VecPrec ValueTypeB;
+    Matrix<TConfig_h> A_h;
+    build_matrix(spec, A_h);
+    Matrix<TConfig> A = A_h;
+    A.set_initialized(1);
+    const int bsize = A.get_block_dimy();
+    const int n = A.get_num_rows() * bsize;
+    Vector<TConfig> x(n, 1.), y(n, 0.), b(n, 1.);
+    x.set_block_dimx(1);
+    x.set_block_dimy(bsize);
+    y.set_block_dimx(1);
+    y.set_block_dimy(bsize);
+    b.set_block_dimx(1);
+    b.set_block_dimy(bsize);
+    MatrixResult res;
+    res.name = spec;
+    res.rows = A.get_num_rows();
+    res.nnz = A.get_num_nz();
+    res.block_size = bsize;
+    const double vec_bytes = (double)n * sizeof(ValueTypeB);
+    const double nnz_flops = 2. * A.values.size();
+
+    if (opt.spmv)
+    {
+        res.kernels.push_back(run_kernel("spmv", spmv_bytes(A), nnz_flops, [&]()
+        {
+            return time_kernel(opt.repeat, [&]() { multiply(A, x, y); });
+        }));
+    }
+
+    if (opt.blas)
+    {
+        res.kernels.push_back(run_kernel("axpy", 3. * vec_bytes, 2. * n, [&]()
+        {
+            return time_kernel(opt.repeat, [&]() { axpy(x, y, ValueTypeB(1e-3)); });
+        }));
+        res.kernels.push_back(run_kernel("dot", 2. * vec_bytes, 2. * n, [&]()
+        {
+            return time_kernel(opt.repeat, [&]() { dotc(x, y); });
+        }));
+        res.kernels.push_back(run_kernel("nrm2", vec_bytes, 2. * n, [&]()
+        {
+            return time_kernel(opt.repeat, [&]() { nrm2(x); });
+        }));
+    }
+
+    if (opt.smoother)
+    {
+        for (size_t s = 0; s < opt.smoothers.size(); s++)
+        {
+            // the byte model of a sweep is the SpMV, smoothers that need more traffic show below it
+            res.kernels.push_back(run_kernel("sweep:" + opt.smoothers[s], spmv_bytes(A), nnz_flops, [&]()
+            {
+                AMG_Config cfg;
+                cfg.parseParameterString(("smoother=" + opt.smoothers[s] + ", max_iters=1, coloring_level=1, matrix_coloring_scheme=MIN_MAX").c_str());
+                Solver<TConfig> *smoother = SolverFactory<TConfig>::allocate(cfg, "default", "smoother");
+                smoother->setup(A, false);
+                smoother->set_max_iters(1);
+                Vector<TConfig> xs(n, 0.);
+                xs.set_block_dimx(1);
+                xs.set_block_dimy(bsize);
+                double t = time_kernel(opt.repeat, [&]() { smoother->solve(b, xs, false); });
+                delete smoother;
+                return t;
+            }));
+        }
+    }
+
+    if (opt.spgemm)
+    {
+        res.kernels.push_back(run_kernel("spgemm", 0., spgemm_flops(A_h), [&]()
+        {
+            return time_kernel(std::max(1, opt.repeat / 4), [&]()
+            {
+                Matrix<TConfig> C;
+                spgemm(A, C);
+            });
+        }));
+    }
+
+    // One V-cycle of an aggregation hierarchy smoothed by JACOBI_L1, with the residual restriction and
+    // the coarse-grid correction done as separate passes and fused (fused_cycle_kernels).
+    if (opt.cycle)
+    {
+        for (int fused = 0; fused < 2; fused++)
+        {
+            res.kernels.push_back(run_kernel(fused ? "cycle:fused" : "cycle", 0., 0., [&]()
+            {
+                std::stringstream cfg_string;
+                cfg_string << "config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother(sm)=JACOBI_L1, sm:max_iters=1, amg:max_iters=1, amg:max_levels=" << opt.max_levels << ", amg:fused_cycle_kernels=" << fused;
+                AMG_Configuration cfg;
+                cfg.parseParameterString(cfg_string.str().c_str());
+                Resources resources;
+                AMG_Solver<TConfig> solver(&resources, cfg);
+
+                if (solver.setup(A) != AMGX_OK) { FatalError("AMG setup failed", AMGX_ERR_NOT_IMPLEMENTED); }
+
+                Vector<TConfig> xs(n, 0.);
+                xs.set_block_dimx(1);
+                xs.set_block_dimy(bsize);
+                AMGX_STATUS status;
+                return time_kernel(opt.repeat, [&]() { solver.solve(b, xs, status, false); });
+            }));
+        }
+    }
+
+    // Setup cost of level l is the difference between the hierarchies with l + 1 and l levels.
+    // The coarse solver is disabled so the coarsest level does not add a factorization.
+    if (opt.setup)
+    {
+        try
+        {
+            Resources resources;
+            double previous = 0.;
+
+            for (int k = 1; k <= opt.max_levels; k++)
+            {
+                std::stringstream cfg_string;
+                cfg_string << "config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:coarse_solver=NOSOLVER, amg:max_iters=1, amg:min_coarse_rows=1, amg:max_levels=" << k;
+                AMG_Configuration cfg;
+                cfg.parseParameterString(cfg_string.str().c_str());
+                double best = 0.;
+                std::vector<std::vector<int> > structure;
+
+                for (int r = 0; r < std::max(1, opt.repeat / 4); r++)
+                {
+                    AMG_Solver<TConfig> solver(&resources, cfg);
+                    cudaDeviceSynchronize();
+                    const double start = now();
+
+                    if (solver.setup(A) != AMGX_OK) { FatalError("AMG setup failed", AMGX_ERR_NOT_IMPLEMENTED); }
+
+                    cudaDeviceSynchronize();
+                    const double t = now() - start;
+                    best = (r == 0 || t < best) ? t : best;
+                    structure.clear();
+                    solver.getSolverObject()->exportCoarseStructure(structure);
+                }
+
+                // the hierarchy stopped growing
+                if ((int)structure.size() < k - 1) { break; }
+
+                if (k > 1)
+                {
+                    LevelResult level;
+                    level.level = k - 1;
+                    level.rows = structure[k - 2][1];
+                    level.seconds = best - previous;
+                    res.levels.push_back(level);
+                }
+
+                previous = best;
+            }
+        }
+        catch (amgx_exception &e)
+        {
+            res.levels.clear();
+        }
+    }
+
+    return res;
+}
+
+void print_results(const ModeResult &run)
+{
+    const std::vector<MatrixResult> &results = run.matrices;
+    const double stream = run.stream;
+    printf("mode %s, STREAM triad %.1f GB/s\n", run.mode.c_str(), stream * 1e-9);
+
+    for (size_t m = 0; m < results.size(); m++)
+    {
+        const MatrixResult &res = results[m];
+        printf("\n%s: %d rows, %d nonzero blocks, block size %d\n", res.name.c_str(), res.rows, res.nnz, res.block_size);
+        printf("%-24s %12s %10s %10s %10s\n", "kernel", "time (ms)", "GB/s", "% STREAM", "GFLOP/s");
+
+        for (size_t k = 0; k < res.kernels.size(); k++)
+        {
+            const KernelResult &r = res.kernels[k];
+
+            if (!r.supported)
+            {
+                printf("%-24s %12s\n", r.name.c_str(), "unsupported");
+                continue;
+            }
+
+            const double gbs = r.bytes / r.seconds * 1e-9;
+            printf("%-24s %12.4f %10.2f %10.1f %10.2f\n", r.name.c_str(), r.seconds * 1e3,
+                   gbs, r.bytes > 0 ? 100. * r.bytes / r.seconds / stream : 0., r.flops / r.seconds * 1e-9);
+        }
+
+        for (size_t l = 0; l < res.levels.size(); l++)
+        {
+            printf("setup level %-12d %12.4f %10s rows %d\n", res.levels[l].level, res.levels[l].seconds * 1e3, "", res.levels[l].rows);
+        }
+    }
+}
+
+void write_run(rapidjson::PrettyWriter<rapidjson::FileStream> &writer, const ModeResult &run)
+{
+    const std::vector<MatrixResult> &results = run.matrices;
+    const double stream = run.stream;
+    writer.StartObject();
+    writer.String("mode");
+    writer.String(run.mode.c_str());
+    writer.String("stream_triad_gbs");
+    writer.Double(stream * 1e-9);
+    writer.String("matrices");
+    writer.StartArray();
+
+    for (size_t m = 0; m < results.size(); m++)
+    {
+        const MatrixResult &res = results[m];
+        writer.StartObject();
+        writer.String("name");
+        writer.String(res.name.c_str());
+        writer.String("rows");
+        writer.Int(res.rows);
+        writer.String("nnz");
+        writer.Int(res.nnz);
+        writer.String("block_size");
+        writer.Int(res.block_size);
+        writer.String("kernels");
+        writer.StartArray();
+
+        for (size_t k = 0; k < res.kernels.size(); k++)
+        {
+            const KernelResult &r = res.kernels[k];
+            writer.StartObject();
+            writer.String("name");
+            writer.String(r.name.c_str());
+            writer.String("supported");
+            writer.Bool(r.supported);
+
+            if (r.supported)
+            {
+                writer.String("time_ms");
+                writer.Double(r.seconds * 1e3);
+                writer.String("gbs");
+                writer.Double(r.bytes / r.seconds * 1e-9);
+                writer.String("stream_fraction");
+                writer.Double(r.bytes / r.seconds / stream);
+                writer.String("gflops");
+                writer.Double(r.flops / r.seconds * 1e-9);
+            }
+
+            writer.EndObject();
+        }
+
+        writer.EndArray();
+        writer.String("setup_levels");
+        writer.StartArray();
+
+        for (size_t l = 0; l < res.levels.size(); l++)
+        {
+            writer.StartObject();
+            writer.String("level");
+            writer.Int(res.levels[l].level);
+            writer.String("rows");
+            writer.Int(res.levels[l].rows);
+            writer.String("time_ms");
+            writer.Double(res.levels[l].seconds * 1e3);
+            writer.EndObject();
+        }
+
+        writer.EndArray();
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+}
+
+// {"runs": [one object per mode]}
+void write_json(const std::string &fname, const std::vector<ModeResult> &runs)
+{
+    FILE *f = fopen(fname.c_str(), "w");
+
+    if (f == NULL)
+    {
+        FatalError("Cannot open " + fname, AMGX_ERR_IO);
+    }
+
+    rapidjson::FileStream fs(f);
+    rapidjson::PrettyWriter<rapidjson::FileStream> writer(fs);
+    writer.StartObject();
+    writer.String("runs");
+    writer.StartArray();
+
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        write_run(writer, runs[r]);
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    fprintf(f, "\n");
+    fclose(f);
+}
+
+template <class TConfig>
+ModeResult run(const Options &opt, const std::string &mode)
+{
+    ModeResult res;
+    res.mode = mode;
+    res.stream = stream_bandwidth<TConfig>(opt.repeat);
+
+    for (size_t m = 0; m < opt.matrices.size(); m++)
+    {
+        res.matrices.push_back(run_matrix<TConfig>(opt, opt.matrices[m]));
+    }
+
+    print_results(res);
+    return res;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv)
+{
+    Options opt;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+
+        if (i + 1 >= argc) { usage(); }
+
+        if (arg == "--mode") { opt.modes = split(argv[++i], ','); }
+        else if (arg == "--matrix") { opt.matrices.push_back(argv[++i]); }
+        else if (arg == "--smoothers") { opt.smoothers = split(argv[++i], ','); }
+        else if (arg == "--repeat") { opt.repeat = std::max(1, atoi(argv[++i])); }
+        else if (arg == "--max-levels") { opt.max_levels = std::max(1, atoi(argv[++i])); }
+        else if (arg == "--json") { opt.json_file = argv[++i]; }
+        else if (arg == "--only")
+        {
+            std::string only = std::string(",") + argv[++i] + ",";
+            opt.spmv = only.find(",spmv,") != std::string::npos;
+            opt.blas = only.find(",blas,") != std::string::npos;
+            opt.smoother = only.find(",smoother,") != std::string::npos;
+            opt.spgemm = only.find(",spgemm,") != std::string::npos;
+            opt.setup = only.find(",setup,") != std::string::npos;
+            opt.cycle = only.find(",cycle,") != std::string::npos;
+        }
+        else { usage(); }
+    }
+
+    if (opt.matrices.empty())
+    {
+        opt.matrices.push_back("poisson7:64");
+    }
+
+    amgx::initialize();
+    std::vector<ModeResult> runs;
+
+    try
+    {
+        for (size_t m = 0; m < opt.modes.size(); m++)
+        {
+            const std::string &mode = opt.modes[m];
+            bool found = false;
+#define AMGX_CASE_LINE(CASE) \
+            if (!found && mode == ModeString<CASE>::getName()) { found = true; runs.push_back(run<TemplateMode<CASE>::Type>(opt, mode)); }
+            AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+            if (!found)
+            {
+                printf("unknown mode %s\n", mode.c_str());
+                amgx::finalize();
+                return 1;
+            }
+        }
+
+        if (!opt.json_file.empty())
+        {
+            write_json(opt.json_file, runs);
+        }
+    }
+    catch (amgx_exception &e)
+    {
+        printf("error: %s\n", e.what());
+        amgx::finalize();
+        return 1;
+    }
+
+    amgx::finalize();
+    return 0;
+}
@@ -0,0 +1,455 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+// End-to-end solver benchmark: runs every matrix against every config (optionally combined with
+// every override string of a parameter sweep), repeats setup and solve and records the median
+// times, iterations, grid and operator complexity and memory use. Results can be saved as a
+// baseline and later runs compared against it, slowdowns beyond a threshold make the driver fail.
+
+#include <core.h>
+#include <matrix.h>
+#include <vector.h>
+#include <matrix_io.h>
+#include <amg_config.h>
+#include <amg_solver.h>
+#include <resources.h>
+#include <solvers/solver.h>
+#include <test_utils.h>
+#include <misc.h>
+#include <problem_generator.h>
+
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/filestream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace amgx;
+
+namespace
+{
+
+struct Options
+{
+    std::string mode;
+    std::vector<std::string> matrices;
+    std::vector<std::string> configs;
+    std::vector<std::string> overrides;
+    std::string output_file;
+    std::string baseline_file;
+    double threshold;
+    int repeat;
+
+    Options() : mode("dDDI"), threshold(0.1), repeat(3) {}
+};
+
+struct RunResult
+{
+    std::string matrix, config, override_string;
+    int rows, nnz;
+    bool converged;
+    int iterations;
+    double setup_ms, solve_ms;
+    double grid_complexity, operator_complexity;
+    double device_memory_gb, host_peak_rss_mb;
+};
+
+void usage()
+{
+    printf("amgx_solver_bench [options]\n");
+    printf(" --mode MODE          hDDI, dDDI, hDFI, dDFI, hFFI or dFFI (default dDDI)\n");
+    printf(" --matrix SPEC        may be repeated, poisson5:N, poisson7:N, poisson27:N, a matrix file or\n");
+    printf("                      gen:PROBLEM:NXxNYxNZ[:OPTIONS] for the in-library generators (see AMGX_generate_system)\n");
+    printf(" --config FILE        may be repeated, solver config file (e.g. src/configs/FGMRES_AGGREGATION.json)\n");
+    printf(" --override STRING    may be repeated, parameter string applied on top of every config, each\n");
+    printf("                      override is a separate point of the sweep (default: none)\n");
+    printf(" --repeat N           setups and solves per run, the median is reported (default 3)\n");
+    printf(" --output FILE        write the results to FILE, usable as a baseline\n");
+    printf(" --baseline FILE      compare against a previous output, fail on regressions\n");
+    printf(" --threshold T        relative slowdown flagged as a regression (default 0.1)\n");
+    exit(1);
+}
+
+double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    return v.size() % 2 ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+}
+
+double device_memory_in_use_gb()
+{
+    size_t free_mem = 0, total_mem = 0;
+
+    if (cudaMemGetInfo(&free_mem, &total_mem) != cudaSuccess)
+    {
+        cudaGetLastError();
+        return 0.;
+    }
+
+    return (total_mem - free_mem) / 1024.0 / 1024 / 1024;
+}
+
+double host_peak_rss_mb()
+{
+#ifndef _WIN32
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return usage.ru_maxrss / 1024.0;
+    }
+
+#endif
+    return 0.;
+}
+
+template <class TConfig>
+void load_matrix(const std::string &spec, Matrix<TConfig> &A, Vector<TConfig> &b)
+{
+    typedef typename TConfig::template setMemSpace<AMGX_host>::Type TConfig_h;
+    Matrix<TConfig_h> A_h;
+    Vector<TConfig_h> b_h, x_h;
+    std::vector<std::string> args = split(spec, ':');
+    const std::string &kind = args[0];
+
+    if ((kind == "poisson5" || kind == "poisson7" || kind == "poisson27") && args.size() == 2)
+    {
+        const int n = atoi(args[1].c_str());
+        const int points = atoi(kind.c_str() + 7);
+        generatePoissonForTest(A_h, 1, false, points, n, n, points == 5 ? 1 : n);
+    }
+    else if (kind == "gen" && (args.size() == 3 || args.size() == 4))
+    {
+        std::vector<std::string> dims = split(args[2], 'x');
+        const int64_t nx = atoll(dims[0].c_str());
+        const int64_t ny = dims.size() > 1 ? atoll(dims[1].c_str()) : 1;
+        const int64_t nz = dims.size() > 2 ? atoll(dims[2].c_str()) : 1;
+        generateProblem(parseProblem(args[1], nx, ny, nz, args.size() == 4 ? args[3] : ""), A_h);
+    }
+    else if (MatrixIO<TConfig_h>::readSystem(spec.c_str(), A_h, b_h, x_h) != AMGX_OK)
+    {
+        FatalError("Cannot generate or read matrix " + spec, AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    const int n = A_h.get_num_rows() * A_h.get_block_dimy();
+
+    if ((int)b_h.size() != n)
+    {
+        b_h.resize(n);
+        amgx::thrust::fill(b_h.begin(), b_h.end(), 1.);
+    }
+
+    A = A_h;
+    A.set_initialized(1);
+    b = b_h;
+    b.set_block_dimx(1);
+    b.set_block_dimy(A.get_block_dimy());
+}
+
+template <class TConfig>
+RunResult run_one(const Options &opt, const std::string &matrix, Matrix<TConfig> &A, Vector<TConfig> &b,
+                  const std::string &config, const std::string &override_string)
+{
+    RunResult r;
+    r.matrix = matrix;
+    r.config = config;
+    r.override_string = override_string;
+    r.rows = A.get_num_rows();
+    r.nnz = A.get_num_nz();
+    r.converged = true;
+    r.iterations = 0;
+    r.grid_complexity = r.operator_complexity = 0.;
+    AMG_Configuration cfg;
+
+    const AMGX_ERROR parsed = override_string.empty() ? cfg.parseFile(config.c_str()) :
+                              cfg.parseParameterStringAndFile(override_string.c_str(), config.c_str());
+
+    if (parsed != AMGX_OK)
+    {
+        FatalError("Cannot parse config " + config + " with \"" + override_string + "\"", AMGX_ERR_CONFIGURATION);
+    }
+
+    const int device = 0;
+    Resources resources(&cfg, NULL, 1, &device);
+    std::vector<double> setup_times, solve_times;
+    const double memory_before = device_memory_in_use_gb();
+    double memory_peak = memory_before;
+
+    for (int rep = 0; rep < opt.repeat; rep++)
+    {
+        AMG_Solver<TConfig> solver(&resources, cfg);
+        Vector<TConfig> x(b.size(), 0.);
+        x.set_block_dimx(1);
+        x.set_block_dimy(A.get_block_dimy());
+        cudaDeviceSynchronize();
+        double start = now();
+
+        if (solver.setup(A) != AMGX_OK)
+        {
+            FatalError("Setup failed for " + config + " on " + matrix, AMGX_ERR_UNKNOWN);
+        }
+
+        cudaDeviceSynchronize();
+        setup_times.push_back(now() - start);
+        memory_peak = std::max(memory_peak, device_memory_in_use_gb());
+        AMGX_STATUS status;
+        start = now();
+
+        if (solver.solve(b, x, status, true) != AMGX_OK)
+        {
+            FatalError("Solve failed for " + config + " on " + matrix, AMGX_ERR_UNKNOWN);
+        }
+
+        cudaDeviceSynchronize();
+        solve_times.push_back(now() - start);
+        memory_peak = std::max(memory_peak, device_memory_in_use_gb());
+        r.converged = r.converged && status == AMGX_ST_CONVERGED;
+        r.iterations = solver.get_num_iters();
+        solver.getSolverObject()->getComplexity(r.grid_complexity, r.operator_complexity);
+    }
+
+    r.setup_ms = median(setup_times) * 1e3;
+    r.solve_ms = median(solve_times) * 1e3;
+    r.device_memory_gb = memory_peak - memory_before;
+    r.host_peak_rss_mb = host_peak_rss_mb();
+    return r;
+}
+
+template <class TConfig>
+std::vector<RunResult> run(const Options &opt)
+{
+    std::vector<RunResult> results;
+
+    for (size_t m = 0; m < opt.matrices.size(); m++)
+    {
+        Matrix<TConfig> A;
+        Vector<TConfig> b;
+        load_matrix(opt.matrices[m], A, b);
+
+        for (size_t c = 0; c < opt.configs.size(); c++)
+        {
+            for (size_t o = 0; o < opt.overrides.size(); o++)
+            {
+                results.push_back(run_one(opt, opt.matrices[m], A, b, opt.configs[c], opt.overrides[o]));
+                const RunResult &r = results.back();
+                printf("%-24s %-40s %-24s %s %5d it  setup %10.3f ms  solve %10.3f ms  gc %.3f  oc %.3f  dev %.3f GB  rss %.1f MB\n",
+                       r.matrix.c_str(), r.config.c_str(), r.override_string.c_str(), r.converged ? "  conv" : "NOCONV",
+                       r.iterations, r.setup_ms, r.solve_ms, r.grid_complexity, r.operator_complexity,
+                       r.device_memory_gb, r.host_peak_rss_mb);
+            }
+        }
+    }
+
+    return results;
+}
+
+void write_results(const std::string &fname, const std::string &mode, const std::vector<RunResult> &results)
+{
+    FILE *f = fopen(fname.c_str(), "w");
+
+    if (f == NULL)
+    {
+        FatalError("Cannot open " + fname, AMGX_ERR_IO);
+    }
+
+    rapidjson::FileStream fs(f);
+    rapidjson::PrettyWriter<rapidjson::FileStream> writer(fs);
+    writer.StartObject();
+    writer.String("mode");
+    writer.String(mode.c_str());
+    writer.String("results");
+    writer.StartArray();
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const RunResult &r = results[i];
+        writer.StartObject();
+        writer.String("matrix");
+        writer.String(r.matrix.c_str());
+        writer.String("config");
+        writer.String(r.config.c_str());
+        writer.String("override");
+        writer.String(r.override_string.c_str());
+        writer.String("rows");
+        writer.Int(r.rows);
+        writer.String("nnz");
+        writer.Int(r.nnz);
+        writer.String("converged");
+        writer.Bool(r.converged);
+        writer.String("iterations");
+        writer.Int(r.iterations);
+        writer.String("setup_ms");
+        writer.Double(r.setup_ms);
+        writer.String("solve_ms");
+        writer.Double(r.solve_ms);
+        writer.String("grid_complexity");
+        writer.Double(r.grid_complexity);
+        writer.String("operator_complexity");
+        writer.Double(r.operator_complexity);
+        writer.String("device_memory_gb");
+        writer.Double(r.device_memory_gb);
+        writer.String("host_peak_rss_mb");
+        writer.Double(r.host_peak_rss_mb);
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    fprintf(f, "\n");
+    fclose(f);
+}
+
+// Returns the number of runs that got slower than the baseline by more than the threshold,
+// lost convergence or needed more iterations. Runs missing from the baseline are reported only.
+int compare_with_baseline(const Options &opt, const std::vector<RunResult> &results)
+{
+    std::ifstream fin(opt.baseline_file.c_str());
+
+    if (!fin)
+    {
+        FatalError("Cannot open baseline " + opt.baseline_file, AMGX_ERR_IO);
+    }
+
+    std::stringstream contents;
+    contents << fin.rdbuf();
+    const std::string json = contents.str();
+    rapidjson::Document doc;
+
+    if (doc.Parse<0>(json.c_str()).HasParseError() || !doc.IsObject() || !doc.HasMember("results") || !doc["results"].IsArray())
+    {
+        FatalError("Cannot parse baseline " + opt.baseline_file, AMGX_ERR_IO);
+    }
+
+    const rapidjson::Value &base = doc["results"];
+    int regressions = 0;
+    printf("\ncomparison with %s (threshold %.0f%%)\n", opt.baseline_file.c_str(), opt.threshold * 100);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const RunResult &r = results[i];
+        bool found = false;
+
+        for (rapidjson::SizeType j = 0; j < base.Size() && !found; j++)
+        {
+            const rapidjson::Value &b = base[j];
+
+            if (r.matrix != b["matrix"].GetString() || r.config != b["config"].GetString() || r.override_string != b["override"].GetString())
+            {
+                continue;
+            }
+
+            found = true;
+            const double setup_ratio = r.setup_ms / std::max(b["setup_ms"].GetDouble(), 1e-9);
+            const double solve_ratio = r.solve_ms / std::max(b["solve_ms"].GetDouble(), 1e-9);
+            const bool slower = setup_ratio > 1. + opt.threshold || solve_ratio > 1. + opt.threshold;
+            const bool worse = (b["converged"].GetBool() && !r.converged) || r.iterations > b["iterations"].GetInt();
+            printf("%-8s %-24s %-40s %-24s setup x%.3f  solve x%.3f  iterations %d -> %d\n",
+                   slower || worse ? "REGRESS" : "ok", r.matrix.c_str(), r.config.c_str(), r.override_string.c_str(),
+                   setup_ratio, solve_ratio, b["iterations"].GetInt(), r.iterations);
+            regressions += slower || worse ? 1 : 0;
+        }
+
+        if (!found)
+        {
+            printf("%-8s %-24s %-40s %-24s not in baseline\n", "new", r.matrix.c_str(), r.config.c_str(), r.override_string.c_str());
+        }
+    }
+
+    return regressions;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv)
+{
+    Options opt;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+
+        if (i + 1 >= argc) { usage(); }
+
+        if (arg == "--mode") { opt.mode = argv[++i]; }
+        else if (arg == "--matrix") { opt.matrices.push_back(argv[++i]); }
+        else if (arg == "--config") { opt.configs.push_back(argv[++i]); }
+        else if (arg == "--override") { opt.overrides.push_back(argv[++i]); }
+        else if (arg == "--repeat") { opt.repeat = std::max(1, atoi(argv[++i])); }
+        else if (arg == "--output") { opt.output_file = argv[++i]; }
+        else if (arg == "--baseline") { opt.baseline_file = argv[++i]; }
+        else if (arg == "--threshold") { opt.threshold = atof(argv[++i]); }
+        else { usage(); }
+    }
+
+    if (opt.matrices.empty() || opt.configs.empty())
+    {
+        usage();
+    }
+
+    if (opt.overrides.empty())
+    {
+        opt.overrides.push_back("");
+    }
+
+    amgx::initialize();
+    std::vector<RunResult> results;
+    int regressions = 0;
+    bool found = false;
+
+    try
+    {
+#define AMGX_CASE_LINE(CASE) \
+        if (!found && opt.mode == ModeString<CASE>::getName()) { found = true; results = run<TemplateMode<CASE>::Type>(opt); }
+        AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+        if (!opt.output_file.empty())
+        {
+            write_results(opt.output_file, opt.mode, results);
+        }
+
+        if (!opt.baseline_file.empty())
+        {
+            regressions = compare_with_baseline(opt, results);
+        }
+    }
+    catch (amgx_exception &e)
+    {
+        printf("error: %s\n", e.what());
+        amgx::finalize();
+        return 1;
+    }
+
+    amgx::finalize();
+
+    if (!found)
+    {
+        printf("unknown mode %s\n", opt.mode.c_str());
+        return 1;
+    }
+
+    if (regressions > 0)
+    {
+        printf("%d regression(s)\n", regressions);
+        return 2;
+    }
+
+    return 0;
+}
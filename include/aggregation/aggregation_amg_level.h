@@ -84,6 +84,9 @@ class Aggregation_AMG_Level_Base : public AMG_Level<T_Config>
 
         void createCoarseVertices();
         void createCoarseMatrices();
+        bool exportCoarseStructure(std::vector<int> &structure);
+        bool importCoarseStructure(const std::vector<int> &structure);
+        void computeDiagnostics(LevelDiagnostics &d, bool rate_aggregates);
         bool isClassicalAMGLevel() { return false; }
         IndexType getNumCoarseVertices()
         {
@@ -92,6 +95,8 @@ class Aggregation_AMG_Level_Base : public AMG_Level<T_Config>
 
         void restrictResidual(VVector &r, VVector &rr);
         void prolongateAndApplyCorrection( VVector &c, VVector &bc, VVector &x, VVector &tmp);
+        bool computeAndRestrictResidual(const VVector &b, const VVector &x, VVector &r, VVector &rr);
+        bool prolongateAndSmooth(VVector &c, VVector &b, VVector &x, Solver<TConfig> *smoother);
         void computeRestrictionOperator();
         void consolidateVector(VVector &x);
         void unconsolidateVector(VVector &x);
@@ -157,6 +162,7 @@ class Aggregation_AMG_Level_Base : public AMG_Level<T_Config>
         virtual void prolongateAndApplyCorrection_1x1(VVector &c, VVector &bc, VVector &x, VVector &tmp) = 0;
         virtual void restrictResidual_1x1(const VVector &r, VVector &rr) = 0;
         virtual void restrictResidual_4x4(const VVector &r, VVector &rr) = 0;
+        virtual void computeAndRestrictResidual_1x1(const VVector &b, const VVector &x, VVector &r, VVector &rr) = 0;
         virtual void computeRestrictionOperator_1x1() = 0;
         virtual void computeRestrictionOperator_4x4() = 0 ;
 
@@ -183,6 +189,7 @@ class Aggregation_AMG_Level< TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_i
         virtual void prolongateAndApplyCorrection_1x1(VVector &c, VVector &bc, VVector &x, VVector &tmp);
         virtual void restrictResidual_1x1(const VVector &r, VVector &rr);
         virtual void restrictResidual_4x4(const VVector &r, VVector &rr);
+        virtual void computeAndRestrictResidual_1x1(const VVector &b, const VVector &x, VVector &r, VVector &rr);
         virtual void computeRestrictionOperator_1x1();
         virtual void computeRestrictionOperator_4x4();
 };
@@ -208,6 +215,7 @@ class Aggregation_AMG_Level< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t
         virtual void prolongateAndApplyCorrection_1x1(VVector &c, VVector &bc, VVector &x, VVector &tmp);
         virtual void restrictResidual_1x1(const VVector &r, VVector &rr);
         virtual void restrictResidual_4x4(const VVector &r, VVector &rr);
+        virtual void computeAndRestrictResidual_1x1(const VVector &b, const VVector &x, VVector &r, VVector &rr);
         virtual void computeRestrictionOperator_1x1();
         virtual void computeRestrictionOperator_4x4();
 };
@@ -115,6 +115,7 @@ class AMG
         inline int getNumFinestsweeps() const {return m_cfg->template getParameter<int>("finest_sweeps", m_cfg_scope);}
         inline int getNumPostsweeps() const {return m_cfg->template getParameter<int>("postsweeps", m_cfg_scope);}
         inline bool getIntensiveSmoothing() const {return m_cfg->template getParameter<int>("intensive_smoothing", m_cfg_scope) != 0;}
+        inline bool getFusedCycleKernels() const {return m_cfg->template getParameter<int>("fused_cycle_kernels", m_cfg_scope) != 0;}
         inline int getIters() const {return iterations;}
 
         inline NormType getNormType() const {return norm; }
@@ -141,7 +142,45 @@ class AMG
         inline void setConsolidationLowerThreshold(IndexType consolidation_lower_threshold) { m_consolidation_lower_threshold = consolidation_lower_threshold;}
         inline void setConsolidationUpperThreshold(IndexType consolidation_upper_threshold) { m_consolidation_upper_threshold = consolidation_upper_threshold;}
 
+        // Coarse-grid structure of every level but the coarsest (see AMG_Level::exportCoarseStructure),
+        // empty for levels that do not support it. An imported structure replaces the coarse vertex
+        // selection of the next setup on every level whose matrix size still matches.
+        void exportCoarseStructure(std::vector<std::vector<int> > &structure);
+        inline void importCoarseStructure(const std::vector<std::vector<int> > &structure) { m_imported_structure = structure; }
+        // Grid and operator complexity of the hierarchy, as printed by printGridStatistics.
+        bool getComplexity(double &grid_complexity, double &operator_complexity);
+        // Per-level metrics of the hierarchy from the fine level down (see amg_diagnostics.h).
+        bool getDiagnostics(HierarchyDiagnostics &diagnostics);
+
+        // Seconds per cycle visit of a level on each memory space and for moving its vectors
+        // between them, as measured by amg_host_levels_auto, and where the level was placed.
+        struct LevelPlacement
+        {
+            int level;
+            double device_time;
+            double host_time;
+            double transfer_time;
+            bool on_host;
+        };
+        inline const std::vector<LevelPlacement> &getLevelPlacement() const { return m_level_placement; }
+
+        // Rows, nonzeros (scalar entries, diagonal included), partitions and memory of a level,
+        // summed over the ranks the level is spread across.
+        struct LevelSize
+        {
+            int level;
+            bool on_host;
+            int64_t rows;
+            int64_t nnz;
+            int64_t parts;
+            float memory_gb;
+        };
+
     private:
+        // Sizes of every level from the fine level down, shared by getGridStatisticsString and
+        // getComplexity. The memory of the levels is only measured if with_memory is set.
+        void getLevelSizes(std::vector<LevelSize> &sizes, bool with_memory);
+
 
         AMG_Level<TConfig_d> *fine_d;
         Solver<TConfig_d> *coarse_solver_d;
@@ -166,6 +205,7 @@ class AMG
         int m_sum_stopping_criteria;
         int m_structure_reuse_levels;
         int m_amg_host_levels_rows;
+        int m_amg_host_levels_auto;
 
         int min_fine_rows;
         int min_coarse_rows;
@@ -184,6 +224,9 @@ class AMG
 
         // Pimpl to csr_multiply workspace.
         void *csr_workspace, *d2_workspace;
+
+        std::vector<std::vector<int> > m_imported_structure;
+        std::vector<LevelPlacement> m_level_placement;
 };
 
 } // namespace amgx
@@ -10,6 +10,7 @@
 #include <string.h>  //strtok
 #include <string>
 #include <typeinfo>
+#include <stdint.h>
 #include <error.h>
 #include <amg_signal.h>
 
@@ -108,7 +109,7 @@ class ParameterDescription
 {
     public:
         ParameterDescription() : type(0) {}
-        ParameterDescription(const ParameterDescription &p) : type(p.type), name(p.name), description(p.description), default_value(default_value), allowed_values(p.allowed_values) {}
+        ParameterDescription(const ParameterDescription &p) : type(p.type), name(p.name), description(p.description), default_value(p.default_value), allowed_values(p.allowed_values) {}
         ParameterDescription(const std::type_info *type, const std::string &name, const std::string &description, const Parameter &default_value) : type(type), name(name), description(description), default_value(default_value), allowed_values(ParameterMargins()) {}
         ParameterDescription(const std::type_info *type, const std::string &name, const std::string &description, const Parameter &default_value, const ParameterMargins &parameter_allowed_values) : type(type), name(name), description(description), default_value(default_value), allowed_values(parameter_allowed_values) {}
         const std::type_info *type;   //the type of the parameter
@@ -214,6 +215,12 @@ class AMG_Config
          ***************************************************/
         void printAMGConfig();
 
+        /***************************************************
+         * Hash of the user-defined parameters, equal for  *
+         * two configs that hold the same parameter values *
+         ***************************************************/
+        uint64_t fingerprint();
+
         /***************************************************
          * Convert a parameter value to a string
          * ************************************************/
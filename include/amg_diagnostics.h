@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace amgx
+{
+
+// bins of the aggregate size histogram: bin k counts the aggregates of size k + 1, the last bin
+// all aggregates of AGGREGATE_HISTOGRAM_BINS points or more
+const int AGGREGATE_HISTOGRAM_BINS = 16;
+// largest aggregate whose quality is computed, the dense eigenproblem grows with its cube
+const int MAX_RATED_AGGREGATE = 64;
+
+// Metrics of one level of an AMG hierarchy, computed from the setup data the level keeps.
+// Distributed levels report their owned part.
+struct LevelDiagnostics
+{
+    int level;
+    bool on_host;
+    bool classical;
+    int block_size;
+    int64_t rows;                   // block rows
+    int64_t nnz;                    // block nonzeros, external diagonal included
+    int64_t coarse_rows;            // rows of the next level, 0 on the coarsest level
+    double coarsening_ratio;        // coarse_rows / rows
+    double galerkin_fill_ratio;     // average row length of the next level over the one of this level
+
+    // aggregation levels
+    int64_t num_aggregates;
+    int max_aggregate_size;
+    int64_t singletons;
+    int64_t aggregate_size_histogram[AGGREGATE_HISTOGRAM_BINS];
+    // Largest two-grid quality bound mu(G) = 1 / lambda_2(D_G^-1 A_G) over the aggregates, A_G the
+    // aggregate block of A with zero row sums, D_G its diagonal from A. The two-grid method with
+    // Jacobi smoothing converges faster the closer it is to 1. Aggregates of more than
+    // MAX_RATED_AGGREGATE points are not rated.
+    double aggregate_quality;
+    int64_t unrated_aggregates;
+
+    // classical levels
+    int64_t num_coarse_points;
+    int64_t num_fine_points;
+    double cf_ratio;
+
+    // interpolation, aggregation levels have one entry per row
+    int interp_min_row_length;
+    int interp_max_row_length;
+    double interp_avg_row_length;
+
+    LevelDiagnostics()
+        : level(0), on_host(false), classical(false), block_size(1), rows(0), nnz(0), coarse_rows(0), coarsening_ratio(0.),
+          galerkin_fill_ratio(0.), num_aggregates(0), max_aggregate_size(0), singletons(0), aggregate_quality(0.),
+          unrated_aggregates(0), num_coarse_points(0), num_fine_points(0), cf_ratio(0.), interp_min_row_length(0),
+          interp_max_row_length(0), interp_avg_row_length(0.)
+    {
+        for (int k = 0; k < AGGREGATE_HISTOGRAM_BINS; k++)
+        {
+            aggregate_size_histogram[k] = 0;
+        }
+    }
+};
+
+struct HierarchyDiagnostics
+{
+    // input: compute aggregate_quality, which copies every aggregation level matrix to the host
+    bool rate_aggregates;
+
+    std::vector<LevelDiagnostics> levels;
+    double grid_complexity;
+    double operator_complexity;
+
+    HierarchyDiagnostics() : rate_aggregates(true), grid_complexity(0.), operator_complexity(0.) {}
+};
+
+} // namespace amgx
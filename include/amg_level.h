@@ -16,6 +16,7 @@ template <class T_Config> class AMG_Level;
 #include <vector>
 #include <cassert>
 #include <thread_manager.h>
+#include <amg_diagnostics.h>
 
 namespace amgx
 {
@@ -93,6 +94,23 @@ class AMG_Level
 
         virtual void transfer_level(AMG_Level<TConfig1> *ref_lvl) = 0;
 
+        // Flat, memory-space independent copy of the coarse-grid structure built by createCoarseVertices
+        // (e.g. the aggregates). Importing a structure exported from a level with the same matrix replaces
+        // createCoarseVertices. Levels that do not support it return false.
+        virtual bool exportCoarseStructure(std::vector<int> &structure) { return false; }
+        virtual bool importCoarseStructure(const std::vector<int> &structure) { return false; }
+
+        // Adds the metrics of the coarse-grid construction of this level (aggregates, C/F splitting,
+        // interpolation) to d. Sizes and ratios are filled by AMG::getDiagnostics. rate_aggregates
+        // asks for the aggregate quality bound, which costs a host copy of the level matrix.
+        virtual void computeDiagnostics(LevelDiagnostics &d, bool rate_aggregates) {}
+
+        // Fused transfer kernels used by the cycle with fused_cycle_kernels=1. computeAndRestrictResidual
+        // writes r = b - A*x and rr = R*r in one pass, prolongateAndSmooth applies the correction c and
+        // one sweep of the smoother at once. Levels that cannot fuse them return false and do nothing.
+        virtual bool computeAndRestrictResidual(const VVector &b, const VVector &x, VVector &r, VVector &rr) { return false; }
+        virtual bool prolongateAndSmooth(VVector &c, VVector &b, VVector &x, Solver<TConfig> *smoother) { return false; }
+
         void transfer_from(AMG_Level<TConfig1> *ref_lvl); // copy from other memoryspace
         void setup();
         void setup_smoother();
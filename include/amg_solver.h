@@ -21,6 +21,7 @@
 
 #include <vector.h>
 #include <matrix.h>
+#include <operators/matrix_free_operator.h>
 #include <basic_types.h>
 #include <types.h>
 #include <misc.h>
@@ -91,6 +92,12 @@ class AMG_Solver
         AMGX_ERROR setup_capi( std::shared_ptr<Matrix<T_Config>> pA0);
         AMGX_ERROR resetup_capi( std::shared_ptr<Matrix<T_Config>> pA0);
 
+        /****************************************************
+        * Sets a matrix-free operator for the system, the
+        * preconditioner is built from the surrogate matrix
+        ****************************************************/
+        AMGX_ERROR setup_matrix_free( std::shared_ptr<Matrix<T_Config>> pSurrogate, typename MatrixFreeOperator<T_Config>::ApplyCallback apply, void *user_data );
+
         /****************************************************
         * Solves the AMG system Ax=b.
         ***************************************************/
@@ -134,6 +141,7 @@ class AMG_Solver
         }
 
         std::shared_ptr<Matrix<T_Config>> m_ptrA;
+        std::shared_ptr<MatrixFreeOperator<T_Config>> m_ptrOp;
 
         void mem_manage(Matrix<T_Config> &A)
         {
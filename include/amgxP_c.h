@@ -61,6 +61,11 @@ AMGX_RC AMGX_API AMGX_set_device
 AMGX_RC AMGX_API AMGX_matrix_sort
 (AMGX_matrix_handle obj);
 
+// distributed uploads that kept the maps of the previous one and only replaced the values
+AMGX_RC AMGX_API AMGX_matrix_get_value_only_uploads
+(AMGX_matrix_handle obj,
+ int *count);
+
 AMGX_RC AMGX_API AMGX_read_geometry
 (const char *fname,
  double **geo_x,
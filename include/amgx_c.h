@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "amgx_config.h"
 
 #if defined(__cplusplus)
@@ -104,6 +105,10 @@ typedef enum
  *********************************************************/
 typedef void (*AMGX_print_callback)(const char *msg, int length);
 
+/* y = A x for a matrix-free operator. x and y are in the memory space and
+ * vector precision of the solver mode. */
+typedef void (*AMGX_matrix_free_apply_callback)(const void *x, void *y, void *user_data);
+
 typedef struct {char AMGX_config_handle_dummy;} AMGX_config_handle_struct;
 typedef AMGX_config_handle_struct *AMGX_config_handle;
 
@@ -383,6 +388,22 @@ AMGX_RC AMGX_API AMGX_solver_setup
 (AMGX_solver_handle slv,
  AMGX_matrix_handle mtx);
 
+/** Sets up the solver on a matrix-free operator of n rows of block_dim
+ * entries, applied through apply. The operator is used by the outer Krylov
+ * solver, while its preconditioner is built from the assembled surrogate mtx
+ * (e.g. a low-order discretization of the same problem). When mtx is NULL the
+ * preconditioner is built from the n diagonal blocks in diag_data (host or
+ * device memory), which is ignored otherwise. Single GPU only; the outer
+ * solver cannot be AMG. */
+AMGX_RC AMGX_API AMGX_solver_setup_matrix_free
+(AMGX_solver_handle slv,
+ int n,
+ int block_dim,
+ AMGX_matrix_free_apply_callback apply,
+ void *user_data,
+ const void *diag_data,
+ AMGX_matrix_handle mtx);
+
 AMGX_RC AMGX_API AMGX_solver_solve
 (AMGX_solver_handle slv,
  AMGX_vector_handle rhs,
@@ -407,6 +428,94 @@ AMGX_RC AMGX_API AMGX_solver_get_status
 (AMGX_solver_handle slv,
  AMGX_SOLVE_STATUS *st);
 
+/** Writes the aggregates of every level of the AMG hierarchy built by the last
+ * AMGX_solver_setup to a versioned binary file. This is not a checkpoint of the
+ * hierarchy: the coarse matrices, the prolongation and restriction operators and
+ * the smoothers are not saved. The solver must be AMG with the aggregation
+ * algorithm, or use it as its preconditioner, and the matrix must not be
+ * distributed. */
+AMGX_RC AMGX_API AMGX_solver_save_aggregates
+(AMGX_solver_handle slv,
+ const char *filename);
+
+/** Reads a file written by AMGX_solver_save_aggregates. Loading only skips
+ * aggregate selection: the following AMGX_solver_setup takes the aggregates of
+ * every level from the file instead of running the selector, and still builds
+ * the coarse matrices, the transfer operators and the smoothers from the current
+ * matrix. A level whose size does not match the file, or whose stored aggregate
+ * indices are out of range, is coarsened again. */
+AMGX_RC AMGX_API AMGX_solver_load_aggregates
+(AMGX_solver_handle slv,
+ const char *filename);
+
+/** Memory accounted to each subsystem (matrix, transfer, smoother, solver,
+ * comms, coloring, other) and hierarchy level while memory_accounting=1. Only
+ * the setups and solves of solvers on the resources of slv are counted, and
+ * only device memory and pinned host memory (space "device" or "pinned");
+ * pageable host memory, e.g. the levels of a host-mode hierarchy, is not
+ * accounted. One line "space,subsystem,level,current_bytes,
+ * peak_bytes" is written per entry, level is -1 outside the hierarchy. On
+ * input *size is the capacity of report, on output the length needed
+ * including the terminating zero; pass report=NULL to query it. */
+AMGX_RC AMGX_API AMGX_solver_get_memory_report
+(AMGX_solver_handle slv,
+ char *report,
+ size_t *size);
+
+/* number of bins of AMGX_level_diagnostics::aggregate_size_histogram */
+#define AMGX_AGGREGATE_HISTOGRAM_BINS 16
+
+/** Metrics of one level of the AMG hierarchy, sizes count block rows and
+ * block nonzeros of the local partition. aggregate_size_histogram[k] counts
+ * the aggregates of k + 1 points, the last bin those of
+ * AMGX_AGGREGATE_HISTOGRAM_BINS or more. aggregate_quality is the largest
+ * two-grid bound 1 / lambda_2(D^-1 A) over the aggregates (1 is ideal),
+ * aggregates of more than 64 points are not rated. The aggregate fields are 0
+ * on classical levels, the C/F fields on aggregation levels, and the
+ * coarsening fields on the coarsest level. */
+typedef struct
+{
+    int level;
+    int on_host;
+    int classical;
+    int block_size;
+    int64_t rows;
+    int64_t nnz;
+    int64_t coarse_rows;
+    double coarsening_ratio;
+    double galerkin_fill_ratio;
+    int64_t num_aggregates;
+    int max_aggregate_size;
+    int64_t singletons;
+    int64_t aggregate_size_histogram[AMGX_AGGREGATE_HISTOGRAM_BINS];
+    double aggregate_quality;
+    int64_t unrated_aggregates;
+    int64_t num_coarse_points;
+    int64_t num_fine_points;
+    double cf_ratio;
+    int interp_min_row_length;
+    int interp_max_row_length;
+    double interp_avg_row_length;
+} AMGX_level_diagnostics;
+
+/** Per-level diagnostics of the AMG hierarchy built by the last
+ * AMGX_solver_setup, computed from the setup data without solving. levels
+ * receives at most max_levels entries (may be NULL with max_levels 0),
+ * *num_levels is set to the number of levels of the hierarchy. The solver must
+ * be AMG or use AMG as its preconditioner. The level metrics are recomputed on
+ * every call. aggregate_quality and unrated_aggregates are only computed with
+ * rate_aggregates != 0 and are 0 otherwise: rating copies the matrix of every
+ * aggregation level to the host and solves one dense eigenproblem per
+ * aggregate, which can cost about as much as a setup. */
+AMGX_RC AMGX_API AMGX_solver_get_diagnostics
+(AMGX_solver_handle slv,
+ int max_levels,
+ AMGX_level_diagnostics *levels,
+ int rate_aggregates,
+ int *num_levels,
+ double *grid_complexity,
+ double *operator_complexity);
+
 AMGX_RC AMGX_API AMGX_solver_calculate_residual_norm
 (AMGX_solver_handle solver,
  AMGX_matrix_handle mtx,
@@ -585,6 +694,83 @@ AMGX_RC AMGX_API AMGX_matrix_upload_all_global_32
  const void *diag_data,
  AMGX_distribution_handle distribution);
 
+/** Uploads a scalar matrix from (row, col, value) triplets in any order.
+ * Duplicate entries are summed. The assembly permutation is kept, so
+ * AMGX_matrix_replace_coefficients() takes `nnz` values in the same triplet order and
+ * diag_data NULL, until the matrix is filled again by any other upload, read or generator. */
+AMGX_RC AMGX_API AMGX_matrix_upload_coo
+(AMGX_matrix_handle mtx,
+ int n,
+ int nnz,
+ int block_dimx,
+ int block_dimy,
+ const int *row_indices,
+ const int *col_indices,
+ const void *data);
+
+/** Same as AMGX_matrix_upload_coo() for CSR input whose columns are unsorted within a row
+ * or contain duplicates. */
+AMGX_RC AMGX_API AMGX_matrix_upload_all_unsorted
+(AMGX_matrix_handle mtx,
+ int n,
+ int nnz,
+ int block_dimx,
+ int block_dimy,
+ const int *row_ptrs,
+ const int *col_indices,
+ const void *data);
+
+/** Host modes only. Uploads CSR arrays to a single-rank matrix with a single copy:
+ * the arrays are copied once straight into the matrix storage (no intermediate fill,
+ * one diagonal computation). The matrix owns its copy, the arrays are not referenced
+ * after the call returns. Returns AMGX_RC_NOT_SUPPORTED_TARGET for device modes and
+ * distributed matrices. */
+AMGX_RC AMGX_API AMGX_matrix_upload_all_host
+(AMGX_matrix_handle mtx,
+ int n,
+ int nnz,
+ int block_dimx,
+ int block_dimy,
+ const int *row_ptrs,
+ const int *col_indices,
+ const void *data,
+ const void *diag_data);
+
+/** Multilevel k-way partitioning of the adjacency graph of a square CSR matrix given in
+ * host memory (heavy-edge matching, greedy growing, greedy boundary refinement).
+ * Writes the part of each row into partition_vector, which can be passed to
+ * AMGX_read_system_distributed or AMGX_matrix_upload_all_global. The result is
+ * deterministic, so all ranks calling it on the same graph obtain the same partition.
+ * edge_cut may be NULL. */
+AMGX_RC AMGX_API AMGX_partition_graph
+(int n,
+ int nnz,
+ const int *row_ptrs,
+ const int *col_indices,
+ int num_parts,
+ int *partition_vector,
+ int64_t *edge_cut);
+
+/** Generates a test problem on an nx x ny x nz grid directly in the library, without files.
+ * problem is one of poisson5, poisson7, poisson9, poisson27, aniso, rotated_aniso, jump,
+ * convdiff, elasticity (2x2 blocks for nz == 1, 3x3 otherwise) or random_spd, options is a
+ * comma separated list of key=value pairs (eps, theta, contrast, jump_blocks, vx, vy, vz, E, nu,
+ * degree, shift, seed) and may be NULL. Rows are built in parallel on the host. On a matrix
+ * created with an MPI communicator every rank generates its own contiguous slab of rows, so
+ * nothing is gathered on one rank. rhs is set to ones and sol to zeros, both may be NULL.
+ * The global number of grid points nx * ny * nz is limited to INT_MAX, like every matrix
+ * upload, and each rank to INT_MAX nonzeros; larger problems return
+ * AMGX_RC_BAD_PARAMETERS. */
+AMGX_RC AMGX_API AMGX_generate_system
+(AMGX_matrix_handle mtx,
+ AMGX_vector_handle rhs,
+ AMGX_vector_handle sol,
+ const char *problem,
+ int nx,
+ int ny,
+ int nz,
+ const char *options);
+
 AMGX_RC AMGX_API AMGX_matrix_check_symmetry
 (AMGX_matrix_handle mtx,
  int* structurally_symmetric,
@@ -12,6 +12,29 @@
 namespace amgx
 {
 
+class Resources;
+
+// Switches dotc, dot, nrm1 and nrm2 to a fixed-order blocked summation whose result only depends on
+// the data and the length of the vector, not on the device or on the number of host threads. The
+// flag belongs to the calling thread: it is the reproducible_reductions of the resources set by the
+// innermost ReproducibleReductionsScope, off outside of any scope.
+void setReproducibleReductions(bool enable);
+bool getReproducibleReductions();
+
+// Makes the calling thread use the reproducible_reductions of res until the end of the scope, so that
+// solvers on different resources do not change each other's summation. A NULL res keeps the current one.
+class ReproducibleReductionsScope
+{
+    public:
+        explicit ReproducibleReductionsScope(const Resources *res);
+        ~ReproducibleReductionsScope();
+
+    private:
+        ReproducibleReductionsScope(const ReproducibleReductionsScope &);
+        ReproducibleReductionsScope &operator=(const ReproducibleReductionsScope &);
+        bool m_previous;
+};
+
 //computes out=a*x+b*y+c*z
 template<class Vector, class Scalar>
 void axpbypcz(const Vector &x, const Vector &y, const Vector &z, Vector &out, Scalar a, Scalar b, Scalar c, int offset = 0, int size = -1);
@@ -84,4 +107,10 @@ template <class Vector>
 typename types::PODTypes<typename Vector::value_type>::type
 nrmmax(const Vector &x, int offset = 0, int size = -1);
 
+// Enqueues nrm1(x), or nrm2(x)^2 if squared, on the current stream and copies it to host_out without
+// waiting for it. For device vectors host_out has to be pinned memory that stays valid until the
+// stream has passed the copy. The sum is computed in the reproducible order.
+template <class Vector>
+void nrm_async(const Vector &x, bool squared, typename types::PODTypes<typename Vector::value_type>::type *host_out, int offset = 0, int size = -1);
+
 } // namespace amgx
@@ -73,6 +73,7 @@ class Classical_AMG_Level_Base : public AMG_Level<T_Config>
         }
 
         bool isClassicalAMGLevel() { return true; }
+        void computeDiagnostics(LevelDiagnostics &d, bool rate_aggregates);
         void restrictResidual(VVector &r, VVector &rr);
         void prolongateAndApplyCorrection( VVector &c, VVector &bc, VVector &x, VVector &tmp);
 
@@ -42,6 +42,11 @@ class CR_SelectorBase : public Selector<T_Config>
     protected:
         virtual void markCoarseFinePoints_1x1(Matrix<T_Config> &A,
                                               IVector &cf_map) = 0;
+
+        // CR on square block systems and separate diagonals, in either memory space: block
+        // Jacobi F-relaxation sweeps and independent sets of the slowest converging points
+        void markCoarseFinePoints_BxB(Matrix<T_Config> &A,
+                                      IVector &cf_map);
 };
 
 
@@ -66,7 +71,7 @@ class CR_Selector< TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
         void markCoarseFinePoints_1x1(Matrix_h &A,
                                       IVector &cf_map)
         {
-            FatalError("CR selector is not implemented on host", AMGX_ERR_NOT_IMPLEMENTED);
+            this->markCoarseFinePoints_BxB(A, cf_map);
         }
 };
 
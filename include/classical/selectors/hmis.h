@@ -39,8 +39,15 @@ class HMIS_SelectorBase : public Selector<T_Config>
                                   int cf_map_init = 0);
 
         HMIS_SelectorBase(AMG_Config &cfg, const std::string &cfg_scope) : 
-          Selector<T_Config>(cfg, cfg_scope) {}
+          Selector<T_Config>(cfg, cfg_scope)
+        {
+            m_rs_num_domains = cfg.getParameter<int>("rs_num_domains", cfg_scope);
+            m_rs_tie_break = cfg.getParameter<int>("rs_tie_break", cfg_scope);
+        }
     protected:
+        int m_rs_num_domains;
+        int m_rs_tie_break;
+
         virtual void markCoarseFinePoints_1x1(Matrix<T_Config> &A,
                                               FVector &weights,
                                               const BVector &s_con,
@@ -39,9 +39,18 @@ class RS_SelectorBase : public Selector<T_Config>
                                   int cf_map_init = 0);
 
         RS_SelectorBase(AMG_Config &cfg, const std::string &cfg_scope) : 
-          Selector<T_Config>(cfg, cfg_scope) {}
+          Selector<T_Config>(cfg, cfg_scope)
+        {
+            m_num_domains = cfg.getParameter<int>("rs_num_domains", cfg_scope);
+            m_tie_break = cfg.getParameter<int>("rs_tie_break", cfg_scope);
+        }
 
     protected:
+        // number of contiguous row blocks the first pass is split into (0: one per host thread)
+        int m_num_domains;
+        // among equal measures 0 picks the smallest index, 1 the point queued last
+        int m_tie_break;
+
         virtual void markCoarseFinePoints_1x1(Matrix<T_Config> &A,
                                               FVector &weights,
                                               const BVector &s_con,
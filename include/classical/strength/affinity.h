@@ -46,15 +46,21 @@ class  Strength_Affinity< TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indP
         typedef typename Matrix<TConfig_h>::MVector VVector;
         typedef Matrix<TConfig_h> Matrix_h;
     public:
-        Strength_Affinity(AMG_Config &cfg, const std::string &cfg_scope) : Strength_AffinityBase<TConfig_h>(cfg, cfg_scope) {}
+        int n_TV;
+        int affinity_iters;
+        Strength_Affinity(AMG_Config &cfg, const std::string &cfg_scope);
     private:
-        virtual void computeStrongConnectionsAndWeights_1x1(Matrix_h &A,
+        // largest number of test vectors the coarser levels grow to
+        int m_max_TV;
+        // test vectors stored row by row, n_TV values per row
+        Vector<TConfig_h> m_x;
+        Vector<TConfig_h> m_x_new;
+        VVector m_aff_values;
+
+        void computeStrongConnectionsAndWeights_1x1(Matrix_h &A,
                 BVector &s_con,
                 FVector &weights,
-                const double max_row_sum)
-        {
-            FatalError("Strength affinity: computeStrongConnectionsAndWeights_1x1 not implemented on CPU, exiting", AMGX_ERR_NOT_SUPPORTED_TARGET);
-        }
+                const double max_row_sum);
         virtual void computeWeights_1x1(Matrix_h &S,
                                         FVector &weights)
         {
@@ -82,6 +88,8 @@ class  Strength_Affinity< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_in
         Strength_Affinity(AMG_Config &cfg, const std::string &cfg_scope);
         ~Strength_Affinity() {delete solver;};
     private:
+        // largest number of test vectors the coarser levels grow to
+        int m_max_TV;
         Matrix<TConfig_d> m_aff;
         Vector<TConfig_d> m_x;
         Vector<TConfig_d> m_rhs;
@@ -37,6 +37,7 @@ template <class TConfig> class Energymin_AMG_Level_Base;
 #include <error.h>
 #include <distributed/distributed_comms.h>
 #include <distributed/distributed_arranger.h>
+#include <distributed/global_to_local_map.h>
 #include <matrix_distribution.h>
 
 #include "amgx_types/math.h"
@@ -1688,6 +1689,8 @@ template <typename TConfig> class DistributedManagerBase
         INDEX_TYPE _num_rows_all = 0;
         INDEX_TYPE _num_nz_all = 0;
         bool m_fixed_view_size;
+        uint64_t m_structure_fingerprint = 0;
+        int m_value_only_uploads = 0;
 
         //Containers for Level 0 API:
         std::vector<IVector >_B2L_maps;
@@ -1801,6 +1804,14 @@ template <typename TConfig> class DistributedManagerBase
 
         inline bool isViewSizeFixed() { return this->m_fixed_view_size; }
 
+        // hash of the sizes, global sparsity pattern and partitioning of the last distributed upload, 0 if none
+        inline uint64_t getStructureFingerprint() const { return this->m_structure_fingerprint; }
+        inline void setStructureFingerprint(uint64_t fingerprint) { this->m_structure_fingerprint = fingerprint; }
+
+        // uploads that only replaced the values since this manager was built
+        inline int getValueOnlyUploads() const { return this->m_value_only_uploads; }
+        inline void countValueOnlyUpload() { this->m_value_only_uploads++; }
+
 };
 
 // specialization for host
@@ -2093,8 +2104,7 @@ class DistributedManager< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_in
         template <typename t_colIndex>
         void loadDistributed_SetOffsets(int num_ranks, int num_rows_global, const t_colIndex* partition_offsets);
 
-        template <typename t_colIndex>
-        std::map<t_colIndex, int> loadDistributed_LocalToGlobal(int num_rows, I64Vector_h &off_diag_cols);
+        void loadDistributed_LocalToGlobal(int num_rows, I64Vector_h &off_diag_cols, GlobalToLocalMap &global_to_local);
 
         void loadDistributed_InitLocalMatrix(IVector_h local_col_indices, int num_rows, int num_nonzeros, const int block_dimx, const int block_dimy,
             const int *row_offsets, const mat_value_type *values, const void *diag);
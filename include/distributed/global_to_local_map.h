@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+namespace amgx
+{
+
+// Open-addressing (linear probing) hash map from global column index to
+// local column index, used when renumbering the halo columns of a
+// distributed upload. Global columns are non-negative, so -1 marks an empty
+// slot. Capacity is a power of two at least twice the number of keys, which
+// keeps probe sequences short without the per-node allocations of std::map.
+// Keys are std::atomic so that OpenMP threads can insert concurrently.
+class GlobalToLocalMap
+{
+    public:
+        GlobalToLocalMap() : m_capacity(0), m_mask(0), m_size(0), m_overflow(false) {}
+
+        // Empties the map and sizes it for about num_keys distinct keys.
+        void reserve(size_t num_keys)
+        {
+            size_t capacity = 16;
+
+            while (capacity < 2 * num_keys)
+            {
+                capacity <<= 1;
+            }
+
+            m_keys.reset(new std::atomic<int64_t>[capacity]);
+
+            for (size_t i = 0; i < capacity; i++)
+            {
+                m_keys[i].store(empty_key(), std::memory_order_relaxed);
+            }
+
+            m_values.assign(capacity, -1);
+            m_capacity = capacity;
+            m_mask = capacity - 1;
+            m_size.store(0, std::memory_order_relaxed);
+            m_overflow.store(false, std::memory_order_relaxed);
+        }
+
+        // Inserts key if absent, returns true if this call inserted it. Safe to call
+        // concurrently. Once the map is half full it stops accepting keys and sets
+        // overflowed(), the caller then has to reserve more and insert again.
+        bool insert(int64_t key)
+        {
+            size_t slot = hash(key) & m_mask;
+
+            for (size_t probes = 0; probes < m_capacity && !m_overflow.load(std::memory_order_relaxed); probes++)
+            {
+                int64_t cur = m_keys[slot].load(std::memory_order_acquire);
+
+                if (cur == key)
+                {
+                    return false;
+                }
+
+                if (cur == empty_key())
+                {
+                    if (m_keys[slot].compare_exchange_strong(cur, key, std::memory_order_acq_rel))
+                    {
+                        if (2 * (m_size.fetch_add(1, std::memory_order_relaxed) + 1) > m_capacity)
+                        {
+                            m_overflow.store(true, std::memory_order_relaxed);
+                        }
+
+                        return true;
+                    }
+
+                    // another thread took the slot, cur now holds its key
+                    if (cur == key)
+                    {
+                        return false;
+                    }
+                }
+
+                slot = (slot + 1) & m_mask;
+            }
+
+            m_overflow.store(true, std::memory_order_relaxed);
+            return false;
+        }
+
+        bool overflowed() const { return m_overflow.load(std::memory_order_relaxed); }
+
+        // Sets the value of a key that was previously inserted.
+        void set(int64_t key, int value)
+        {
+            m_values[find_slot(key)] = value;
+        }
+
+        // Returns the local index of key, or -1 if key is not in the map.
+        int operator[](int64_t key) const
+        {
+            size_t slot = find_slot(key);
+            return m_keys[slot].load(std::memory_order_relaxed) == key ? m_values[slot] : -1;
+        }
+
+        size_t size() const { return m_size.load(std::memory_order_relaxed); }
+        size_t capacity() const { return m_capacity; }
+
+        // Collects all inserted keys (unordered) into out.
+        template <typename Vec>
+        void keys(Vec &out) const
+        {
+            out.clear();
+            out.reserve(size());
+
+            for (size_t i = 0; i < m_capacity; i++)
+            {
+                const int64_t key = m_keys[i].load(std::memory_order_relaxed);
+
+                if (key != empty_key())
+                {
+                    out.push_back(key);
+                }
+            }
+        }
+
+        // Maps the distinct values of global[0, n), which may repeat, to first_local,
+        // first_local + 1, ... in ascending global order and returns them sorted in
+        // local_to_global. Halo columns are usually shared by several rows, so the map
+        // starts at a quarter of n and grows (reinserting everything) when it fills up.
+        template <typename Vec>
+        void renumber(const int64_t *global, int64_t n, int first_local, Vec &local_to_global)
+        {
+            size_t expected = (size_t)(n / 4 + 1);
+
+            do
+            {
+                reserve(expected);
+                #pragma omp parallel for
+                for (int64_t i = 0; i < n; i++)
+                {
+                    insert(global[i]);
+                }
+                expected *= 4;
+            }
+            while (overflowed());
+
+            keys(local_to_global);
+            std::sort(local_to_global.begin(), local_to_global.end());
+            const int64_t num_keys = local_to_global.size();
+            #pragma omp parallel for
+            for (int64_t i = 0; i < num_keys; i++)
+            {
+                set(local_to_global[i], first_local + (int)i);
+            }
+        }
+
+    private:
+        static int64_t empty_key() { return -1; }
+
+        static size_t hash(int64_t key)
+        {
+            // 64-bit finalizer from MurmurHash3, spreads consecutive column indices
+            uint64_t h = (uint64_t)key;
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return (size_t)h;
+        }
+
+        // only used once all insertions are done, so relaxed loads suffice
+        size_t find_slot(int64_t key) const
+        {
+            size_t slot = hash(key) & m_mask;
+
+            while (true)
+            {
+                const int64_t cur = m_keys[slot].load(std::memory_order_relaxed);
+
+                if (cur == key || cur == empty_key())
+                {
+                    return slot;
+                }
+
+                slot = (slot + 1) & m_mask;
+            }
+        }
+
+        std::unique_ptr<std::atomic<int64_t>[]> m_keys;
+        std::vector<int> m_values;
+        size_t m_capacity;
+        size_t m_mask;
+        std::atomic<size_t> m_size;
+        std::atomic<bool> m_overflow;
+};
+
+} // namespace amgx
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <stdint.h>
+
+namespace amgx
+{
+
+// Multilevel k-way partitioning of the adjacency graph of a square CSR matrix (host arrays).
+// The graph is symmetrized and self loops are dropped, then coarsened by heavy-edge matching,
+// partitioned on the coarsest level by greedy graph growing and projected back with greedy
+// boundary refinement on every level. Each part holds at most imbalance * num_rows / num_parts
+// rows where possible. The result is deterministic for a given input, so all ranks computing it
+// from the same matrix agree on the partition without communication.
+// Writes one part id per row into partition and returns the number of cut edges.
+int64_t partitionGraphKway(int num_rows, const int *row_offsets, const int *col_indices, int num_parts, int *partition, double imbalance = 1.03);
+
+} // namespace amgx
@@ -210,6 +210,85 @@ cudaError_t cudaFreeAsync(void *ptr, cudaStream_t stream = 0);
 // Wait for the asynchronous frees to complete.
 void cudaFreeWait();
 
+// Subsystems the allocations made through cudaMallocAsync and cudaMallocHost are accounted to. The
+// accounting only sees these two allocators, i.e. device memory and pinned host memory. Pageable host
+// memory (host vectors, std containers) is not accounted, so host-mode hierarchies do not show up.
+enum MemoryTag
+{
+    MEMORY_TAG_OTHER = 0,
+    MEMORY_TAG_MATRIX,      // coarse matrices of the hierarchy
+    MEMORY_TAG_TRANSFER,    // aggregates, C/F splittings, prolongation and restriction
+    MEMORY_TAG_SMOOTHER,
+    MEMORY_TAG_SOLVER,      // Krylov and coarse solver workspaces
+    MEMORY_TAG_COMMS,       // halo exchange buffers
+    MEMORY_TAG_COLORING,
+    MEMORY_TAG_COUNT
+};
+
+// Levels deeper than this are accounted to the last one.
+const int MEMORY_ACCOUNTING_MAX_LEVELS = 32;
+
+const char *getMemoryTagName(MemoryTag tag);
+
+// Tag and hierarchy level (-1 for none) of the allocations made by the current thread.
+MemoryTag getMemoryTag();
+int getMemoryLevel();
+void setMemoryTag(MemoryTag tag, int level);
+
+// Accounts the allocations made while in scope to tag and level (the enclosing level if level is -1).
+class MemoryTagScope
+{
+    public:
+        MemoryTagScope(MemoryTag tag, int level = -1) : m_tag(getMemoryTag()), m_level(getMemoryLevel())
+        {
+            setMemoryTag(tag, level < 0 ? m_level : level);
+        }
+
+        ~MemoryTagScope() { setMemoryTag(m_tag, m_level); }
+
+    private:
+        MemoryTag m_tag;
+        int m_level;
+};
+
+// Owner (the Resources of the solver) the allocations made by the current thread are charged to, set
+// by the innermost MemoryOwnerScope, NULL outside of any.
+const void *getMemoryOwner();
+// Per-allocation accounting costs a lookup per malloc/free, it is only on inside a MemoryOwnerScope
+// whose owner enabled it ("memory_accounting").
+bool getMemoryAccounting();
+
+// Charges the allocations made while in scope to owner, and accounts them only if enabled.
+class MemoryOwnerScope
+{
+    public:
+        MemoryOwnerScope(const void *owner, bool enabled);
+        ~MemoryOwnerScope();
+
+    private:
+        MemoryOwnerScope(const MemoryOwnerScope &);
+        MemoryOwnerScope &operator=(const MemoryOwnerScope &);
+        const void *m_owner;
+        bool m_enabled;
+};
+
+struct MemoryReportEntry
+{
+    MemoryTag tag;
+    int level;
+    bool device;
+    size_t current_bytes;
+    size_t peak_bytes;
+};
+
+// Current and peak bytes of every (tag, level, memory space) that was charged to owner, and the peaks
+// of its totals. device is false for pinned host memory.
+void getMemoryReport(const void *owner, std::vector<MemoryReportEntry> &entries, size_t &device_peak_bytes, size_t &pinned_peak_bytes);
+// Restarts the peaks of owner from its current usage.
+void resetMemoryPeaks(const void *owner);
+// Drops the counters of owner, its allocations that are still alive are no longer accounted.
+void releaseMemoryOwner(const void *owner);
+
 // Join threads. ????
 void joinPinnedPools();
 void joinDevicePools();
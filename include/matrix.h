@@ -251,6 +251,7 @@ class MatrixBase : public AuxData, public Operator<T_Config>
         inline void copy(const MatrixType &a)
         {
             this->set_initialized(0);
+            clearAssemblyMap();
             copyAuxData(&a);
             block_dimy = a.get_block_dimy();
             block_dimx = a.get_block_dimx();
@@ -298,6 +299,7 @@ class MatrixBase : public AuxData, public Operator<T_Config>
         inline void copy_structure(const MatrixType &a)
         {
             this->set_initialized(0);
+            clearAssemblyMap();
             copyAuxData(&a);
             block_dimy = a.get_block_dimy();
             block_dimx = a.get_block_dimx();
@@ -684,7 +686,9 @@ class MatrixBase : public AuxData, public Operator<T_Config>
                    m_larger_color_offsets.bytes(device_only) +
                    m_smaller_color_offsets.bytes(device_only) +
                    m_diag_end_offsets.bytes(device_only) +
-                   m_values_permutation_vector.bytes(device_only) ;
+                   m_values_permutation_vector.bytes(device_only) +
+                   m_assembly_permutation.bytes(device_only) +
+                   m_assembly_segments.bytes(device_only) ;
         }
         /********************************************************/
 
@@ -813,6 +817,10 @@ class MatrixBase : public AuxData, public Operator<T_Config>
         IVector m_smaller_color_offsets; //size: num_rows,
         IVector m_values_permutation_vector;
 
+        /* Triplet assembly: input position of every sorted entry and its 1-based output slot */
+        IVector m_assembly_permutation; //size: number of input triplets
+        IVector m_assembly_segments;    //size: number of input triplets
+
         /* CSR Members */
         IVector row_offsets; //size: num_rows+1
 
@@ -872,6 +880,14 @@ class MatrixBase : public AuxData, public Operator<T_Config>
 
         void sortByRowAndColumn();
 
+        // Builds a scalar CSR matrix from unsorted (row, col, value) triplets, duplicates are summed.
+        // The sort permutation is kept so that replaceAssembledValues() is a single gather + segmented sum.
+        void assembleFromTriplets(index_type num_rows, const IVector &in_row_indices, const IVector &in_col_indices, const MVector &in_values);
+        void replaceAssembledValues(const MVector &in_values);
+        inline bool hasAssemblyMap() const { return m_assembly_permutation.size() > 0; }
+        inline index_type getAssemblyMapSize() const { return m_assembly_permutation.size(); }
+        inline void clearAssemblyMap() { m_assembly_permutation.clear(); m_assembly_segments.clear(); }
+
         //void reorderRowsAndColumnsByColor(bool permute_values_flag);
 
         virtual void permuteValues() = 0;
@@ -1037,6 +1053,7 @@ class Matrix< TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> > : pub
                 delete (this->m_matrix_coloring);
             }
 
+            amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_COLORING);
             this->m_matrix_coloring = MatrixColoringFactory<TConfig>::allocate(cfg, cfg_scope);
 
             if (this->hasParameter("coloring") && this->template getParameter<int>("coloring_size") == this->get_num_rows())
@@ -1206,6 +1223,7 @@ class Matrix< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> > : p
                 delete (this->m_matrix_coloring);
             }
 
+            amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_COLORING);
             this->m_matrix_coloring = MatrixColoringFactory<TConfig>::allocate(cfg, cfg_scope);
 
             // Copy the colors if provided by user
@@ -1250,6 +1268,7 @@ class Matrix< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> > : p
                 delete (this->m_matrix_coloring);
             }
 
+            amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_COLORING);
             this->m_matrix_coloring = MatrixColoringFactory<TConfig>::allocate(cfg, cfg_scope);
 
             if (this->hasParameter("coloring") && this->template getParameter<int>("coloring_size") == this->get_num_rows())
@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <matrix.h>
 #include <error.h>
+#include <amg_diagnostics.h>
 
 #include <amgx_types/pod_types.h>
 
@@ -80,6 +81,12 @@ class MatrixAnalysis
         void aggregatesQuality2(const typename Matrix<T_Config>::IVector &aggregates, int num_aggregates, const Matrix<T_Config> &Aorig);
         void visualizeAggregates(typename Matrix<T_Config>::IVector &aggregates);
 
+        // Level metrics of the diagnostics API (amg_diagnostics.h). The aggregate statistics are
+        // computed on the bound matrix. With rate_aggregates the quality bound is added too, which
+        // copies the matrix to the host and solves the dense eigenproblems of the aggregates in parallel.
+        void aggregateDiagnostics(const typename Matrix<T_Config>::IVector &aggregates, int num_aggregates, bool rate_aggregates, LevelDiagnostics &d);
+        static void interpolationDiagnostics(const Matrix<T_Config> &P, LevelDiagnostics &d);
+
     private:
         const Matrix<TConfig> *A;
         Vector<TConfig> *b;
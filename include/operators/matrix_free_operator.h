@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <operators/operator.h>
+#include <matrix.h>
+
+namespace amgx
+{
+
+// Operator applied through a user callback. The structure queries and the views are taken from
+// an assembled surrogate matrix of the same size (e.g. a low-order discretization), which is
+// also the operator preconditioners are set up from.
+template <typename T_Config>
+class MatrixFreeOperator : public Operator<T_Config>
+{
+    public:
+        typedef T_Config TConfig;
+        typedef Operator<TConfig> Base;
+
+        typedef typename TConfig::VecPrec ValueTypeVec;
+        typedef typename TConfig::IndPrec IndType;
+
+        // y = A x on the owned rows, x and y are in the memory space and vector precision of TConfig
+        typedef void (*ApplyCallback)(const void *x, void *y, void *user_data);
+
+        MatrixFreeOperator(Matrix<TConfig> &surrogate, ApplyCallback apply, void *user_data)
+            : m_A(&surrogate), m_apply(apply), m_user_data(user_data)
+        {
+        }
+
+        ~MatrixFreeOperator()
+        {
+        }
+
+        void apply(const Vector<TConfig> &v, Vector<TConfig> &res, ViewType view = OWNED);
+
+        Operator<TConfig> &getPreconditionerOperator()
+        {
+            return *m_A;
+        }
+
+        DistributedManager<TConfig> *getManager() const
+        {
+            return m_A->getManager();
+        }
+
+        IndType get_num_rows() const
+        {
+            return m_A->get_num_rows();
+        }
+        IndType get_num_cols() const
+        {
+            return m_A->get_num_cols();
+        }
+        IndType get_block_dimx() const
+        {
+            return m_A->get_block_dimx();
+        }
+        IndType get_block_dimy() const
+        {
+            return m_A->get_block_dimy();
+        }
+        IndType get_block_size() const
+        {
+            return m_A->get_block_size();
+        }
+
+        bool is_matrix_singleGPU() const
+        {
+            return m_A->is_matrix_singleGPU();
+        }
+        bool is_matrix_distributed() const
+        {
+            return m_A->is_matrix_distributed();
+        }
+
+        ViewType currentView() const
+        {
+            return m_A->currentView();
+        }
+        void setView(ViewType type)
+        {
+            m_A->setView(type);
+        }
+        void setViewInterior()
+        {
+            m_A->setViewInterior();
+        }
+        void setViewExterior()
+        {
+            m_A->setViewExterior();
+        }
+        void setInteriorView(ViewType view)
+        {
+            m_A->setInteriorView(view);
+        }
+        void setExteriorView(ViewType view)
+        {
+            m_A->setExteriorView(view);
+        }
+        ViewType getViewInterior() const
+        {
+            return m_A->getViewInterior();
+        }
+        ViewType getViewExterior() const
+        {
+            return m_A->getViewExterior();
+        }
+
+        void getOffsetAndSizeForView(ViewType type, int *offset, int *size) const
+        {
+            m_A->getOffsetAndSizeForView(type, offset, size);
+        }
+    private:
+        Matrix<TConfig> *m_A;
+        ApplyCallback m_apply;
+        void *m_user_data;
+};
+
+}
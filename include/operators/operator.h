@@ -54,6 +54,13 @@ class Operator
         virtual ViewType getViewExterior() const = 0;
 
         virtual void getOffsetAndSizeForView(ViewType type, int *offset, int *size) const = 0;
+
+        // Operator the preconditioner of a solver acting on this operator is set up from.
+        // Matrix-free operators return the assembled surrogate matrix they were given.
+        virtual Operator<TConfig> &getPreconditionerOperator()
+        {
+            return *this;
+        }
 };
 
 }
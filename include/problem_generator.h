@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <matrix.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace amgx
+{
+
+enum ProblemKind
+{
+    PROBLEM_POISSON5,       // 2D 5-point Laplacian
+    PROBLEM_POISSON7,       // 3D 7-point Laplacian
+    PROBLEM_POISSON9,       // 2D 9-point Laplacian
+    PROBLEM_POISSON27,      // 3D 27-point Laplacian
+    PROBLEM_ANISO,          // 5/7-point diffusion with coefficient eps in x
+    PROBLEM_ROTATED_ANISO,  // 2D 9-point diffusion with coefficient eps along a direction rotated by theta
+    PROBLEM_JUMP,           // 5/7-point diffusion with a checkerboard coefficient jumping by contrast
+    PROBLEM_CONVDIFF,       // 5/7-point diffusion plus first order upwind convection with velocity (vx, vy, vz)
+    PROBLEM_ELASTICITY,     // linear elasticity, 2x2 blocks on 2D grids and 3x3 blocks on 3D grids
+    PROBLEM_RANDOM_SPD      // shifted Laplacian of a random graph with nx * ny * nz vertices
+};
+
+// Problem on an nx x ny x nz grid, nz == 1 for the 2D problems. Rows are numbered
+// lexicographically with x fastest. Every row is computed from its grid index alone, so any
+// range of rows can be generated independently (in parallel on the host, or by each rank of a
+// distributed run) and all generators use Dirichlet boundaries.
+struct ProblemDesc
+{
+    ProblemKind kind;
+    int64_t nx, ny, nz;
+    double eps;             // anisotropy, aniso and rotated_aniso (default 1e-3)
+    double theta;           // rotation in degrees, rotated_aniso (default 45)
+    double contrast;        // coefficient ratio, jump (default 1e3)
+    int jump_blocks;        // checkerboard blocks per dimension, jump (default 4)
+    double vx, vy, vz;      // velocity, convdiff (default 100, 100, 100)
+    double E, nu;           // Young's modulus and Poisson ratio, elasticity (default 1, 0.3)
+    int degree;             // neighbours per vertex, random_spd (default 8)
+    double shift;           // added to the diagonal, random_spd (default 1e-2)
+    unsigned int seed;      // random_spd (default 1)
+
+    ProblemDesc();
+
+    int64_t num_rows() const { return nx * ny * nz; }
+    int block_size() const;
+    int max_row_length() const;
+    bool is_symmetric() const { return kind != PROBLEM_CONVDIFF; }
+};
+
+// Builds a problem description from its name (poisson5, poisson7, poisson9, poisson27, aniso,
+// rotated_aniso, jump, convdiff, elasticity, random_spd), the grid size and a comma separated
+// list of key=value options, e.g. "eps=1e-4, theta=30". Unknown names and keys are fatal.
+ProblemDesc parseProblem(const std::string &name, int64_t nx, int64_t ny, int64_t nz, const std::string &options);
+
+// Rows [row_begin, row_end) of the problem in CSR form with global column indices sorted within
+// each row and row-major blocks of block_size() x block_size() values. Both passes (row lengths,
+// then entries) are OpenMP parallel over the rows.
+template <typename ValueType, typename ColIndex>
+void generateProblemRows(const ProblemDesc &p, int64_t row_begin, int64_t row_end,
+                         std::vector<int> &row_offsets, std::vector<ColIndex> &col_indices, std::vector<ValueType> &values);
+
+// The whole problem as a single-rank matrix, device matrices are built on the host and copied.
+template <class TConfig>
+void generateProblem(const ProblemDesc &p, Matrix<TConfig> &A);
+
+} // namespace amgx
@@ -11,6 +11,7 @@ class Resources;
 
 #include "amg_config.h"
 #include "thread_manager.h"
+#include "setup_structure_cache.h"
 #ifdef AMGX_WITH_MPI
 #include "mpi.h"
 #endif
@@ -37,6 +38,10 @@ class Resources
         int m_num_streams;
         int m_high_priority_stream;
         int m_serialize_threads;
+        size_t m_host_parallel_threshold;
+        bool m_reproducible_reductions;
+        bool m_memory_accounting;
+        SetupStructureCache m_setup_cache;
 #ifdef AMGX_WITH_MPI
         MPI_Comm *m_mpi_comm;
 #endif
@@ -53,6 +58,10 @@ class Resources
         int getDevice(int device_num) const { return m_devices[device_num]; }
         bool getHandleErrors() const { return m_handle_errors; }
         size_t getPoolSize() const { return m_pool_size; }
+        SetupStructureCache &getSetupCache() { return m_setup_cache; }
+        size_t getHostParallelThreshold() const { return m_host_parallel_threshold; }
+        bool getReproducibleReductions() const { return m_reproducible_reductions; }
+        bool getMemoryAccounting() const { return m_memory_accounting; }
         void expandRootPool();
 
         void warning(const std::string s) const;
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+namespace amgx
+{
+
+// Least-recently-used cache of AMG coarse-grid structures (see AMG::exportCoarseStructure),
+// keyed by a fingerprint of the fine matrix sparsity pattern and of the solver configuration.
+// Owned by Resources, so every solver created on the same resources shares it. A capacity of
+// zero disables the cache.
+class SetupStructureCache
+{
+    public:
+        typedef std::vector<std::vector<int> > Structure;
+
+        SetupStructureCache() : m_capacity(0), m_hits(0) {}
+
+        void setCapacity(size_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_capacity = capacity;
+            evict();
+        }
+
+        bool enabled() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_capacity > 0;
+        }
+
+        // Copies the structure stored for key into structure and marks it as most recently used.
+        bool find(uint64_t key, Structure &structure)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (std::list<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (it->first == key)
+                {
+                    m_entries.splice(m_entries.begin(), m_entries, it);
+                    structure = m_entries.front().second;
+                    m_hits++;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void insert(uint64_t key, const Structure &structure)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (std::list<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (it->first == key)
+                {
+                    m_entries.erase(it);
+                    break;
+                }
+            }
+
+            m_entries.push_front(Entry(key, structure));
+            evict();
+        }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        // number of successful finds since the resources were created
+        size_t hits() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+    private:
+        typedef std::pair<uint64_t, Structure> Entry;
+
+        void evict()
+        {
+            while (m_entries.size() > m_capacity)
+            {
+                m_entries.pop_back();
+            }
+        }
+
+        std::list<Entry> m_entries;
+        size_t m_capacity;
+        size_t m_hits;
+        mutable std::mutex m_mutex;
+};
+
+} // namespace amgx
@@ -48,6 +48,9 @@ class AlgebraicMultigrid_Solver: public Solver<T_Config>
 
         void SetThreadManager(ThreadManager *tmng) { m_amg.tmng = tmng; }
 
+        // The hierarchy, e.g. for the level placement of amg_host_levels_auto.
+        inline const AMG<vecPrec, matPrec, indPrec> &getAMG() const { return m_amg; }
+
         // Destructor
         ~AlgebraicMultigrid_Solver();
 
@@ -81,6 +84,11 @@ class AlgebraicMultigrid_Solver: public Solver<T_Config>
         void print_grid_stats();
         void print_grid_stats2();
         void print_vis_data();
+
+        bool exportCoarseStructure(std::vector<std::vector<int> > &structure) { m_amg.exportCoarseStructure(structure); return true; }
+        bool importCoarseStructure(const std::vector<std::vector<int> > &structure) { m_amg.importCoarseStructure(structure); return true; }
+        bool getComplexity(double &grid_complexity, double &operator_complexity) { return m_amg.getComplexity(grid_complexity, operator_complexity); }
+        bool getDiagnostics(HierarchyDiagnostics &diagnostics) { return m_amg.getDiagnostics(diagnostics); }
 };
 
 template<class T_Config>
@@ -5,6 +5,7 @@
 #pragma once
 
 #include<solvers/solver.h>
+#include<solvers/krylov_basis.h>
 #include<cusp/array1d.h>
 #include<cusp/array2d.h>
 
@@ -78,6 +79,8 @@ class FGMRES_Solver : public Solver<T_Config>
             return false;
         }
 
+        Solver<T_Config> *getPreconditioner() { return m_preconditioner; }
+
         void solve_init( VVector &b, VVector &x, bool xIsZero );
         // Run a single iteration. Compute the residual and its norm and decide convergence.
         bool solve_one_iteration( VVector &b, VVector &x );
@@ -86,9 +89,12 @@ class FGMRES_Solver : public Solver<T_Config>
         void solve_finalize( VVector &b, VVector &x );
 
     private:
+        // Iteration for a compressed basis or a fixed preconditioner, without truncation.
+        AMGX_STATUS solve_iteration_compact( VVector &b, VVector &x );
 
         int m_R;  //Iterations between restarts, do we still need restart?
         int m_krylov_size;
+        int m_restart_iter; // iteration the current restart cycle began with, compact iteration only
         bool use_preconditioner;
         bool use_scalar_L2_norm;
         bool update_x_every_iteration; // x is solution
@@ -98,6 +104,18 @@ class FGMRES_Solver : public Solver<T_Config>
         //DEVICE WORKSPACE
         KrylovSubspaceBuffer<T_Config> subspace;
 
+        // Compact workspace, used instead of the subspace buffer when the basis is stored compressed or the
+        // preconditioner is fixed. Only the current and the next basis vector are kept in full precision.
+        bool m_compact;
+        bool m_fixed_preconditioner;
+        KrylovBasisStorage m_basis_storage;
+        KrylovBasis<T_Config> m_V_basis;
+        KrylovBasis<T_Config> m_Z_basis; // not allocated with a fixed preconditioner
+        std::vector<VVector> m_V_work;
+        VVector m_Z_work;
+
+        VVector &V_work(int m) { return m_V_work[m % 2]; }
+
         //HOST WORKSPACE
         //TODO: move those to device
         cusp::array2d<ValueTypeB, cusp::host_memory, cusp::column_major> m_H; //Hessenberg matrix
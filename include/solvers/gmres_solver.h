@@ -5,6 +5,7 @@
 #pragma once
 
 #include <solvers/solver.h>
+#include <solvers/krylov_basis.h>
 #include <cusp/array1d.h>
 #include <cusp/array2d.h>
 
@@ -29,6 +30,7 @@ class GMRES_Solver : public Solver<T_Config>
 
         int m_R;  //Iterations between restarts
         int m_krylov_size;
+        int m_restart_iter; // iteration the current restart cycle began with
         ValueTypeA res_pre;
         bool no_preconditioner;
         // Preconditioner
@@ -38,6 +40,13 @@ class GMRES_Solver : public Solver<T_Config>
         std::vector<VVector> m_V_vectors;
         VVector m_Z_vector;
 
+        // with compressed storage the basis lives in m_basis, and m_V_vectors only keeps the
+        // current and the next basis vector in full precision
+        KrylovBasisStorage m_basis_storage;
+        KrylovBasis<T_Config> m_basis;
+
+        VVector &V(int i) { return m_V_vectors[i % m_V_vectors.size()]; }
+
         //HOST WORKSPACE
         cusp::array2d<ValueTypeB, cusp::host_memory, cusp::column_major> m_H; //Hessenberg matrix
         cusp::array1d<ValueTypeB, cusp::host_memory> m_s;
@@ -66,6 +75,8 @@ class GMRES_Solver : public Solver<T_Config>
 
         bool getInsertDiagonalDesired() const { if (m_preconditioner != NULL) return m_preconditioner->getInsertDiagonalDesired(); return false; }
 
+        Solver<T_Config> *getPreconditioner() { return m_preconditioner; }
+
         // Initialize the solver before running the iterations.
         void solve_init( VVector &b, VVector &x, bool xIsZero );
         // Run a single iteration. Compute the residual and its norm and decide convergence.
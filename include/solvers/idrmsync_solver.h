@@ -65,6 +65,8 @@ class IDRMSYNC_Solver_Base : public Solver<T_Config>
 
         bool getInsertDiagonalDesired() const { if (m_preconditioner != NULL) return m_preconditioner->getInsertDiagonalDesired(); return false; }
 
+        Solver<TConfig> *getPreconditioner() { return m_preconditioner; }
+
         // Initialize the solver before running the iterations.
         void solve_init( VVector &b, VVector &x, bool xIsZero );
         // Run a single iteration. Compute the residual and its norm and decide convergence.
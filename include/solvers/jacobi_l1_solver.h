@@ -26,6 +26,7 @@ class JacobiL1Solver_Base : public Solver<T_Config>
         typedef Vector<T_Config> VVector;
         typedef Vector<TemplateConfig<AMGX_host, vecPrec, matPrec, indPrec> > Vector_h;
         typedef typename Matrix<TConfig>::MVector MVector;
+        typedef typename Matrix<TConfig>::IVector IVector;
 
     private:
 
@@ -44,6 +45,7 @@ class JacobiL1Solver_Base : public Solver<T_Config>
         virtual void smooth_4x4(Matrix<T_Config> &A, VVector &b, VVector &x, ViewType separation_flags) = 0;
         virtual void smooth_1x1(Matrix<T_Config> &A, VVector &b, VVector &x, ViewType separation_flags, bool latency_hiding) = 0;
         virtual void smooth_with_0_initial_guess_1x1(Matrix<T_Config> &A, VVector &b, VVector &x, ViewType separation_flags) = 0;
+        virtual void smooth_with_correction_1x1(Matrix<T_Config> &A, VVector &b, VVector &x, const VVector &e, const IVector &aggregates) = 0;
 
     public:
         // Constructor.
@@ -69,6 +71,8 @@ class JacobiL1Solver_Base : public Solver<T_Config>
         AMGX_STATUS solve_iteration( VVector &b, VVector &x, bool xIsZero );
         // Finalize the solver after running the iterations.
         void solve_finalize( VVector &b, VVector &x );
+
+        bool smooth_with_correction( VVector &b, VVector &x, const VVector &e, const IVector &aggregates );
 };
 
 // ----------------------------
@@ -92,6 +96,7 @@ class JacobiL1Solver< TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
         void smooth_4x4(Matrix_h &A, VVector &b, VVector &x, ViewType separation_flags);
         void smooth_1x1(Matrix_h &A, VVector &b, VVector &x, ViewType separation_flags, bool latency_hiding);
         void smooth_with_0_initial_guess_1x1(Matrix_h &A, VVector &b, VVector &x, ViewType separation_flags);
+        void smooth_with_correction_1x1(Matrix_h &A, VVector &b, VVector &x, const VVector &e, const typename Matrix_h::IVector &aggregates);
 };
 
 // ----------------------------
@@ -117,6 +122,7 @@ class JacobiL1Solver< TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPre
         void smooth_4x4(Matrix_d &A, VVector &b, VVector &x, ViewType separation_flags);
         void smooth_1x1(Matrix_d &A, VVector &b, VVector &x, ViewType separation_flags, bool latency_hiding);
         void smooth_with_0_initial_guess_1x1(Matrix_d &A, VVector &b, VVector &x, ViewType separation_flags);
+        void smooth_with_correction_1x1(Matrix_d &A, VVector &b, VVector &x, const VVector &e, const IVector &aggregates);
 };
 
 template<class T_Config>
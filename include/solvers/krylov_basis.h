@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <vector.h>
+#include <vector_thrust_allocator.h>
+#include <operators/operator.h>
+
+namespace amgx
+{
+
+// precision used to keep the Krylov basis of the GMRES solvers between iterations
+enum KrylovBasisStorage
+{
+    KRYLOV_BASIS_FULL,
+    KRYLOV_BASIS_FLOAT,
+    KRYLOV_BASIS_BFLOAT16
+};
+
+KrylovBasisStorage getKrylovBasisStorage(const std::string &name);
+
+template <AMGX_MemorySpace MemSpace, class T>
+struct KrylovBasisContainer;
+
+template <class T>
+struct KrylovBasisContainer<AMGX_host, T>
+{
+    typedef amgx::thrust::host_vector<T> Type;
+};
+
+template <class T>
+struct KrylovBasisContainer<AMGX_device, T>
+{
+    typedef device_vector_alloc<T> Type;
+};
+
+// Set of basis vectors stored either in the working precision or compressed to float / bfloat16.
+// Compressed vectors are only touched through fused kernels which decode them on the fly, so the
+// orthogonalization arithmetic is still carried out in the working precision. All the operations
+// act on the exterior view of the operator.
+template <class TConfig>
+class KrylovBasis
+{
+    public:
+        typedef Vector<TConfig> VVector;
+        typedef typename TConfig::VecPrec ValueTypeB;
+        typedef typename KrylovBasisContainer<TConfig::memSpace, float>::Type FloatVector;
+        typedef typename KrylovBasisContainer<TConfig::memSpace, uint16_t>::Type Bfloat16Vector;
+
+        KrylovBasis() : m_storage(KRYLOV_BASIS_FULL) {}
+
+        // allocate num_vectors vectors of N entries
+        void setup(int num_vectors, int N, int block_dimy, int tag, KrylovBasisStorage storage);
+        void clear();
+
+        bool is_compressed() const { return m_storage != KRYLOV_BASIS_FULL; }
+        int get_num_vectors() const;
+
+        // V(i) = w
+        void store(const Operator<TConfig> &A, int i, const VVector &w);
+        // w = V(i), w is marked dirty so the halo gets exchanged on next use
+        void load(const Operator<TConfig> &A, int i, VVector &w) const;
+        // <V(i), w>, reduced over all the ranks
+        ValueTypeB dot(const Operator<TConfig> &A, int i, const VVector &w) const;
+        // w += alpha * V(i)
+        void axpy(const Operator<TConfig> &A, int i, VVector &w, ValueTypeB alpha) const;
+
+    private:
+        KrylovBasisStorage m_storage;
+        std::vector<VVector> m_full;
+        std::vector<FloatVector> m_float;
+        std::vector<Bfloat16Vector> m_bfloat16;
+};
+
+} // namespace amgx
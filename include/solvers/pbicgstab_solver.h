@@ -52,6 +52,8 @@ class PBiCGStab_Solver : public Solver<T_Config>
 
         bool getInsertDiagonalDesired() const { if (m_preconditioner != NULL) return m_preconditioner->getInsertDiagonalDesired(); return false; }
 
+        Solver<T_Config> *getPreconditioner() { return m_preconditioner; }
+
         // Initialize the solver before running the iterations.
         void solve_init( VVector &b, VVector &x, bool xIsZero );
 
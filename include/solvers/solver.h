@@ -12,6 +12,7 @@ template<class T_config> class Scaler;
 
 #include <convergence/convergence.h>
 #include <thread_manager.h>
+#include <amg_diagnostics.h>
 
 #include <amgx_types/util.h>
 
@@ -77,6 +78,8 @@ class Solver : public AuxData
 
         // Is it the last iteration?
         inline bool is_last_iter() const { return m_curr_iter == m_max_iters - 1; }
+        // Is convergence checked in this iteration?
+        inline bool is_check_iter() const { return m_check_frequency <= 1 || (m_curr_iter + 1) % m_check_frequency == 0 || is_last_iter(); }
 
         // reset timers
         void reset_setup_timer();
@@ -93,14 +96,30 @@ class Solver : public AuxData
         // Decide convergence based m_nrm.
         AMGX_STATUS converged() const;
 
-        // Compute the norm and decide convergence.
+        // Compute the norm and decide convergence. Iterations between two checks (convergence_check_frequency)
+        // return AMGX_ST_NOT_CONVERGED without a norm, with convergence_check_lag the decision is lagged.
         inline AMGX_STATUS compute_norm_and_converged()
         {
-            compute_norm();
+            if (!is_check_iter())
+            {
+                m_nrm_exact = false;
+                m_nrm_lag = -1;
+                return AMGX_ST_NOT_CONVERGED;
+            }
+
+            if (m_check_lag > 0)
+            {
+                return lagged_norm_and_converged();
+            }
 
+            compute_norm();
+            m_nrm_lag = 0;
             return converged();
         }
 
+        // Enqueue the norm of the residual and decide convergence on the norm enqueued m_check_lag checks ago.
+        AMGX_STATUS lagged_norm_and_converged();
+
         // Compute a residual r = b - Ax.
         void compute_residual( const VVector &b, VVector &x, VVector &r ) const;
         // Compute the norm of v.
@@ -158,6 +177,11 @@ class Solver : public AuxData
         // Solve
         virtual void smooth( Vector<TConfig> &b, Vector<TConfig> &x, bool xIsZero ) { solve(b, x, xIsZero); }
 
+        // One smoothing sweep on x + P*e, where P copies e[aggregates[i]] to row i, in a single pass over
+        // the matrix. Used by the multigrid cycle to fold the coarse-grid correction into the first
+        // post-smoothing sweep. Smoothers that cannot fuse it return false and leave x untouched.
+        virtual bool smooth_with_correction( VVector &b, VVector &x, const VVector &e, const Vector<typename TConfig::template setVecPrec<AMGX_vecInt>::Type> &aggregates ) { return false; }
+
         // Print the timings.
         void print_timings();
         // Print grid stats.
@@ -165,6 +189,17 @@ class Solver : public AuxData
         virtual void print_grid_stats2() {}
         // Print visualization data.
         virtual void print_vis_data() {}
+        // Solver applied as preconditioner, NULL if there is none. The hierarchy queries below are
+        // forwarded to it unless the solver owns the hierarchy itself.
+        virtual Solver<TConfig> *getPreconditioner() { return NULL; }
+        // Coarse-grid structure of the AMG hierarchy used by this solver (see AMG::exportCoarseStructure).
+        // Returns false if neither the solver nor its preconditioner owns an AMG hierarchy.
+        virtual bool exportCoarseStructure(std::vector<std::vector<int> > &structure) { Solver<TConfig> *p = getPreconditioner(); return p != NULL && p->exportCoarseStructure(structure); }
+        virtual bool importCoarseStructure(const std::vector<std::vector<int> > &structure) { Solver<TConfig> *p = getPreconditioner(); return p != NULL && p->importCoarseStructure(structure); }
+        // Grid and operator complexity of that hierarchy, false if there is none.
+        virtual bool getComplexity(double &grid_complexity, double &operator_complexity) { Solver<TConfig> *p = getPreconditioner(); return p != NULL && p->getComplexity(grid_complexity, operator_complexity); }
+        // Per-level metrics of that hierarchy (see amg_diagnostics.h), false if there is none.
+        virtual bool getDiagnostics(HierarchyDiagnostics &diagnostics) { Solver<TConfig> *p = getPreconditioner(); return p != NULL && p->getDiagnostics(diagnostics); }
         // Print the solver settings
         virtual void printSolverParameters() const {}
 
@@ -235,6 +270,17 @@ class Solver : public AuxData
 
         // Convergence object. To decide convergence.
         Convergence<TConfig> *m_convergence;
+        // Convergence is checked every m_check_frequency iterations. With m_check_lag > 0 the norm is
+        // copied asynchronously to one of m_check_lag + 1 pinned slots and read m_check_lag checks later.
+        int m_check_frequency;
+        int m_check_lag;
+        PODValueB *m_lagged_nrm;
+        std::vector<cudaEvent_t> m_lagged_events;
+        int m_lagged_issued;
+        // Is m_nrm the norm of the current residual?
+        bool m_nrm_exact;
+        // Iterations m_nrm lags behind the current one, -1 if no norm was computed in this iteration.
+        int m_nrm_lag;
         // The type of norms.
         NormType m_norm_type;
 
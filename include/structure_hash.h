@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace amgx
+{
+
+// Position dependent 64-bit hash of a buffer of 32-bit words, used to recognize a sparsity pattern
+// seen before. Each word is mixed with its index and the results are summed, so the hash is
+// computed by a parallel reduction where the buffer lives: on the device for device and managed
+// memory, on the host (OpenMP above host_parallel_threshold) otherwise. The sum does not depend on
+// the reduction order. size is in bytes, a trailing partial word is hashed on the host.
+uint64_t structureHash(const void *ptr, size_t size, uint64_t seed);
+
+} // namespace amgx
@@ -16,6 +16,9 @@
 #include <thrust/adjacent_difference.h>
 #include <type_traits>
 #include <basic_types.h>
+#ifdef AMGX_HOST_OPENMP
+#include <thrust/system/omp/execution_policy.h>
+#endif
 
 template <class T>
 using amgx_thrust_host_allocator = amgx::thrust_amgx_allocator<typename amgx::thrust::iterator_traits<T>::value_type, AMGX_host>;
@@ -36,26 +39,72 @@ auto amgx_thrust_get_allocator(std::true_type)
     return amgx::thrust::cuda::par_nosync(amgx_thrust_device_allocator<InputIterator>());
 }
 
-namespace thrust_wrapper
+namespace amgx
 {
-  template<int MemSpace, typename InputIterator, typename OutputIterator>
-    inline typename std::enable_if<MemSpace == AMGX_host, void>::type 
-    exclusive_scan(InputIterator first, InputIterator last, OutputIterator result)
+class Resources;
+
+// Host primitives with at least this many elements run on the OpenMP backend, 0 keeps them sequential.
+// The thrust primitives only go parallel in builds with AMGX_HOST_OPENMP, the host loops with
+// independent rows that check it in every build with OpenMP. The threshold belongs to the calling
+// thread: it is the host_parallel_threshold of the resources set by the innermost HostParallelScope,
+// or the parameter default outside of any scope.
+void setHostParallelThreshold(size_t threshold);
+size_t getHostParallelThreshold();
+
+// Makes the calling thread use the host_parallel_threshold of res until the end of the scope, so that
+// solvers on different resources do not change each other's threshold. A NULL res keeps the current one.
+class HostParallelScope
+{
+    public:
+        explicit HostParallelScope(const Resources *res);
+        ~HostParallelScope();
+
+    private:
+        HostParallelScope(const HostParallelScope &);
+        HostParallelScope &operator=(const HostParallelScope &);
+        size_t m_previous;
+};
+}
+
+// Runs f with the execution policy for the memory space. Large host ranges get the OpenMP policy
+// (parallel merge sort, blocked scan, tree reduction on the OpenMP thread pool), small ones stay
+// on the sequential backend where the fork/join overhead would dominate.
+template<class InputIterator, class Function>
+auto amgx_thrust_dispatch(InputIterator first, InputIterator last, Function f, std::true_type)
+{
+    return f(amgx_thrust_get_allocator<InputIterator>(std::true_type()));
+}
+
+template<class InputIterator, class Function>
+auto amgx_thrust_dispatch(InputIterator first, InputIterator last, Function f, std::false_type)
+{
+#ifdef AMGX_HOST_OPENMP
+    const size_t threshold = amgx::getHostParallelThreshold();
+
+    if (threshold > 0 && (size_t)(last - first) >= threshold)
     {
-        amgx::thrust::exclusive_scan(first, last, result);
+        return f(amgx::thrust::omp::par(amgx_thrust_host_allocator<InputIterator>()));
     }
 
+#endif
+    return f(amgx_thrust_get_allocator<InputIterator>(std::false_type()));
+}
+
+#define AMGX_THRUST_DISPATCH(MemSpace, first, last, call) \
+    amgx_thrust_dispatch(first, last, [&](auto policy) { return call; }, std::integral_constant<bool, MemSpace == AMGX_device>())
+
+namespace thrust_wrapper
+{
   template<int MemSpace, typename InputIterator, typename OutputIterator>
-    inline typename std::enable_if<MemSpace == AMGX_device, void>::type 
-    exclusive_scan(InputIterator first, InputIterator last, OutputIterator result)
+    inline void exclusive_scan(InputIterator first, InputIterator last, OutputIterator result)
     {
-        amgx::thrust::exclusive_scan(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, result);
+        AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::exclusive_scan(policy, first, last, result));
     }
 
   template<int MemSpace, typename InputIterator, typename OutputIterator, typename T>
     inline void exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init)
     {
-        amgx::thrust::exclusive_scan(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, result, init);
+        AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::exclusive_scan(policy, first, last, result, init));
     }
 
   template<int MemSpace, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename T, typename BinaryPredicate, typename AssociativeOperator>
@@ -67,89 +116,73 @@ namespace thrust_wrapper
   template<int MemSpace, typename InputIterator, typename OutputIterator>
     inline void inclusive_scan(InputIterator first, InputIterator last, OutputIterator result)
     {
-        amgx::thrust::inclusive_scan(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, result);
+        AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::inclusive_scan(policy, first, last, result));
     }
 
   template<int MemSpace, typename InputIterator, typename OutputIterator, typename AssociativeOperator>
     inline void inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, AssociativeOperator binary_op)
     {
-        amgx::thrust::inclusive_scan(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, result, binary_op);
+        AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::inclusive_scan(policy, first, last, result, binary_op));
     }
 
   template<int MemSpace, typename RandomAccessIterator>
     inline void sort(RandomAccessIterator first, RandomAccessIterator last)
     {
-        amgx::thrust::sort(amgx_thrust_get_allocator<RandomAccessIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last);
+        AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::sort(policy, first, last));
     }
 
   template<int MemSpace, typename RandomAccessIterator1, typename RandomAccessIterator2>
     inline void sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last, RandomAccessIterator2 values_first)
     {
-        amgx::thrust::sort_by_key(amgx_thrust_get_allocator<RandomAccessIterator1>(std::integral_constant<bool, MemSpace == AMGX_device>()), keys_first, keys_last, values_first);
+        AMGX_THRUST_DISPATCH(MemSpace, keys_first, keys_last, amgx::thrust::sort_by_key(policy, keys_first, keys_last, values_first));
     }
 
   template<int MemSpace, typename RandomAccessIterator1, typename RandomAccessIterator2>
     inline void stable_sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last, RandomAccessIterator2 values_first)
     {
-        amgx::thrust::stable_sort_by_key(amgx_thrust_get_allocator<RandomAccessIterator1>(std::integral_constant<bool, MemSpace == AMGX_device>()), keys_first, keys_last, values_first);
+        AMGX_THRUST_DISPATCH(MemSpace, keys_first, keys_last, amgx::thrust::stable_sort_by_key(policy, keys_first, keys_last, values_first));
     }
 
   template<int MemSpace, typename InputIterator>
     inline typename amgx::thrust::iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last)
     {
-        return amgx::thrust::reduce(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last);
+        return AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::reduce(policy, first, last));
     }
 
   template<int MemSpace, typename InputIterator, typename T, typename BinaryFunction>
     inline T reduce(InputIterator first, InputIterator last, T init, BinaryFunction binary_op)
     {
-        return amgx::thrust::reduce(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, init, binary_op);
+        return AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::reduce(policy, first, last, init, binary_op));
     }
 
   template<int MemSpace, typename InputIterator, typename OutputIterator, typename UnaryFunction>
-    inline typename std::enable_if<MemSpace == AMGX_host, OutputIterator>::type 
-    transform(InputIterator first, InputIterator last, OutputIterator result, UnaryFunction op)
-    {
-        return amgx::thrust::transform(first, last, result, op);
-    }
-
-  template<int MemSpace, typename InputIterator, typename OutputIterator, typename UnaryFunction>
-    inline typename std::enable_if<MemSpace == AMGX_device, OutputIterator>::type 
-    transform(InputIterator first, InputIterator last, OutputIterator result, UnaryFunction op)
-    {
-        return amgx::thrust::transform(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, result, op);
-    }
-
-  template<int MemSpace, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename UnaryFunction>
-    inline typename std::enable_if<MemSpace == AMGX_host, OutputIterator>::type 
-    transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, OutputIterator result, UnaryFunction op)
+    inline OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryFunction op)
     {
-        return amgx::thrust::transform(first1, last1, first2, result, op);
+        return AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::transform(policy, first, last, result, op));
     }
 
   template<int MemSpace, typename InputIterator1, typename InputIterator2, typename OutputIterator, typename UnaryFunction>
-    inline typename std::enable_if<MemSpace == AMGX_device, OutputIterator>::type 
-    transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, OutputIterator result, UnaryFunction op)
+    inline OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, OutputIterator result, UnaryFunction op)
     {
-        return amgx::thrust::transform(amgx_thrust_get_allocator<InputIterator1>(std::integral_constant<bool, MemSpace == AMGX_device>()), first1, last1, first2, result, op);
+        return AMGX_THRUST_DISPATCH(MemSpace, first1, last1, amgx::thrust::transform(policy, first1, last1, first2, result, op));
     }
 
   template<int MemSpace, typename InputIterator, typename OutputIterator, typename RandomAccessIterator>
     inline OutputIterator gather(InputIterator map_first, InputIterator map_last, RandomAccessIterator input_first, OutputIterator result)
     {
-        return amgx::thrust::gather(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), map_first, map_last, input_first, result);
+        return AMGX_THRUST_DISPATCH(MemSpace, map_first, map_last, amgx::thrust::gather(policy, map_first, map_last, input_first, result));
     }
 
   template<int MemSpace, typename InputIterator , typename UnaryFunction , typename OutputType , typename BinaryFunction >
     inline OutputType transform_reduce(InputIterator first, InputIterator last, UnaryFunction unary_op, OutputType init, BinaryFunction binary_op)
     {
-        return amgx::thrust::transform_reduce(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, unary_op, init, binary_op);
+        return AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::transform_reduce(policy, first, last, unary_op, init, binary_op));
     }
 
   template<int MemSpace, typename InputIterator, typename UnaryFunction>
     inline InputIterator for_each(InputIterator first, InputIterator last, UnaryFunction f)
     {
-        return amgx::thrust::for_each(amgx_thrust_get_allocator<InputIterator>(std::integral_constant<bool, MemSpace == AMGX_device>()), first, last, f);
+        return AMGX_THRUST_DISPATCH(MemSpace, first, last, amgx::thrust::for_each(policy, first, last, f));
     }
 
   template<int MemSpace, typename InputIterator , typename OutputIterator >
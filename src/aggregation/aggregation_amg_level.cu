@@ -25,6 +25,7 @@
 #include <iostream>
 #include <algorithm>
 #include <amgx_timer.h>
+#include <sm_utils.inl>
 
 #include <amgx_types/util.h>
 
@@ -152,6 +153,68 @@ void restrictResidualBlockDiaCsrKernel(const IndexType *row_offsets, const Index
     }
 }
 
+// Kernel computing the residual of the fine rows of each aggregate and restricting it in the same pass.
+// One warp per aggregate, split into groups of GROUP_SIZE lanes that each take one fine row at a time
+// and stride over its nonzeros, so neither large aggregates nor long rows serialize on one thread.
+template <typename IndexType, typename ValueTypeA, typename ValueTypeB, int CTA_SIZE, int GROUP_SIZE>
+__global__ __launch_bounds__(CTA_SIZE)
+void computeAndRestrictResidualKernel(const IndexType *R_row_offsets, const IndexType *R_column_indices, const IndexType *A_row_offsets, const IndexType *A_column_indices, const ValueTypeA *A_values, const ValueTypeB *b, const ValueTypeB *x, ValueTypeB *r, ValueTypeB *rr, const int num_aggregates)
+{
+    const int NUM_WARPS_PER_CTA = CTA_SIZE / 32;
+    const int NUM_GROUPS = 32 / GROUP_SIZE;
+    const int lane_id = utils::lane_id();
+    const int group_id = lane_id / GROUP_SIZE;
+    const int group_lane = lane_id % GROUP_SIZE;
+
+    // the loops are uniform over the warp, every lane takes part in the shuffles
+    for (int a = blockIdx.x * NUM_WARPS_PER_CTA + utils::warp_id(); a < num_aggregates; a += gridDim.x * NUM_WARPS_PER_CTA)
+    {
+        ValueTypeB temp(types::util<ValueTypeB>::get_zero());
+        const int aggregate_end = R_row_offsets[a + 1];
+
+        for (int k = R_row_offsets[a] + group_id; k - group_id < aggregate_end; k += NUM_GROUPS)
+        {
+            const bool active = k < aggregate_end;
+            const int i = active ? R_column_indices[k] : 0;
+            ValueTypeB Axi(types::util<ValueTypeB>::get_zero());
+
+            if (active)
+            {
+                for (int j = A_row_offsets[i] + group_lane; j < A_row_offsets[i + 1]; j += GROUP_SIZE)
+                {
+                    ValueTypeB aij;
+                    types::util<ValueTypeA>::to_uptype(A_values[j], aij);
+                    Axi = Axi + aij * x[A_column_indices[j]];
+                }
+            }
+
+#pragma unroll
+            for (int offset = GROUP_SIZE / 2; offset > 0; offset /= 2)
+            {
+                Axi = Axi + utils::shfl_xor(Axi, offset);
+            }
+
+            if (active && group_lane == 0)
+            {
+                ValueTypeB ri = b[i] - Axi;
+                r[i] = ri;
+                temp = temp + ri;
+            }
+        }
+
+#pragma unroll
+        for (int offset = 16; offset > 0; offset /= 2)
+        {
+            temp = temp + utils::shfl_xor(temp, offset);
+        }
+
+        if (lane_id == 0)
+        {
+            rr[a] = temp;
+        }
+    }
+}
+
 // Kernel to prolongate and apply the correction for csr format
 template <typename IndexType, typename ValueType>
 __global__
@@ -425,6 +488,69 @@ void Aggregation_AMG_Level<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_ind
     }
 }
 
+// Method to compute and restrict the residual on host in one pass over the aggregates
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void Aggregation_AMG_Level<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::computeAndRestrictResidual_1x1(const VVector &b, const VVector &x, VVector &r, VVector &rr)
+{
+    const Matrix<TConfig> &A = *this->A;
+
+    for (int a = 0; a < this->m_num_aggregates; a++)
+    {
+        ValueTypeB temp(types::util<ValueTypeB>::get_zero());
+
+        for (int k = this->m_R_row_offsets[a]; k < this->m_R_row_offsets[a + 1]; k++)
+        {
+            int i = this->m_R_column_indices[k];
+            ValueTypeB Axi(types::util<ValueTypeB>::get_zero());
+
+            for (int j = A.row_offsets[i]; j < A.row_offsets[i + 1]; j++)
+            {
+                ValueTypeB aij;
+                types::util<ValueTypeA>::to_uptype(A.values[j], aij);
+                Axi = Axi + aij * x[A.col_indices[j]];
+            }
+
+            r[i] = b[i] - Axi;
+            temp = temp + r[i];
+        }
+
+        rr[a] = temp;
+    }
+}
+
+// Method to compute and restrict the residual on device in one pass over the aggregates
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void Aggregation_AMG_Level<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::computeAndRestrictResidual_1x1(const VVector &b, const VVector &x, VVector &r, VVector &rr)
+{
+    const Matrix<TConfig> &A = *this->A;
+    const int CTA_SIZE = 128;
+    const int num_blocks = std::min( AMGX_GRID_MAX_SIZE, this->m_num_aggregates / (CTA_SIZE / 32) + 1 );
+    // lanes per fine row from the mean row length, a 7-point stencil gets groups of 8
+    const int mean_row_length = A.get_num_rows() > 0 ? A.get_num_nz() / A.get_num_rows() : 0;
+#define AMGX_FUSED_RESIDUAL_LAUNCH(GROUP_SIZE) \
+    computeAndRestrictResidualKernel<IndexType, ValueTypeA, ValueTypeB, CTA_SIZE, GROUP_SIZE> <<< num_blocks, CTA_SIZE>>>(this->m_R_row_offsets.raw(), this->m_R_column_indices.raw(), A.row_offsets.raw(), A.col_indices.raw(), A.values.raw(), b.raw(), x.raw(), r.raw(), rr.raw(), this->m_num_aggregates)
+
+    if (mean_row_length <= 4)
+    {
+        AMGX_FUSED_RESIDUAL_LAUNCH(4);
+    }
+    else if (mean_row_length <= 8)
+    {
+        AMGX_FUSED_RESIDUAL_LAUNCH(8);
+    }
+    else if (mean_row_length <= 16)
+    {
+        AMGX_FUSED_RESIDUAL_LAUNCH(16);
+    }
+    else
+    {
+        AMGX_FUSED_RESIDUAL_LAUNCH(32);
+    }
+
+#undef AMGX_FUSED_RESIDUAL_LAUNCH
+    cudaCheckError();
+}
+
 // Method to restrict Residual on device using csr_matrix format
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void Aggregation_AMG_Level<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::restrictResidual_1x1(const VVector &r, VVector &rr)
@@ -899,6 +1025,37 @@ void Aggregation_AMG_Level_Base<T_Config>::restrictResidual(VVector &r, VVector
     }
 }
 
+// The fused kernels read x without a halo exchange and only handle scalar CSR matrices without an
+// external diagonal, so they are limited to single GPU levels.
+template <class T_Config>
+bool Aggregation_AMG_Level_Base<T_Config>::computeAndRestrictResidual(const VVector &b, const VVector &x, VVector &r, VVector &rr)
+{
+    if (this->A->get_block_size() != 1 || this->A->hasProps(DIAG) || !this->A->is_matrix_singleGPU() || this->isConsolidationLevel())
+    {
+        return false;
+    }
+
+    computeAndRestrictResidual_1x1(b, x, r, rr);
+    return true;
+}
+
+template <class T_Config>
+bool Aggregation_AMG_Level_Base<T_Config>::prolongateAndSmooth(VVector &e, VVector &b, VVector &x, Solver<TConfig> *smoother)
+{
+    if (this->m_error_scaling != 0 || this->A->get_block_size() != 1 || this->A->hasProps(DIAG) || !this->A->is_matrix_singleGPU() || this->isConsolidationLevel())
+    {
+        return false;
+    }
+
+    if (!smoother->smooth_with_correction(b, x, e, this->m_aggregates))
+    {
+        return false;
+    }
+
+    x.dirtybit = 1;
+    return true;
+}
+
 template <class T_Config>
 void Aggregation_AMG_Level_Base<T_Config>::computeRestrictionOperator()
 {
@@ -1941,6 +2098,74 @@ void Aggregation_AMG_Level_Base<T_Config>::createCoarseVertices()
     this->getA().template setParameter< int > ("aggregates_num", this->m_num_aggregates); // ptr to aaggregates
 }
 
+// Layout: num_rows, num_aggregates, size of the aggregates array, size of the fine index array,
+// followed by both arrays. Only single-GPU levels are supported, distributed levels depend on the
+// halo numbering of the neighbours.
+template <class T_Config>
+bool Aggregation_AMG_Level_Base<T_Config>::exportCoarseStructure(std::vector<int> &structure)
+{
+    if (!this->getA().is_matrix_singleGPU())
+    {
+        return false;
+    }
+
+    IVector_h aggregates = this->m_aggregates;
+    IVector_h aggregates_fine_idx = this->m_aggregates_fine_idx;
+    structure.resize(4 + aggregates.size() + aggregates_fine_idx.size());
+    structure[0] = this->getA().get_num_rows();
+    structure[1] = this->m_num_aggregates;
+    structure[2] = aggregates.size();
+    structure[3] = aggregates_fine_idx.size();
+    std::copy(aggregates.begin(), aggregates.end(), structure.begin() + 4);
+    std::copy(aggregates_fine_idx.begin(), aggregates_fine_idx.end(), structure.begin() + 4 + aggregates.size());
+    return true;
+}
+
+// Rejects a structure that does not match this level, or whose aggregate indices are out of
+// range, the level is then coarsened again.
+template <class T_Config>
+bool Aggregation_AMG_Level_Base<T_Config>::importCoarseStructure(const std::vector<int> &structure)
+{
+    const int num_rows = this->getA().get_num_rows();
+
+    if (!this->getA().is_matrix_singleGPU() || structure.size() < 4 || structure[0] != num_rows ||
+            structure[1] < 0 || structure[1] > num_rows || structure[2] != num_rows || structure[3] < 0 ||
+            structure.size() != 4 + (size_t)structure[2] + (size_t)structure[3])
+    {
+        return false;
+    }
+
+    const int num_aggregates = structure[1];
+
+    for (size_t i = 4; i < structure.size(); i++)
+    {
+        if (structure[i] < 0 || structure[i] >= num_aggregates)
+        {
+            return false;
+        }
+    }
+
+    IVector_h aggregates(structure[2]);
+    IVector_h aggregates_fine_idx(structure[3]);
+    std::copy(structure.begin() + 4, structure.begin() + 4 + structure[2], aggregates.begin());
+    std::copy(structure.begin() + 4 + structure[2], structure.end(), aggregates_fine_idx.begin());
+    this->m_num_aggregates = structure[1];
+    this->m_aggregates.copy(aggregates);
+    this->m_aggregates_fine_idx.copy(aggregates_fine_idx);
+    this->getA().template setParameter< int > ("aggregates_num", this->m_num_aggregates);
+    return true;
+}
+
+template <class T_Config>
+void Aggregation_AMG_Level_Base<T_Config>::computeDiagnostics(LevelDiagnostics &d, bool rate_aggregates)
+{
+    MatrixAnalysis<TConfig> ana(&this->getA());
+    ana.aggregateDiagnostics(this->m_aggregates, this->m_num_aggregates, rate_aggregates, d);
+    // piecewise constant interpolation
+    d.interp_min_row_length = d.interp_max_row_length = 1;
+    d.interp_avg_row_length = 1.;
+}
+
 //  Creating the next level
 template <class T_Config>
 void Aggregation_AMG_Level_Base<T_Config>::createCoarseMatrices()
@@ -1977,6 +2202,7 @@ void Aggregation_AMG_Level_Base<T_Config>::createCoarseMatrices()
     // If we reuse the level we keep the previous restriction operator
     if (this->isReuseLevel() == false)
     {
+        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, this->getLevelIndex());
         computeRestrictionOperator();
     }
 
@@ -25,7 +25,10 @@
 #include <cassert>
 #include <csr_multiply.h>
 #include <memory_info.h>
+#include <thrust_wrapper.h>
+#include <chrono>
 
+#include <thrust/copy.h>
 #include <thrust/sort.h>
 #include <thrust/remove.h>
 #include <thrust/unique.h>
@@ -52,6 +55,7 @@ AMG<t_vecPrec, t_matPrec, t_indPrec>
     m_sum_stopping_criteria = cfg.getParameter<int>("use_sum_stopping_criteria", cfg_scope);
     m_structure_reuse_levels = cfg.getParameter<int>("structure_reuse_levels", cfg_scope);
     m_amg_host_levels_rows = cfg.getParameter<int>("amg_host_levels_rows", cfg_scope);
+    m_amg_host_levels_auto = cfg.getParameter<int>("amg_host_levels_auto", cfg_scope);
 
     if (m_consolidation_upper_threshold <= m_consolidation_lower_threshold)
     {
@@ -143,6 +147,73 @@ AMG<t_vecPrec, t_matPrec, t_indPrec>::~AMG()
 
 void analyze_coloring(device_vector_alloc<int> aggregates_d, device_vector_alloc<int> colors_d);
 
+namespace
+{
+
+// Wall clock seconds per call of op, averaged over a few calls after a warm-up. The device is
+// synchronized around the calls so both memory spaces are timed alike.
+template <class Op>
+double seconds_per_call(Op op)
+{
+    const int num_calls = 5;
+    op();
+    cudaDeviceSynchronize();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < num_calls; i++)
+    {
+        op();
+    }
+
+    cudaDeviceSynchronize();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / num_calls;
+}
+
+// Cost of one visit of a level by the cycle: the smoothing sweeps plus the residual and the
+// grid transfers, counted as two products with A. Levels that are not smoothed (the coarsest
+// level when a coarse solver is used) are charged one product per sweep.
+template <class TConfig>
+double level_visit_cost(AMG_Level<TConfig> *level, int sweeps, bool smoothed)
+{
+    typedef typename TConfig::VecPrec ValueTypeB;
+    Matrix<TConfig> &A = level->getA();
+    int N = A.get_num_cols() * A.get_block_dimy();
+    Vector<TConfig> b(N), x(N), y(N);
+    b.set_block_dimy(A.get_block_dimy());
+    b.set_block_dimx(1);
+    x.set_block_dimy(A.get_block_dimy());
+    x.set_block_dimx(1);
+    y.set_block_dimy(A.get_block_dimy());
+    y.set_block_dimx(1);
+    thrust_wrapper::fill<TConfig::memSpace>(b.begin(), b.end(), types::util<ValueTypeB>::get_one());
+    thrust_wrapper::fill<TConfig::memSpace>(x.begin(), x.end(), types::util<ValueTypeB>::get_zero());
+    double spmv = seconds_per_call([&]() { multiply(A, x, y); });
+    double sweep = spmv;
+
+    if (smoothed)
+    {
+        Solver<TConfig> *smoother = level->getSmoother();
+        smoother->set_max_iters(1);
+        smoother->setTolerance(0.);
+        sweep = seconds_per_call([&]() { smoother->solve(b, x, false); });
+    }
+
+    return sweeps * sweep + 2 * spmv;
+}
+
+// Cost of moving the residual of a level to the other memory space and its correction back.
+template <class TConfig0, class TConfig1>
+double vector_transfer_cost(Matrix<TConfig0> &A)
+{
+    int N = A.get_num_rows() * A.get_block_dimy();
+    Vector<TConfig0> v(N);
+    Vector<TConfig1> w(N);
+    return seconds_per_call([&]() { amgx::thrust::copy(v.begin(), v.end(), w.begin()); })
+           + seconds_per_call([&]() { amgx::thrust::copy(w.begin(), w.end(), v.begin()); });
+}
+
+} // end anonymous namespace
+
 template< AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec >
 class AMG_Setup
 {
@@ -267,7 +338,15 @@ class AMG_Setup
                     // only compute aggregates if we can't reuse existing ones
                     if (!reuse_next_level)
                     {
-                        level->createCoarseVertices( );
+                        const int level_index = level->getLevelIndex();
+                        bool imported = level_index < amg->m_imported_structure.size() &&
+                                        level->importCoarseStructure(amg->m_imported_structure[level_index]);
+
+                        if (!imported)
+                        {
+                            amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, level_index);
+                            level->createCoarseVertices( );
+                        }
                     }
                 }
                 //set the amg_level_index for this matrix
@@ -364,7 +443,11 @@ class AMG_Setup
                 // stop here if next level size is < min_rows
                 if ( nextN <= amg->coarsen_threshold * N && nextN != N && min_partition_rows >= min_rows )
                 {
-                    level->createCoarseMatrices();
+                    {
+                        // the coarse matrix belongs to the next level, the transfer operators are retagged by the levels
+                        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_MATRIX, level->getLevelIndex() + 1);
+                        level->createCoarseMatrices();
+                    }
                     // Resize coarse vectors.
                     int nextSize = level->getNextLevelSize();
                     level->getxc( ).resize( nextSize );
@@ -649,7 +732,10 @@ class AMG_Setup
                     task_setupsmoother_->level = level;
                     task_setupsmoother_->coarseSolverExists = coarseSolverExists;
                     // create the aggregates (aggregation) or coarse points (classical)
-                    level->createCoarseVertices( );
+                    {
+                        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, level->getLevelIndex());
+                        level->createCoarseVertices( );
+                    }
                     enqueue_async(asyncmanager::singleton()->main_thread_queue(0), task_setupsmoother_);
                 }
                 else
@@ -658,6 +744,7 @@ class AMG_Setup
                     // only compute aggregates if we can't reuse existing ones
                     if (!reuse_next_level)
                     {
+                        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, level->getLevelIndex());
                         level->createCoarseVertices( );
                     }
                 }
@@ -731,7 +818,11 @@ class AMG_Setup
                 // stop here if next level size is < min_rows
                 if ( nextN <= amg->coarsen_threshold * N && nextN != N && min_partition_rows >= min_rows )
                 {
-                    level->createCoarseMatrices();
+                    {
+                        // the coarse matrix belongs to the next level, the transfer operators are retagged by the levels
+                        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_MATRIX, level->getLevelIndex() + 1);
+                        level->createCoarseMatrices();
+                    }
                     // Resize coarse vectors.
                     int nextSize = level->getNextLevelSize();
                     level->getxc( ).resize( nextSize );
@@ -856,6 +947,107 @@ class AMG_Setup
 #endif
         }
 
+        // Selects the levels to move to the other memory space with the cycle cost model of
+        // amg_host_levels_auto. Levels are timed on both memory spaces from the coarsest one up
+        // until a level runs faster where it is, since larger levels only favour it further. The
+        // moved levels are the tail of the hierarchy with the cheapest cycle, the transfer of the
+        // vectors at its first level included. Returns that level, or NULL to keep all of them,
+        // and the copies of the moved levels, finest first and set up, in moved_levels.
+        template< typename TConfig0, typename TConfig1 >
+        static
+        AMG_Level<TConfig0> *
+        selectMovedLevels( AMG<t_vecPrec, t_matPrec, t_indPrec> *amg, std::vector<AMG_Level<TConfig1> *> &moved_levels )
+        {
+            typedef typename MemorySpaceMap<TConfig0::memSpace>::Type MemorySpace0;
+            MemorySpace0 memorySpaceTag0;
+            std::vector<AMG_Level<TConfig0> *> levels;
+            amg->m_level_placement.clear();
+
+            for (AMG_Level<TConfig0> *level = amg->getFinestLevel(memorySpaceTag0); level != NULL; level = level->getNextLevel(memorySpaceTag0))
+            {
+                // the vectors of distributed levels cannot be moved
+                if (!level->getA().is_matrix_singleGPU())
+                {
+                    return NULL;
+                }
+
+                levels.push_back(level);
+            }
+
+            int num_levels = static_cast<int>(levels.size());
+            int sweeps = std::max(amg->getNumPresweeps() + amg->getNumPostsweeps(), 1);
+            bool coarse_solver = amg->getCoarseSolver(memorySpaceTag0) != NULL;
+            std::vector<double> cost0(num_levels), cost1(num_levels), transfer(num_levels);
+            std::vector<AMG_Level<TConfig1> *> copies(num_levels, NULL);
+            int first_timed = num_levels;
+
+            // the finest level stays with the solution vectors
+            for (int i = num_levels - 1; i > 0; i--)
+            {
+                bool smoothed = !levels[i]->isCoarsest() || !coarse_solver;
+                AMG_Level<TConfig1> *copy = AMG_LevelFactory<TConfig1>::allocate(amg, amg->tmng);
+                copy->transfer_from(levels[i]);
+                copy->setup();
+
+                if (smoothed)
+                {
+                    copy->setup_smoother();
+                }
+
+                if (amg->tmng != NULL)
+                {
+                    amg->tmng->wait_threads();
+                }
+
+                copies[i] = copy;
+                cost0[i] = level_visit_cost(levels[i], sweeps, smoothed);
+                cost1[i] = level_visit_cost(copy, sweeps, smoothed);
+                transfer[i] = vector_transfer_cost<TConfig0, TConfig1>(levels[i]->getA());
+                first_timed = i;
+
+                if (cost1[i] > cost0[i])
+                {
+                    break;
+                }
+            }
+
+            int first_moved = num_levels;
+            double tail_gain = 0., best_gain = 0.;
+
+            for (int i = num_levels - 1; i >= first_timed; i--)
+            {
+                tail_gain += cost0[i] - cost1[i];
+
+                if (tail_gain - transfer[i] > best_gain)
+                {
+                    best_gain = tail_gain - transfer[i];
+                    first_moved = i;
+                }
+            }
+
+            for (int i = first_timed; i < num_levels; i++)
+            {
+                typename AMG<t_vecPrec, t_matPrec, t_indPrec>::LevelPlacement placement;
+                placement.level = levels[i]->getLevelIndex();
+                placement.device_time = TConfig0::memSpace == AMGX_device ? cost0[i] : cost1[i];
+                placement.host_time = TConfig0::memSpace == AMGX_device ? cost1[i] : cost0[i];
+                placement.transfer_time = transfer[i];
+                placement.on_host = (i >= first_moved) == (TConfig0::memSpace == AMGX_device);
+                amg->m_level_placement.push_back(placement);
+
+                if (i >= first_moved)
+                {
+                    moved_levels.push_back(copies[i]);
+                }
+                else
+                {
+                    delete copies[i];
+                }
+            }
+
+            return first_moved < num_levels ? levels[first_moved] : NULL;
+        }
+
         template< typename TConfig0, AMGX_MemorySpace MemSpace0, AMGX_MemorySpace MemSpace1 >
         static
         void
@@ -1003,16 +1195,27 @@ class AMG_Setup
             // Used only for device modes without hybrid mode. After reaching level where numrows <= amg_host_levels_rows
             // it creates copy of the hierarchy starting with this level.
             // This is experimental feauture intended to measure scaling of the solve part when coarse levels are on the host.
-            if (amg->m_amg_host_levels_rows > 0)
+            // With amg_host_levels_auto the first level to copy is chosen by the cycle cost model instead.
+            bool auto_host_levels = amg->m_amg_host_levels_auto && MemSpace0 == AMGX_device;
+            std::vector<AMG_Level<TConfig1> *> moved_levels;
+            AMG_Level<TConfig0> *first_moved_lvl = NULL;
+
+            if (auto_host_levels)
+            {
+                first_moved_lvl = selectMovedLevels<TConfig0, TConfig1>( amg, moved_levels );
+            }
+
+            if ((auto_host_levels && first_moved_lvl != NULL) || (!auto_host_levels && amg->m_amg_host_levels_rows > 0))
             {
                 AMG_Level<TConfig0> *d_cur_lvl = amg->getFinestLevel(memorySpaceTag0);
                 AMG_Level<TConfig1> *h_cur_lvl = NULL, *h_prev_lvl = NULL;
                 AMG_Level<TConfig0> *last_dev_lvl = NULL;
                 AMG_Level<TConfig1> *first_host_lvl = NULL;
+                size_t moved = 0;
 
                 while (d_cur_lvl != NULL)
                 {
-                    if (d_cur_lvl->getNumRows() <= amg->m_amg_host_levels_rows)
+                    if (auto_host_levels ? d_cur_lvl == first_moved_lvl : d_cur_lvl->getNumRows() <= amg->m_amg_host_levels_rows)
                     {
                         break;
                     }
@@ -1025,9 +1228,17 @@ class AMG_Setup
                 {
                     while (d_cur_lvl != NULL)
                     {
-                        h_cur_lvl = AMG_LevelFactory<TConfig1>::allocate(amg, amg->tmng);
-                        h_cur_lvl->transfer_from(d_cur_lvl);
-                        h_cur_lvl->setup();
+                        if (auto_host_levels)
+                        {
+                            // already copied and set up while timing
+                            h_cur_lvl = moved_levels[moved++];
+                        }
+                        else
+                        {
+                            h_cur_lvl = AMG_LevelFactory<TConfig1>::allocate(amg, amg->tmng);
+                            h_cur_lvl->transfer_from(d_cur_lvl);
+                            h_cur_lvl->setup();
+                        }
 
                         if (amg->getCoarseSolver(memorySpaceTag0) != NULL)
                         {
@@ -1043,7 +1254,7 @@ class AMG_Setup
                                 FatalError("Need to recrreate coarse solver got the host", AMGX_ERR_NOT_IMPLEMENTED);
                             }
                         }
-                        else
+                        else if (!auto_host_levels)
                         {
                             h_cur_lvl->setup_smoother();
                         }
@@ -1127,6 +1338,8 @@ void AMG<t_vecPrec, t_matPrec, t_indPrec>::setup( Matrix_h &A )
     // this allows fine control over the reuse of hierarchies if setup/solve is called multiple times
     m_structure_reuse_levels = m_cfg->getParameter<int>("structure_reuse_levels", m_cfg_scope);
     AMG_Setup<t_vecPrec, t_matPrec, t_indPrec>::template setup<TConfig_h, AMGX_host, AMGX_device>( this, A );
+    // an imported structure applies to the setup following the import only
+    m_imported_structure.clear();
 
     // Don't need the workspace anymore
     if ( d2_workspace != NULL && d2_workspace != csr_workspace )
@@ -1156,6 +1369,8 @@ void AMG<t_vecPrec, t_matPrec, t_indPrec>::setup( Matrix_d &A )
     // this allows fine control over the reuse of hierarchies if setup/solve is called multiple times
     m_structure_reuse_levels = m_cfg->getParameter<int>("structure_reuse_levels", m_cfg_scope);
     AMG_Setup<t_vecPrec, t_matPrec, t_indPrec>::template setup<TConfig_d, AMGX_device, AMGX_host>( this, A );
+    // an imported structure applies to the setup following the import only
+    m_imported_structure.clear();
 
     // Don't need the workspace anymore
     if ( d2_workspace != NULL && d2_workspace != csr_workspace )
@@ -1226,8 +1441,8 @@ AMG<t_vecPrec, t_matPrec, t_indPrec>::solve_iteration( Vector_h &b, Vector_h &x)
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void AMG<t_vecPrec, t_matPrec, t_indPrec>::getGridStatisticsString(std::stringstream &ss)
 {
-    AMG_Level<TConfig_d> *level_d = this->fine_d;
-    AMG_Level<TConfig_h> *level_h = this->fine_h;
+    std::vector<LevelSize> sizes;
+    getLevelSizes(sizes, true);
     int64_t total_rows = 0;
     int64_t total_nnz = 0;
     float total_size = 0;
@@ -1241,107 +1456,90 @@ void AMG<t_vecPrec, t_matPrec, t_indPrec>::getGridStatisticsString(std::stringst
        << std::setw(15) << "Mem (GB)" << std::endl;
     ss << "        ----------------------------------------------------------------------\n";
 
-    while (level_d != NULL)
+    for (size_t i = 0; i < sizes.size(); i++)
     {
-        int has_diag = level_d->getA( ).hasProps(DIAG) ? 1 : 0;
-        int64_t num_rows = (int)(level_d->getA( ).get_num_rows() * level_d->getA( ).get_block_dimy());
-        int64_t nnz = (int)((level_d->getA( ).get_num_nz()
-                             + has_diag * level_d->getA( ).get_num_rows()) * level_d->getA( ).get_block_dimy()
-                            * level_d->getA( ).get_block_dimx());
-        int64_t num_parts = level_d->getA().is_matrix_singleGPU() ? 1 : level_d->getA().manager->getComms()->get_num_partitions();
-        float size = level_d->bytes(true) / 1024.0 / 1024 / 1024;
-
-        // If aggregation AMG, skip this if # of neighbors = 0, since we're consolidating
-        // If classical AMG, we need to enter here since ranks are allowed to have 0 rows (or no neighbors)
-        if ( !level_d->getA().is_matrix_singleGPU() ||
-                (level_d->isClassicalAMGLevel() && level_d->getA().is_matrix_distributed()) )
-        {
-            level_d->getA().manager->global_reduce_sum(&num_rows);
-            level_d->getA().manager->global_reduce_sum(&nnz);
-            level_d->getA().manager->global_reduce_sum(&size);
-        }
-
-        total_rows += num_rows;
-        total_nnz += nnz;
-        total_size += size;
-        double sparsity = nnz / (double) ( num_rows * num_rows);
-        ss  << std::setw(12) << level_d->getLevelIndex( ) << "(D)"
-            << std::setw(13) << num_rows
-            << std::setw(18) << nnz
-            << std::setw(7) << num_parts
+        const LevelSize &l = sizes[i];
+        total_rows += l.rows;
+        total_nnz += l.nnz;
+        total_size += l.memory_gb;
+        double sparsity = l.nnz / (double) ( l.rows * l.rows);
+        ss  << std::setw(12) << l.level << (l.on_host ? "(H)" : "(D)")
+            << std::setw(13) << l.rows
+            << std::setw(18) << l.nnz
+            << std::setw(7) << l.parts
             << std::setw(10) << std::setprecision(3) << sparsity
-            << std::setw(15) << size
+            << std::setw(15) << l.memory_gb
             << std::setprecision(6) << std::endl;
-        level_d = level_d->getNextLevel( device_memory( ) );
     }
 
-    while (level_h != NULL)
+    const int64_t fine_rows = sizes.empty() ? 0 : sizes[0].rows;
+    const int64_t fine_nnz = sizes.empty() ? 0 : sizes[0].nnz;
+    ss << "         ----------------------------------------------------------------------\n";
+    ss << "         Grid Complexity: " << total_rows / (double) fine_rows << std::endl;
+    ss << "         Operator Complexity: " << total_nnz / (double) fine_nnz << std::endl;
+    ss << "         Total Memory Usage: " << total_size << " GB" << std::endl;
+    ss << "         ----------------------------------------------------------------------\n";
+
+    if (!m_level_placement.empty())
     {
-        int has_diag = level_h->getA( ).hasProps(DIAG) ? 1 : 0;
-        int64_t num_rows = (int)(level_h->getA( ).get_num_rows() * level_h->getA( ).get_block_dimy());
-        int64_t nnz = (int)((level_h->getA( ).get_num_nz()
-                             + has_diag * level_h->getA( ).get_num_rows()) * level_h->getA( ).get_block_dimy()
-                            * level_h->getA( ).get_block_dimx());
-        float size = level_h->bytes(true) / 1024.0 / 1024 / 1024;
-
-        // If aggregation AMG, skip this if # of neighbors = 0, since we're consolidating
-        // If classical AMG, we need to enter here since ranks are allowed to have 0 rows (or no neighbors)
-        if ( !level_h->getA().is_matrix_singleGPU() ||
-                (level_h->isClassicalAMGLevel() && level_h->getA().is_matrix_distributed()) )
+        ss << "Level Placement (cycle cost per visit, ms):\n";
+        ss << std::setw(15) << "LVL"
+           << std::setw(13) << "DEVICE"
+           << std::setw(13) << "HOST"
+           << std::setw(13) << "TRANSFER"
+           << std::setw(10) << "PLACED" << std::endl;
+        ss << "        ----------------------------------------------------------------------\n";
+
+        for (size_t i = 0; i < m_level_placement.size(); i++)
         {
-            level_h->getA().manager->global_reduce_sum(&num_rows);
-            level_h->getA().manager->global_reduce_sum(&nnz);
-            level_h->getA().manager->global_reduce_sum(&size);
+            ss << std::setw(15) << m_level_placement[i].level
+               << std::setw(13) << std::setprecision(3) << 1e3 * m_level_placement[i].device_time
+               << std::setw(13) << 1e3 * m_level_placement[i].host_time
+               << std::setw(13) << 1e3 * m_level_placement[i].transfer_time
+               << std::setw(10) << (m_level_placement[i].on_host ? "host" : "device")
+               << std::setprecision(6) << std::endl;
         }
 
-        total_rows += num_rows;
-        total_nnz += nnz;
-        total_size += size;
-        double sparsity = nnz / (double) ( num_rows * num_rows);
-        ss  << std::setw(12) << level_h->getLevelIndex( ) << "(H)"
-            << std::setw(13) << num_rows
-            << std::setw(18) << nnz
-            << std::setw(10) << std::setprecision(3) << sparsity
-            << std::setw(15) << size
-            << std::setprecision(6) << std::endl;
-        level_h = level_h->getNextLevel( host_memory( ) );
+        ss << "         ----------------------------------------------------------------------\n";
     }
 
-    int64_t fine_rows;
-    int64_t fine_nnz;
-
-    if (this->fine_h)
+    if (amgx::memory::getMemoryAccounting())
     {
-        fine_rows = this->fine_h->getA( ).get_num_rows()   * this->fine_h->getA( ).get_block_dimy();
-        fine_nnz  = this->fine_h->getA( ).get_block_dimy() * this->fine_h->getA( ).get_block_dimx()
-                    * ( this->fine_h->getA( ).get_num_nz()
-                        + (this->fine_h->getA( ).hasProps(DIAG) ? this->fine_h->getA( ).get_num_rows() : 0) ) ;
-
-        if (this->fine_h->getA().is_matrix_distributed())
+        std::vector<amgx::memory::MemoryReportEntry> entries;
+        size_t device_peak, pinned_peak;
+        amgx::memory::getMemoryReport(amgx::memory::getMemoryOwner(), entries, device_peak, pinned_peak);
+        const double GB = 1024.0 * 1024 * 1024;
+        ss << "Memory Accounting:\n";
+        ss << std::setw(15) << "SPACE"
+           << std::setw(12) << "SUBSYSTEM"
+           << std::setw(7) << "LVL"
+           << std::setw(18) << "Current (GB)"
+           << std::setw(15) << "Peak (GB)" << std::endl;
+        ss << "        ----------------------------------------------------------------------\n";
+
+        for (size_t i = 0; i < entries.size(); i++)
         {
-            this->fine_h->getA().manager->global_reduce_sum(&fine_rows);
-            this->fine_h->getA().manager->global_reduce_sum(&fine_nnz);
-        }
-    }
-    else
-    {
-        fine_rows = this->fine_d->getA( ).get_num_rows()   * this->fine_d->getA( ).get_block_dimy() ;
-        fine_nnz  = this->fine_d->getA( ).get_block_dimy() * this->fine_d->getA( ).get_block_dimx()
-                    * ( this->fine_d->getA( ).get_num_nz()
-                        + (this->fine_d->getA( ).hasProps(DIAG) ? this->fine_d->getA( ).get_num_rows() : 0) );
+            ss << std::setw(15) << (entries[i].device ? "device" : "pinned")
+               << std::setw(12) << amgx::memory::getMemoryTagName(entries[i].tag);
 
-        if (this->fine_d->getA().is_matrix_distributed())
-        {
-            this->fine_d->getA().manager->global_reduce_sum(&fine_rows);
-            this->fine_d->getA().manager->global_reduce_sum(&fine_nnz);
+            if (entries[i].level < 0)
+            {
+                ss << std::setw(7) << "-";
+            }
+            else
+            {
+                ss << std::setw(7) << entries[i].level;
+            }
+
+            ss << std::setw(18) << entries[i].current_bytes / GB
+               << std::setw(15) << entries[i].peak_bytes / GB << std::endl;
         }
-    }
 
-    ss << "         ----------------------------------------------------------------------\n";
-    ss << "         Grid Complexity: " << total_rows / (double) fine_rows << std::endl;
-    ss << "         Operator Complexity: " << total_nnz / (double) fine_nnz << std::endl;
-    ss << "         Total Memory Usage: " << total_size << " GB" << std::endl;
-    ss << "         ----------------------------------------------------------------------\n";
+        ss << "         ----------------------------------------------------------------------\n";
+        ss << "         Peak Device Memory: " << device_peak / GB << " GB" << std::endl;
+        ss << "         Peak Pinned Host Memory: " << pinned_peak / GB << " GB" << std::endl;
+        ss << "         ----------------------------------------------------------------------\n";
+    }
 }
 
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
@@ -1413,6 +1611,158 @@ void printLine(const int l, const int s)
     amgx_output(ss.str().c_str(), static_cast<int>(ss.str().length()));
 }
 
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void AMG<t_vecPrec, t_matPrec, t_indPrec>::exportCoarseStructure(std::vector<std::vector<int> > &structure)
+{
+    structure.clear();
+    AMG_Level<TConfig_d> *level_d = fine_d;
+
+    while ( level_d != NULL && !level_d->isCoarsest() )
+    {
+        structure.push_back(std::vector<int>());
+
+        if (!level_d->exportCoarseStructure(structure.back()))
+        {
+            structure.back().clear();
+        }
+
+        level_d = level_d->next_d;
+    }
+
+    AMG_Level<TConfig_h> *level_h = fine_h;
+
+    while ( level_h != NULL && !level_h->isCoarsest() )
+    {
+        structure.push_back(std::vector<int>());
+
+        if (!level_h->exportCoarseStructure(structure.back()))
+        {
+            structure.back().clear();
+        }
+
+        level_h = level_h->next_h;
+    }
+}
+
+// size of one level summed over the ranks
+template <class Level, class LevelSize>
+static void appendLevelSize(Level *level, bool on_host, bool with_memory, std::vector<LevelSize> &sizes)
+{
+    LevelSize s;
+    const int has_diag = level->getA().hasProps(DIAG) ? 1 : 0;
+    s.level = level->getLevelIndex();
+    s.on_host = on_host;
+    s.rows = (int64_t)level->getA().get_num_rows() * level->getA().get_block_dimy();
+    s.nnz = ((int64_t)level->getA().get_num_nz() + has_diag * level->getA().get_num_rows())
+            * level->getA().get_block_dimy() * level->getA().get_block_dimx();
+    s.parts = level->getA().is_matrix_singleGPU() ? 1 : level->getA().manager->getComms()->get_num_partitions();
+    s.memory_gb = with_memory ? level->bytes(true) / 1024.0 / 1024 / 1024 : 0.f;
+
+    // If aggregation AMG, skip this if # of neighbors = 0, since we're consolidating
+    // If classical AMG, we need to enter here since ranks are allowed to have 0 rows (or no neighbors)
+    if ( !level->getA().is_matrix_singleGPU() ||
+            (level->isClassicalAMGLevel() && level->getA().is_matrix_distributed()) )
+    {
+        level->getA().manager->global_reduce_sum(&s.rows);
+        level->getA().manager->global_reduce_sum(&s.nnz);
+
+        if (with_memory)
+        {
+            level->getA().manager->global_reduce_sum(&s.memory_gb);
+        }
+    }
+
+    sizes.push_back(s);
+}
+
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void AMG<t_vecPrec, t_matPrec, t_indPrec>::getLevelSizes(std::vector<LevelSize> &sizes, bool with_memory)
+{
+    sizes.clear();
+
+    for (AMG_Level<TConfig_d> *level_d = fine_d; level_d != NULL; level_d = level_d->getNextLevel( device_memory( ) ))
+    {
+        appendLevelSize(level_d, false, with_memory, sizes);
+    }
+
+    for (AMG_Level<TConfig_h> *level_h = fine_h; level_h != NULL; level_h = level_h->getNextLevel( host_memory( ) ))
+    {
+        appendLevelSize(level_h, true, with_memory, sizes);
+    }
+}
+
+// sizes of one level for the diagnostics, the level adds the metrics of its coarse-grid construction
+template <class Level>
+static void levelDiagnostics(Level *level, bool on_host, bool rate_aggregates, std::vector<LevelDiagnostics> &levels)
+{
+    LevelDiagnostics d;
+    d.level = (int)levels.size();
+    d.on_host = on_host;
+    d.classical = level->isClassicalAMGLevel();
+    d.block_size = level->getA().get_block_dimy();
+    d.rows = level->getA().get_num_rows();
+    d.nnz = (int64_t)level->getA().get_num_nz() + (level->getA().hasProps(DIAG) ? d.rows : 0);
+
+    if (!level->isCoarsest())
+    {
+        level->computeDiagnostics(d, rate_aggregates);
+    }
+
+    levels.push_back(d);
+}
+
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+bool AMG<t_vecPrec, t_matPrec, t_indPrec>::getDiagnostics(HierarchyDiagnostics &diagnostics)
+{
+    std::vector<LevelDiagnostics> &levels = diagnostics.levels;
+    levels.clear();
+
+    for (AMG_Level<TConfig_d> *level_d = fine_d; level_d != NULL; level_d = level_d->getNextLevel( device_memory( ) ))
+    {
+        levelDiagnostics(level_d, false, diagnostics.rate_aggregates, levels);
+    }
+
+    for (AMG_Level<TConfig_h> *level_h = fine_h; level_h != NULL; level_h = level_h->getNextLevel( host_memory( ) ))
+    {
+        levelDiagnostics(level_h, true, diagnostics.rate_aggregates, levels);
+    }
+
+    for (size_t l = 0; l + 1 < levels.size(); l++)
+    {
+        LevelDiagnostics &d = levels[l];
+        const LevelDiagnostics &c = levels[l + 1];
+        d.coarse_rows = c.rows;
+        d.coarsening_ratio = d.rows > 0 ? c.rows / (double)d.rows : 0.;
+        d.galerkin_fill_ratio = c.rows > 0 && d.nnz > 0 ? (c.nnz / (double)c.rows) / (d.nnz / (double)d.rows) : 0.;
+    }
+
+    return getComplexity(diagnostics.grid_complexity, diagnostics.operator_complexity);
+}
+
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+bool AMG<t_vecPrec, t_matPrec, t_indPrec>::getComplexity(double &grid_complexity, double &operator_complexity)
+{
+    std::vector<LevelSize> sizes;
+    getLevelSizes(sizes, false);
+
+    if (sizes.empty() || sizes[0].rows == 0 || sizes[0].nnz == 0)
+    {
+        return false;
+    }
+
+    int64_t total_rows = 0, total_nnz = 0;
+
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        total_rows += sizes[i].rows;
+        total_nnz += sizes[i].nnz;
+    }
+
+    grid_complexity = total_rows / (double) sizes[0].rows;
+    operator_complexity = total_nnz / (double) sizes[0].nnz;
+    return true;
+}
+
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void AMG<t_vecPrec, t_matPrec, t_indPrec>::printCoarsePoints()
 {
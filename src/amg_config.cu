@@ -1189,6 +1189,29 @@ void AMG_Config::printAMGConfig()
     amgx_output(config_ss.str().c_str(), config_ss.str().length());
 }
 
+uint64_t AMG_Config::fingerprint()
+{
+    std::stringstream ss;
+
+    for (ParamDB::iterator iter = m_params.begin(); iter != m_params.end(); iter++)
+    {
+        ParamDesc::iterator desc_iter = param_desc.find(iter->first.second);
+        ss << iter->first.first << ":" << iter->first.second << "(" << iter->second.first << ")=";
+        ss << getParameterString(iter->second.second, desc_iter->second) << ",";
+    }
+
+    // FNV-1a
+    const std::string str = ss.str();
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        hash = (hash ^ (unsigned char)str[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
 AMGX_ERROR AMG_Config::checkString(std::string &str)
 {
     std::string::iterator it;
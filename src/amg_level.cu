@@ -91,6 +91,7 @@ void AMG_Level<T_Config>::setup_smoother()
 {
     typedef typename TConfig::MemSpace MemorySpace;
     (*this).Profile.tic("SmootherIni");
+    amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_SMOOTHER, this->getLevelIndex());
     // Initialize the smoother
     /*if( this->smoother != NULL )
       delete this->smoother;*/
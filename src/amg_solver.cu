@@ -9,12 +9,34 @@
 #include <misc.h>
 #include <assert.h>
 #include <util.h>
+#include <structure_hash.h>
+#include <thrust_wrapper.h>
+#include <blas.h>
 
 using std::string;
 
 namespace amgx
 {
 
+namespace
+{
+
+// Key of the setup structure cache: sparsity pattern of A, the configuration and the scope of
+// the AMG solver within it. The pattern is hashed where A lives, it is not copied to the host.
+template <class TConfig>
+uint64_t setup_cache_key(const Matrix<TConfig> &A, AMG_Config &cfg, const std::string &amg_scope)
+{
+    int header[4] = {A.get_num_rows(), A.get_block_dimx(), A.get_block_dimy(), A.hasProps(DIAG) ? 1 : 0};
+    uint64_t cfg_hash = cfg.fingerprint();
+    return structureHash(header, sizeof(header), 1) ^
+           structureHash(A.row_offsets.raw(), A.row_offsets.size() * sizeof(int), 2) ^
+           structureHash(A.col_indices.raw(), A.col_indices.size() * sizeof(int), 3) ^
+           structureHash(amg_scope.data(), amg_scope.size(), 4) ^
+           structureHash(&cfg_hash, sizeof(cfg_hash), 5);
+}
+
+} // end anonymous namespace
+
 template< class T_Config >
 void AMG_Solver<T_Config>::process_config(AMG_Config &in_cfg, std::string solver_scope)
 {
@@ -96,6 +118,7 @@ AMG_Solver<T_Config>::AMG_Solver(const AMG_Solver<T_Config> &amg_solver)
     m_cfg_self = false;
     solver->incr_ref_count();
     m_ptrA = amg_solver.m_ptrA;
+    m_ptrOp = amg_solver.m_ptrOp;
     m_with_timings = amg_solver.m_with_timings;
 
     if ( m_with_timings )
@@ -116,6 +139,7 @@ AMG_Solver<T_Config> &AMG_Solver<T_Config>::operator=(const AMG_Solver<T_Config>
     m_cfg_self = false;
     solver->incr_ref_count();
     m_ptrA = amg_solver.m_ptrA;
+    m_ptrOp = amg_solver.m_ptrOp;
     m_with_timings = amg_solver.m_with_timings;
 
     if ( m_with_timings )
@@ -171,6 +195,9 @@ const typename AMG_Solver<T_Config>::PODVector_h   &AMG_Solver<T_Config>::get_re
 template< class T_Config >
 AMGX_ERROR AMG_Solver<T_Config>::setup( Matrix<T_Config> &A)//&A0)
 {
+    HostParallelScope host_parallel(m_resources);
+    ReproducibleReductionsScope reproducible_reductions(m_resources);
+    amgx::memory::MemoryOwnerScope memory_owner(m_resources, m_resources != NULL && m_resources->getMemoryAccounting());
     bool reuse_fine_matrix = (getStructureReuseLevels() > 0) && A.is_matrix_setup();
     bool reuse_all = (getStructureReuseLevels() == -1) && A.is_matrix_setup();
 
@@ -185,6 +212,23 @@ AMGX_ERROR AMG_Solver<T_Config>::setup( Matrix<T_Config> &A)//&A0)
         cudaEventRecord(m_setup_start);
     }
 
+    // a hierarchy built for the same sparsity pattern and configuration only needs the numeric
+    // setup, the key is only computed when the cache is on
+    SetupStructureCache &setup_cache = m_resources->getSetupCache();
+    bool use_setup_cache = setup_cache.enabled() && !reuse_fine_matrix && A.is_matrix_singleGPU() && !structure_reuse_levels_scope.empty();
+    uint64_t cache_key = 0;
+
+    if (use_setup_cache)
+    {
+        cache_key = setup_cache_key(A, *m_cfg, structure_reuse_levels_scope);
+        SetupStructureCache::Structure structure;
+
+        if (setup_cache.find(cache_key, structure))
+        {
+            solver->importCoarseStructure(structure);
+        }
+    }
+
     // postpone free syncs, use device pool
     memory::setAsyncFreeFlag(true);
     AMGX_ERROR e = solver->setup_no_throw(A, reuse_fine_matrix);
@@ -195,6 +239,16 @@ AMGX_ERROR AMG_Solver<T_Config>::setup( Matrix<T_Config> &A)//&A0)
     // free postponed objects
     amgx::thrust::global_thread_handle::cudaFreeWait();
 
+    if (use_setup_cache && e == AMGX_OK)
+    {
+        SetupStructureCache::Structure structure;
+
+        if (solver->exportCoarseStructure(structure) && !structure.empty())
+        {
+            setup_cache.insert(cache_key, structure);
+        }
+    }
+
     if ( m_with_timings )
     {
         cudaEventRecord(m_setup_stop);
@@ -207,6 +261,10 @@ AMGX_ERROR AMG_Solver<T_Config>::setup( Matrix<T_Config> &A)//&A0)
 template< class T_Config >
 AMGX_ERROR AMG_Solver<T_Config>::resetup( Matrix<T_Config> &A)//&A0 )
 {
+    HostParallelScope host_parallel(m_resources);
+    ReproducibleReductionsScope reproducible_reductions(m_resources);
+    amgx::memory::MemoryOwnerScope memory_owner(m_resources, m_resources != NULL && m_resources->getMemoryAccounting());
+
     if ( m_with_timings )
     {
         cudaEventRecord(m_setup_start);
@@ -245,12 +303,49 @@ AMGX_ERROR AMG_Solver<T_Config>::resetup_capi( std::shared_ptr<Matrix<T_Config>>
     return resetup(*m_ptrA);
 }
 
+template< class T_Config >
+AMGX_ERROR AMG_Solver<T_Config>::setup_matrix_free( std::shared_ptr<Matrix<T_Config>> pSurrogate, typename MatrixFreeOperator<T_Config>::ApplyCallback apply, void *user_data )
+{
+    m_ptrA = pSurrogate;
+    m_ptrOp.reset(new MatrixFreeOperator<T_Config>(*m_ptrA, apply, user_data));
+    HostParallelScope host_parallel(m_resources);
+    ReproducibleReductionsScope reproducible_reductions(m_resources);
+    amgx::memory::MemoryOwnerScope memory_owner(m_resources, m_resources != NULL && m_resources->getMemoryAccounting());
+
+    if ( m_with_timings )
+    {
+        cudaEventRecord(m_setup_start);
+    }
+
+    // postpone free syncs, use device pool
+    memory::setAsyncFreeFlag(true);
+    AMGX_ERROR e = solver->setup_no_throw(*m_ptrOp, false);
+    m_resources->get_tmng()->wait_threads();
+    amgx::thrust::global_thread_handle::joinDevicePools();
+    // reset settings to normal
+    memory::setAsyncFreeFlag(false);
+    // free postponed objects
+    amgx::thrust::global_thread_handle::cudaFreeWait();
+
+    if ( m_with_timings )
+    {
+        cudaEventRecord(m_setup_stop);
+        cudaEventSynchronize(m_setup_stop);
+    }
+
+    return e;
+}
+
 /****************************************************
 * Solves the AMG system Ax=b
 ***************************************************/
 template<class T_Config>
 AMGX_ERROR AMG_Solver<T_Config>::solve( Vector<T_Config> &b, Vector<T_Config> &x, AMGX_STATUS &status, bool xIsZero )
 {
+    HostParallelScope host_parallel(m_resources);
+    ReproducibleReductionsScope reproducible_reductions(m_resources);
+    amgx::memory::MemoryOwnerScope memory_owner(m_resources, m_resources != NULL && m_resources->getMemoryAccounting());
+
     if ( m_with_timings )
     {
         cudaEventRecord(m_solve_start);
@@ -21,16 +21,21 @@
 #include "distributed/comms_mpi_hostbuffer_stream.h"
 #include "distributed/distributed_arranger.h"
 #include "distributed/distributed_io.h"
+#include "distributed/graph_partitioner.h"
+#include "problem_generator.h"
+#include "structure_hash.h"
 #include "resources.h"
 #include "matrix_distribution.h"
 #include <amgx_timer.h>
 #include "util.h"
 #include "reorder_partition.h"
 #include <algorithm>
+#include <limits>
 #include <solvers/solver.h>
 #include <matrix.h>
 #include <vector.h>
 #include <thrust_wrapper.h>
+#include <blas.h>
 
 #include "matrix_analysis.h"
 #include "amgx_types/util.h"
@@ -38,6 +43,7 @@
 #include "amgx_c_wrappers.inl"
 #include "amgx_c_common.h"
 #include "multiply.h"
+#include <cusp/detail/format_utils.h>
 
 namespace amgx
 {
@@ -706,6 +712,73 @@ inline AMGX_ERROR set_solver_with_shared(AMGX_solver_handle slv,
     return (solver.*memf)(wrapA.wrapped());
 }
 
+template<AMGX_Mode CASE>
+inline AMGX_ERROR solver_setup_matrix_free(AMGX_solver_handle slv,
+        int n,
+        int block_dim,
+        AMGX_matrix_free_apply_callback apply,
+        void *user_data,
+        const void *diag_data,
+        AMGX_matrix_handle mtx,
+        Resources *resources)
+{
+    typedef typename TemplateMode<CASE>::Type TConfig;
+    typedef AMG_Solver<TConfig> SolverLetterT;
+    typedef CWrapHandle<AMGX_solver_handle, SolverLetterT> SolverW;
+    typedef Matrix<TConfig> MatrixLetterT;
+    typedef CWrapHandle<AMGX_matrix_handle, MatrixLetterT> MatrixW;
+    typedef typename MatPrecisionMap<AMGX_GET_MODE_VAL(AMGX_MatPrecision, CASE)>::Type ValueType;
+    SolverW wrapSolver(slv);
+    SolverLetterT &solver = *wrapSolver.wrapped();
+
+    if (n < 1 || block_dim < 1 || apply == NULL || (mtx == NULL && diag_data == NULL))
+    {
+        FatalError("Error: matrix-free operator needs an apply callback and a surrogate matrix or its diagonal.\n", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    cudaSetDevice(solver.getResources()->getDevice(0));
+    std::shared_ptr<MatrixLetterT> pA;
+
+    if (mtx != NULL)
+    {
+        MatrixW wrapA(mtx);
+
+        if (wrapA.mode() != wrapSolver.mode())
+        {
+            FatalError("Error: mismatch between Matrix mode and Solver Mode.\n", AMGX_ERR_BAD_PARAMETERS);
+        }
+
+        pA = wrapA.wrapped();
+
+        if (pA->getResources() != solver.getResources())
+        {
+            FatalError("Error: matrix and solver use different resources object, exiting", AMGX_ERR_BAD_PARAMETERS);
+        }
+
+        if (pA->get_num_rows() != n || pA->get_block_dimx() != block_dim || pA->get_block_dimy() != block_dim)
+        {
+            FatalError("Error: surrogate matrix does not match the size of the matrix-free operator.\n", AMGX_ERR_BAD_PARAMETERS);
+        }
+    }
+    else
+    {
+        // block diagonal surrogate, one block per row
+        pA.reset(new MatrixLetterT());
+        MatrixLetterT &A = *pA;
+        A.setResources(solver.getResources());
+        A.addProps(CSR);
+        A.resize(n, n, n, block_dim, block_dim);
+        thrust_wrapper::sequence<TConfig::memSpace>(A.row_offsets.begin(), A.row_offsets.end());
+        thrust_wrapper::sequence<TConfig::memSpace>(A.col_indices.begin(), A.col_indices.end());
+        cudaMemcpy(A.values.raw(), diag_data, sizeof(ValueType) * n * block_dim * block_dim, cudaMemcpyDefault);
+        A.computeDiagonal();
+        cudaCheckError();
+        A.set_initialized(1);
+    }
+
+    return solver.setup_matrix_free(pA, apply, user_data);
+}
+
 template<AMGX_Mode CASE,
          template<typename> class SolverType,
          template<typename> class VectorType>
@@ -839,6 +912,7 @@ inline AMGX_ERROR solver_calculate_residual_norm( AMGX_solver_handle slv,
     }
 
     cudaSetDevice(resources->getDevice(0));
+    ReproducibleReductionsScope reproducible_reductions(resources);
     solver.getSolverObject()->compute_residual_norm_external(A, v_rhs, v_x, (typename amgx::types::PODTypes<typename VectorLetterT::value_type>::type *)norm_data);
     return AMGX_OK;
 }
@@ -911,6 +985,146 @@ inline AMGX_RC matrix_upload_all(AMGX_matrix_handle mtx,
     return AMGX_RC_OK;
 }
 
+template<AMGX_Mode CASE>
+inline AMGX_RC matrix_upload_coo(AMGX_matrix_handle mtx,
+                                 int n,
+                                 int nnz,
+                                 int block_dimx,
+                                 int block_dimy,
+                                 const int *row_ptrs,
+                                 const int *row_indices,
+                                 const int *col_indices,
+                                 const void *data,
+                                 Resources *resources)
+{
+    typedef Matrix<typename TemplateMode<CASE>::Type> MatrixLetterT;
+    typedef CWrapHandle<AMGX_matrix_handle, MatrixLetterT> MatrixW;
+    typedef typename MatPrecisionMap<AMGX_GET_MODE_VAL(AMGX_MatPrecision, CASE)>::Type ValueType;
+    typedef typename MatrixLetterT::IVector IVector;
+    typedef typename MatrixLetterT::MVector MVector;
+    MatrixW wrapA(mtx);
+    MatrixLetterT &A = *wrapA.wrapped();
+
+    if (!wrapA.is_valid()
+            || n < 1
+            || nnz < 0
+            || (row_ptrs == NULL && row_indices == NULL)
+            || col_indices == NULL)
+    {
+        AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+    }
+
+    if (block_dimx != 1 || block_dimy != 1)
+    {
+        return AMGX_RC_NOT_SUPPORTED_BLOCKSIZE;
+    }
+
+    // distributed matrices go through AMGX_matrix_upload_all_global
+    if (A.manager != NULL)
+    {
+        return AMGX_RC_NOT_SUPPORTED_TARGET;
+    }
+
+    cudaSetDevice(A.getResources()->getDevice(0));
+    IVector I(nnz), J(nnz);
+    MVector V(nnz);
+
+    if (row_indices != NULL)
+    {
+        cudaMemcpy(I.raw(), row_indices, sizeof(int) * nnz, cudaMemcpyDefault);
+    }
+    else
+    {
+        // unsorted CSR, expand the offsets to row indices
+        IVector offsets(n + 1);
+        cudaMemcpy(offsets.raw(), row_ptrs, sizeof(int) * (n + 1), cudaMemcpyDefault);
+        cusp::detail::offsets_to_indices(offsets, I);
+    }
+
+    cudaMemcpy(J.raw(), col_indices, sizeof(int) * nnz, cudaMemcpyDefault);
+    cudaMemcpy(V.raw(), data, sizeof(ValueType) * nnz, cudaMemcpyDefault);
+    cudaCheckError();
+    A.set_initialized(0);
+    A.setColsReorderedByColor(false);
+    A.assembleFromTriplets(n, I, J, V);
+    return AMGX_RC_OK;
+}
+
+template<AMGX_Mode CASE>
+inline AMGX_RC matrix_upload_all_host(AMGX_matrix_handle mtx,
+                                int n,
+                                int nnz,
+                                int block_dimx,
+                                int block_dimy,
+                                const int *row_ptrs,
+                                const int *col_indices,
+                                const void *data,
+                                const void *diag_data,
+                                Resources *resources)
+{
+    typedef Matrix<typename TemplateMode<CASE>::Type> MatrixLetterT;
+    typedef CWrapHandle<AMGX_matrix_handle, MatrixLetterT> MatrixW;
+    typedef typename MatPrecisionMap<AMGX_GET_MODE_VAL(AMGX_MatPrecision, CASE)>::Type ValueType;
+    MatrixW wrapA(mtx);
+    MatrixLetterT &A = *wrapA.wrapped();
+
+    if (!wrapA.is_valid()
+            || n < 1
+            || nnz < 0
+            || block_dimx < 1
+            || block_dimy < 1
+            || row_ptrs == NULL
+            || col_indices == NULL
+            || data == NULL)
+    {
+        AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+    }
+
+    // distributed matrices are renumbered and reordered by the manager, there is nothing to bind to
+    if (A.manager != NULL)
+    {
+        return AMGX_RC_NOT_SUPPORTED_TARGET;
+    }
+
+    const ValueType *vals = (const ValueType *)data;
+    const ValueType *diag_vals = (const ValueType *)diag_data;
+    const int block_size = block_dimx * block_dimy;
+    A.set_initialized(0);
+    A.addProps(CSR);
+    A.setColsReorderedByColor(false);
+    A.delProps(COO);
+    A.delProps(DIAG);
+
+    if (diag_data)
+    {
+        A.addProps(DIAG);
+    }
+
+    // The caller's arrays are already in host memory: copy them once into the matrix storage
+    // instead of value-initializing it in resize() and copying on top.
+    const size_t values_size = diag_data ? (size_t)(nnz + n) * block_size : (size_t)(nnz + 1) * block_size;
+    A.row_offsets.assign(row_ptrs, row_ptrs + n + 1);
+    A.col_indices.assign(col_indices, col_indices + nnz);
+    A.values.clear();
+    A.values.reserve(values_size);
+    A.values.assign(vals, vals + (size_t)nnz * block_size);
+
+    if (diag_data)
+    {
+        A.values.insert(A.values.end(), diag_vals, diag_vals + (size_t)n * block_size);
+    }
+    else
+    {
+        A.values.resize(values_size, types::util<ValueType>::get_zero());
+    }
+
+    // arrays are already sized, resize only sets the dimensions and the auxiliary arrays
+    A.resize(n, n, nnz, block_dimx, block_dimy, 1);
+    A.computeDiagonal();
+    A.set_initialized(1);
+    return AMGX_RC_OK;
+}
+
 template<AMGX_Mode CASE>
 inline AMGX_RC matrix_replace_coefficients(AMGX_matrix_handle mtx,
         int n,
@@ -950,6 +1164,35 @@ inline AMGX_RC matrix_replace_coefficients(AMGX_matrix_handle mtx,
             AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
         }
 
+        if (A.hasAssemblyMap())
+        {
+            // matrix was assembled from triplets, data comes in the original triplet order
+            // and the diagonal is part of the triplets
+            if (diag_data != NULL)
+            {
+                std::string err = "Matrix was uploaded as triplets, pass its diagonal in data instead of diag_data";
+                amgx_output(err.c_str(), err.length());
+                AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+            }
+
+            if (nnz != A.getAssemblyMapSize())
+            {
+                std::string err = "Number of values passed to replace_coefficients doesn't match the uploaded triplets";
+                amgx_output(err.c_str(), err.length());
+                AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+            }
+
+            if (data)
+            {
+                typename MatrixLetterT::MVector V(nnz);
+                cudaMemcpy(V.raw(), (ValueType *)data, sizeof(ValueType) * nnz, cudaMemcpyDefault);
+                A.replaceAssembledValues(V);
+            }
+
+            cudaCheckError();
+            return AMGX_RC_OK;
+        }
+
         if (data)
         {
             cudaMemcpy(A.values.raw(), (ValueType *)data, sizeof(ValueType) * (nnz * A.get_block_size()), cudaMemcpyDefault);
@@ -1495,6 +1738,7 @@ inline AMGX_RC read_system_distributed(AMGX_matrix_handle mtx,
     typedef typename TConfig::template setMemSpace<AMGX_host>::Type TConfig_h;
     typedef typename TConfig_h::template setVecPrec<AMGX_vecInt>::Type ivec_value_type_h;
     typedef Vector<ivec_value_type_h> IVector_h;
+    HostParallelScope host_parallel(resources);
     IVector_h partitionVec;
     IVector_h partSize;
     MatrixLetterT *mtx_ptr = NULL;
@@ -1577,7 +1821,56 @@ inline AMGX_RC read_system_distributed(AMGX_matrix_handle mtx,
 
         msg << "n";
     }
-    else { num_partitions = num_ranks; }
+    else
+    {
+        num_partitions = num_ranks;
+        std::string partitioner, partitioner_scope;
+        resources->getResourcesConfig()->getParameter<std::string>("read_partitioner", partitioner, "default", partitioner_scope);
+
+        if (partitioner == "GRAPH" && num_ranks > 1)
+        {
+            // Only rank 0 reads the whole system and partitions its graph, the others receive the
+            // partition vector, which distributedRead needs on every rank like a user-given one
+            int header[2] = {AMGX_OK, 0}; // read status, number of rows
+            int64_t edge_cut = 0;
+
+            if (part == 0)
+            {
+                Matrix<TConfig_h> Ag;
+                Ag.setResources(resources);
+                AMG_Configuration t_amgx_cfg;
+                header[0] = MatrixIO<TConfig_h>::readSystem(filename, Ag, *t_amgx_cfg.getConfigObject(), io_config::MTX);
+
+                if (header[0] == AMGX_OK)
+                {
+                    header[1] = Ag.get_num_rows();
+                    partitionVec.resize(header[1]);
+                    edge_cut = partitionGraphKway(Ag.get_num_rows(), Ag.row_offsets.raw(), Ag.col_indices.raw(), num_ranks, partitionVec.raw());
+                }
+            }
+
+            MPI_Bcast(header, 2, MPI_INT, 0, *mpi_comm);
+            read_error = (AMGX_ERROR)header[0];
+
+            if (read_error != AMGX_OK)
+            {
+                return AMGX_RC_OK;
+            }
+
+            partitionVec.resize(header[1]);
+            MPI_Bcast(partitionVec.raw(), header[1], MPI_INT, 0, *mpi_comm);
+            MPI_Bcast(&edge_cut, 1, MPI_INT64_T, 0, *mpi_comm);
+            partSize.resize(num_ranks);
+            thrust_wrapper::fill<AMGX_host>(partSize.begin(), partSize.end(), 0);
+
+            for (int i = 0; i < partitionVec.size(); i++)
+            {
+                partSize[partitionVec[i]]++;
+            }
+
+            msg << "Graph partitioner edge cut: " << edge_cut << "\n";
+        }
+    }
 
     switch (AMGX_GET_MODE_VAL(AMGX_MemorySpace, CASE))
     {
@@ -1670,6 +1963,7 @@ inline AMGX_RC generate_distributed_poisson_7pt(AMGX_matrix_handle mtx,
     VectorW wrapSol(sol_);
     VectorLetterT &sol = *wrapSol.wrapped();
     cudaSetDevice(A_part.getResources()->getDevice(0));
+    HostParallelScope host_parallel(A_part.getResources());
     MPI_Comm *mpi_comm = A_part.getResources()->getMpiComm();
     int num_ranks;
     MPI_Comm_size(*mpi_comm, &num_ranks);
@@ -1712,6 +2006,33 @@ inline AMGX_RC generate_distributed_poisson_7pt(AMGX_matrix_handle mtx,
     return AMGX_RC_OK;
 }
 
+// Hash of everything that determines the distributed structure of an upload:
+// sizes, sparsity pattern in global numbering and partitioning. Values do not contribute.
+inline uint64_t distributed_structure_fingerprint(int n_global, int n, int nnz, int block_dimx, int block_dimy,
+        const int *row_ptrs, const void *col_indices_global, const void *diag_data, int num_ranks, const MatrixDistribution &mdist)
+{
+    const size_t col_bytes = mdist.get32BitColIndices() ? sizeof(int) : sizeof(int64_t);
+    const int header[] = { n_global, n, nnz, block_dimx, block_dimy, num_ranks, mdist.getNumImportRings(),
+                           (int)mdist.get32BitColIndices(), (int)mdist.getPartitionInformationStyle(), diag_data != NULL
+                         };
+    // each array is hashed where it lives, device arrays are not copied to the host
+    uint64_t h = structureHash(header, sizeof(header), 1);
+    h ^= structureHash(row_ptrs, sizeof(int) * (n + 1), 2);
+    h ^= structureHash(col_indices_global, col_bytes * nnz, 3);
+
+    if (mdist.getPartitionInformationStyle() == MatrixDistribution::PartitionInformation::PartitionVec)
+    {
+        h ^= structureHash(mdist.getPartitionData(), sizeof(int) * n_global, 4);
+    }
+    else if (mdist.getPartitionInformationStyle() == MatrixDistribution::PartitionInformation::PartitionOffsets)
+    {
+        h ^= structureHash(mdist.getPartitionData(), col_bytes * (num_ranks + 1), 5);
+    }
+
+    // 0 is reserved for "no fingerprint"
+    return h == 0 ? 1 : h;
+}
+
 template<AMGX_Mode CASE>
 inline AMGX_RC matrix_upload_distributed(AMGX_matrix_handle mtx,
                                         int n_global,
@@ -1734,9 +2055,42 @@ inline AMGX_RC matrix_upload_distributed(AMGX_matrix_handle mtx,
     MatrixW wrapA(mtx);
     MatrixLetterT &A_part = *wrapA.wrapped();
     cudaSetDevice(A_part.getResources()->getDevice(0));
+    HostParallelScope host_parallel(A_part.getResources());
     MPI_Comm *mpi_comm = A_part.getResources()->getMpiComm();
     int num_ranks;
     MPI_Comm_size(*mpi_comm, &num_ranks);
+    const uint64_t fingerprint = distributed_structure_fingerprint(n_global, n, nnz, block_dimx, block_dimy,
+                                 row_ptrs, col_indices_global, diag_data, num_ranks, mdist);
+
+    /* Same structure and partitioning as the previous upload on every rank:
+       keep the renumbering and communication maps and only replace the values */
+    int local_match = 0;
+
+    if (A_part.manager != NULL && A_part.is_initialized() && !A_part.is_matrix_singleGPU() &&
+            A_part.manager->getStructureFingerprint() != 0 && A_part.manager->getStructureFingerprint() == fingerprint)
+    {
+        DistributedComms<TConfig> *comms = A_part.manager->isFineLevelConsolidated() ?
+                                           A_part.manager->getFineLevelComms() : A_part.manager->getComms();
+        local_match = (comms != NULL && comms->halo_coloring == LAST) ? 1 : 0;
+    }
+
+    int global_match = 0;
+    MPI_Allreduce(&local_match, &global_match, 1, MPI_INT, MPI_MIN, *mpi_comm);
+
+    if (global_match)
+    {
+        if (A_part.manager->isFineLevelConsolidated() || A_part.manager->isFineLevelGlued())
+        {
+            A_part.manager->replaceMatrixCoefficientsWithCons(n, nnz, (const ValueType *)data, (const ValueType *)diag_data);
+        }
+        else
+        {
+            A_part.manager->replaceMatrixCoefficientsNoCons(n, nnz, (const ValueType *)data, (const ValueType *)diag_data);
+        }
+
+        A_part.manager->countValueOnlyUpload();
+        return AMGX_RC_OK;
+    }
 
     /* Create distributed manager */
     if (A_part.manager != NULL)
@@ -1774,6 +2128,7 @@ inline AMGX_RC matrix_upload_distributed(AMGX_matrix_handle mtx,
     /* if (A_part.manager != NULL) A_part.manager->printToFile("M_clf_gua",""); */
     /* A_part.printToFile("A_clf_gua","",-1,-1); */
     A_part.set_initialized(1);
+    A_part.manager->setStructureFingerprint(fingerprint);
     return AMGX_RC_OK;
 }
 
@@ -1833,6 +2188,108 @@ inline AMGX_RC matrix_upload_all_global_32(AMGX_matrix_handle mtx,
 }
 #endif
 
+template<AMGX_Mode CASE>
+inline AMGX_RC generate_system(AMGX_matrix_handle mtx,
+                               AMGX_vector_handle rhs_,
+                               AMGX_vector_handle sol_,
+                               const char *problem,
+                               int nx,
+                               int ny,
+                               int nz,
+                               const char *options,
+                               Resources *resources)
+{
+    typedef typename TemplateMode<CASE>::Type TConfig;
+    typedef Vector<TConfig> VectorLetterT;
+    typedef CWrapHandle<AMGX_vector_handle, VectorLetterT> VectorW;
+    typedef typename MatPrecisionMap<AMGX_GET_MODE_VAL(AMGX_MatPrecision, CASE)>::Type ValueType;
+    typedef typename Vector<TConfig>::value_type ValueTypeB;
+    const ProblemDesc p = parseProblem(problem, nx, ny, nz, options != NULL ? options : "");
+
+    // the distributed upload takes the global number of rows as an int
+    if (p.num_rows() > std::numeric_limits<int>::max())
+    {
+        return AMGX_RC_BAD_PARAMETERS;
+    }
+
+    int num_ranks = 1, my_id = 0;
+#ifdef AMGX_WITH_MPI
+    MPI_Comm *mpi_comm = resources->getMpiComm();
+
+    if (mpi_comm != NULL)
+    {
+        MPI_Comm_size(*mpi_comm, &num_ranks);
+        MPI_Comm_rank(*mpi_comm, &my_id);
+    }
+
+#endif
+    // every rank generates its own contiguous slab of rows, nothing is communicated
+    std::vector<int64_t> partition_offsets(num_ranks + 1);
+
+    for (int r = 0; r <= num_ranks; r++)
+    {
+        partition_offsets[r] = p.num_rows() * r / num_ranks;
+    }
+
+    const int bs = p.block_size();
+    const int n = (int)(partition_offsets[my_id + 1] - partition_offsets[my_id]);
+    std::vector<int> row_offsets;
+    std::vector<ValueType> values;
+    AMGX_RC rc = AMGX_RC_OK;
+
+    if (num_ranks == 1)
+    {
+        std::vector<int> col_indices;
+        generateProblemRows(p, 0, n, row_offsets, col_indices, values);
+        rc = matrix_upload_all<CASE>(mtx, n, row_offsets[n], bs, bs, row_offsets.data(), col_indices.data(), values.data(), NULL, resources);
+    }
+
+#ifdef AMGX_WITH_MPI
+    else
+    {
+        std::vector<int64_t> col_indices;
+        generateProblemRows(p, partition_offsets[my_id], partition_offsets[my_id + 1], row_offsets, col_indices, values);
+        AMGX_distribution_handle dist;
+        AMGX_distribution_create(&dist, NULL);
+        MatrixDistributionW wrapDist(dist);
+        wrapDist.wrapped()->setPartitionOffsets(partition_offsets.data());
+        rc = matrix_upload_distributed<CASE>(mtx, (int)p.num_rows(), n, row_offsets[n], bs, bs, row_offsets.data(), col_indices.data(),
+                                             values.data(), NULL, dist);
+        AMGX_distribution_destroy(dist);
+    }
+
+#endif
+
+    if (rc != AMGX_RC_OK)
+    {
+        return rc;
+    }
+
+    /* rhs of ones and zero initial guess on the owned rows */
+    if (rhs_ != NULL)
+    {
+        VectorW wrapRhs(rhs_);
+        VectorLetterT &rhs = *wrapRhs.wrapped();
+        rhs.set_block_dimx(1);
+        rhs.set_block_dimy(bs);
+        rhs.resize(n * bs);
+        thrust_wrapper::fill<MemorySpaceMap<AMGX_GET_MODE_VAL(AMGX_MemorySpace, CASE)>::id>(rhs.begin(), rhs.end(), types::util<ValueTypeB>::get_one());
+    }
+
+    if (sol_ != NULL)
+    {
+        VectorW wrapSol(sol_);
+        VectorLetterT &sol = *wrapSol.wrapped();
+        sol.set_block_dimx(1);
+        sol.set_block_dimy(bs);
+        sol.resize(n * bs);
+        thrust_wrapper::fill<MemorySpaceMap<AMGX_GET_MODE_VAL(AMGX_MemorySpace, CASE)>::id>(sol.begin(), sol.end(), types::util<ValueTypeB>::get_zero());
+    }
+
+    cudaCheckError();
+    return AMGX_RC_OK;
+}
+
 template<AMGX_Mode CASE>
 inline AMGX_RC matrix_comm_from_maps(AMGX_matrix_handle mtx, int allocated_halo_depth, int num_import_rings, int max_num_neighbors, const int *neighbors, const int *send_ptrs, int const *send_maps, const int *recv_ptrs, int const  *recv_maps)
 {
@@ -1985,6 +2442,147 @@ inline void solver_get_status(AMGX_solver_handle slv, AMGX_SOLVE_STATUS *st)
     }
 }
 
+// Aggregates file: "AMGXAGGR", format version, number of levels, then for every level the length
+// and contents of its coarse-grid structure (see AMG_Level::exportCoarseStructure). Only the
+// aggregates are stored, a load skips aggregate selection and nothing else.
+static const char AGGREGATES_MAGIC[8] = {'A', 'M', 'G', 'X', 'A', 'G', 'G', 'R'};
+static const uint32_t AGGREGATES_VERSION = 1;
+
+template<AMGX_Mode CASE>
+inline void solver_save_aggregates(AMGX_solver_handle slv, const char *filename)
+{
+    auto *solver = get_mode_object_from<CASE, AMG_Solver, AMGX_solver_handle>(slv);
+    cudaSetDevice(solver->getResources()->getDevice(0));
+    std::vector<std::vector<int> > structure;
+
+    if (!solver->getSolverObject()->exportCoarseStructure(structure) || structure.empty())
+    {
+        FatalError("Solver has no aggregation hierarchy to save, call AMGX_solver_setup first", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    FILE *fout = fopen(filename, "wb");
+
+    if (!fout)
+    {
+        FatalError("Cannot open file for writing the aggregates", AMGX_ERR_IO);
+    }
+
+    uint32_t header[2] = {AGGREGATES_VERSION, (uint32_t)structure.size()};
+    bool ok = fwrite(AGGREGATES_MAGIC, 1, sizeof(AGGREGATES_MAGIC), fout) == sizeof(AGGREGATES_MAGIC) &&
+              fwrite(header, sizeof(uint32_t), 2, fout) == 2;
+
+    for (size_t i = 0; i < structure.size() && ok; i++)
+    {
+        uint64_t size = structure[i].size();
+        ok = fwrite(&size, sizeof(uint64_t), 1, fout) == 1 &&
+             fwrite(structure[i].data(), sizeof(int), size, fout) == size;
+    }
+
+    fclose(fout);
+
+    if (!ok)
+    {
+        FatalError("Error writing the aggregates file", AMGX_ERR_IO);
+    }
+}
+
+template<AMGX_Mode CASE>
+inline void solver_load_aggregates(AMGX_solver_handle slv, const char *filename)
+{
+    auto *solver = get_mode_object_from<CASE, AMG_Solver, AMGX_solver_handle>(slv);
+    cudaSetDevice(solver->getResources()->getDevice(0));
+    FILE *fin = fopen(filename, "rb");
+
+    if (!fin)
+    {
+        FatalError("Cannot open the aggregates file", AMGX_ERR_IO);
+    }
+
+    char magic[sizeof(AGGREGATES_MAGIC)];
+    uint32_t header[2];
+    bool ok = fread(magic, 1, sizeof(magic), fin) == sizeof(magic) &&
+              std::equal(magic, magic + sizeof(magic), AGGREGATES_MAGIC) &&
+              fread(header, sizeof(uint32_t), 2, fin) == 2 && header[0] == AGGREGATES_VERSION;
+    std::vector<std::vector<int> > structure(ok ? header[1] : 0);
+
+    for (size_t i = 0; i < structure.size() && ok; i++)
+    {
+        uint64_t size;
+        ok = fread(&size, sizeof(uint64_t), 1, fin) == 1 && size <= (uint64_t)std::numeric_limits<int>::max();
+
+        if (ok)
+        {
+            structure[i].resize(size);
+            ok = fread(structure[i].data(), sizeof(int), size, fin) == size;
+        }
+    }
+
+    fclose(fin);
+
+    if (!ok)
+    {
+        FatalError("Aggregates file is truncated or was written by an incompatible version", AMGX_ERR_IO);
+    }
+
+    if (!solver->getSolverObject()->importCoarseStructure(structure))
+    {
+        FatalError("Solver has no aggregation hierarchy to load the aggregates into", AMGX_ERR_BAD_PARAMETERS);
+    }
+}
+
+static_assert(AMGX_AGGREGATE_HISTOGRAM_BINS == AGGREGATE_HISTOGRAM_BINS, "the C API histogram must have the bins of LevelDiagnostics");
+
+template<AMGX_Mode CASE>
+inline void solver_get_diagnostics(AMGX_solver_handle slv, int max_levels, AMGX_level_diagnostics *levels, int rate_aggregates,
+                                   int *num_levels, double *grid_complexity, double *operator_complexity)
+{
+    auto *solver = get_mode_object_from<CASE, AMG_Solver, AMGX_solver_handle>(slv);
+    cudaSetDevice(solver->getResources()->getDevice(0));
+    HierarchyDiagnostics diagnostics;
+    // nobody reads the rating without levels to write it to
+    diagnostics.rate_aggregates = rate_aggregates != 0 && max_levels > 0;
+
+    if (!solver->getSolverObject()->getDiagnostics(diagnostics))
+    {
+        FatalError("Solver has no AMG hierarchy, call AMGX_solver_setup first", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    const int n = (int)diagnostics.levels.size();
+
+    for (int l = 0; l < std::min(n, max_levels); l++)
+    {
+        const LevelDiagnostics &d = diagnostics.levels[l];
+        AMGX_level_diagnostics &out = levels[l];
+        out.level = d.level;
+        out.on_host = d.on_host ? 1 : 0;
+        out.classical = d.classical ? 1 : 0;
+        out.block_size = d.block_size;
+        out.rows = d.rows;
+        out.nnz = d.nnz;
+        out.coarse_rows = d.coarse_rows;
+        out.coarsening_ratio = d.coarsening_ratio;
+        out.galerkin_fill_ratio = d.galerkin_fill_ratio;
+        out.num_aggregates = d.num_aggregates;
+        out.max_aggregate_size = d.max_aggregate_size;
+        out.singletons = d.singletons;
+        std::copy(d.aggregate_size_histogram, d.aggregate_size_histogram + AGGREGATE_HISTOGRAM_BINS, out.aggregate_size_histogram);
+        out.aggregate_quality = d.aggregate_quality;
+        out.unrated_aggregates = d.unrated_aggregates;
+        out.num_coarse_points = d.num_coarse_points;
+        out.num_fine_points = d.num_fine_points;
+        out.cf_ratio = d.cf_ratio;
+        out.interp_min_row_length = d.interp_min_row_length;
+        out.interp_max_row_length = d.interp_max_row_length;
+        out.interp_avg_row_length = d.interp_avg_row_length;
+    }
+
+    if (num_levels != NULL) { *num_levels = n; }
+
+    if (grid_complexity != NULL) { *grid_complexity = diagnostics.grid_complexity; }
+
+    if (operator_complexity != NULL) { *operator_complexity = diagnostics.operator_complexity; }
+}
+
 template<AMGX_Mode CASE>
 inline void matrix_download_all(const AMGX_matrix_handle mtx,
                                 int *row_ptrs,
@@ -2771,6 +3369,39 @@ extern "C" {
         return getCAPIerror_x(rc);
     }
 
+    AMGX_RC AMGX_API AMGX_solver_setup_matrix_free(AMGX_solver_handle slv, int n, int block_dim, AMGX_matrix_free_apply_callback apply, void *user_data, const void *diag_data, AMGX_matrix_handle mtx)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_solver_setup_matrix_free " );
+        Resources *resources;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromSolverHandle(slv, &resources)), NULL);
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from<AMGX_solver_handle>(slv);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+      AMGX_ERROR rcs = solver_setup_matrix_free<CASE>(slv, n, block_dim, apply, user_data, diag_data, mtx, resources); \
+      AMGX_CHECK_API_ERROR(rcs, resources); \
+      break;\
+          }
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources) \
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        return getCAPIerror_x(rc);
+    }
+
     AMGX_RC AMGX_API AMGX_solver_solve(AMGX_solver_handle slv, AMGX_vector_handle rhs, AMGX_vector_handle sol)
     {
         nvtxRange nvrf(__func__);
@@ -2915,14 +3546,104 @@ extern "C" {
         return getCAPIerror_x(rc);
     }
 
-    AMGX_RC AMGX_matrix_destroy_impl(AMGX_matrix_handle mtx)
+    AMGX_RC AMGX_matrix_destroy_impl(AMGX_matrix_handle mtx)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_matrix_destroy " );
+        Resources *resources;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL);
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from<AMGX_matrix_handle>(mtx);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+      cudaSetDevice(get_mode_object_from<CASE,Matrix,AMGX_matrix_handle>(mtx)->getResources()->getDevice(0));\
+      remove_managed_matrix<CASE>(mtx); \
+      } \
+      break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+                    //return AMGX_RC_BAD_MODE;
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+        //return getCAPIerror(rc);
+    }
+
+    AMGX_RC AMGX_API AMGX_matrix_destroy(AMGX_matrix_handle mtx)
+    {
+        nvtxRange nvrf(__func__);
+
+        return AMGX_matrix_destroy_impl(mtx);
+    }
+
+    AMGX_RC AMGX_API AMGX_matrix_upload_all_impl(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag_data)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_matrix_upload_all " );
+        Resources *resources;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL)
+        HostParallelScope host_parallel(resources);
+        // should change to the convert(). this routine will catch possible memory exceptions and return corresponding errors. temporary catch.
+        AMGX_ERROR rc = AMGX_OK;
+        AMGX_RC rc0 = AMGX_RC_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from<AMGX_matrix_handle>(mtx);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE:{ \
+      rc0 = matrix_upload_all<CASE>(mtx,n,nnz,block_dimx,block_dimy,row_ptrs,col_indices,data,diag_data,resources); \
+    }                             \
+    break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+                    //return AMGX_RC_BAD_MODE;
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return rc0;
+        //return getCAPIerror(rc);
+    }
+
+    AMGX_RC AMGX_API AMGX_matrix_upload_all(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag_data)
+    {
+        nvtxRange nvrf(__func__);
+
+        return AMGX_matrix_upload_all_impl(mtx, n, nnz, block_dimx, block_dimy, row_ptrs, col_indices, data, diag_data);
+    }
+
+    AMGX_RC AMGX_matrix_upload_coo_impl(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *row_indices, const int *col_indices, const void *data)
     {
         nvtxRange nvrf(__func__);
 
-        AMGX_CPU_PROFILER( "AMGX_matrix_destroy " );
+        AMGX_CPU_PROFILER( "AMGX_matrix_upload_coo " );
         Resources *resources;
-        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL);
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL)
+        HostParallelScope host_parallel(resources);
         AMGX_ERROR rc = AMGX_OK;
+        AMGX_RC rc0 = AMGX_RC_OK;
 
         AMGX_TRIES()
         {
@@ -2930,42 +3651,56 @@ extern "C" {
 
             switch (mode)
             {
-#define AMGX_CASE_LINE(CASE) case CASE: { \
-      cudaSetDevice(get_mode_object_from<CASE,Matrix,AMGX_matrix_handle>(mtx)->getResources()->getDevice(0));\
-      remove_managed_matrix<CASE>(mtx); \
-      } \
-      break;
+#define AMGX_CASE_LINE(CASE) case CASE:{ \
+      rc0 = matrix_upload_coo<CASE>(mtx,n,nnz,block_dimx,block_dimy,row_ptrs,row_indices,col_indices,data,resources); \
+    }                             \
+    break;
                     AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
                     AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
 #undef AMGX_CASE_LINE
 
                 default:
                     AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
-                    //return AMGX_RC_BAD_MODE;
             }
         }
 
         AMGX_CATCHES(rc)
         AMGX_CHECK_API_ERROR(rc, resources)
-        return AMGX_RC_OK;
-        //return getCAPIerror(rc);
+        return rc0;
     }
 
-    AMGX_RC AMGX_API AMGX_matrix_destroy(AMGX_matrix_handle mtx)
+    AMGX_RC AMGX_API AMGX_matrix_upload_coo(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_indices, const int *col_indices, const void *data)
     {
         nvtxRange nvrf(__func__);
 
-        return AMGX_matrix_destroy_impl(mtx);
+        if (row_indices == NULL)
+        {
+            return AMGX_RC_BAD_PARAMETERS;
+        }
+
+        return AMGX_matrix_upload_coo_impl(mtx, n, nnz, block_dimx, block_dimy, NULL, row_indices, col_indices, data);
     }
 
-    AMGX_RC AMGX_API AMGX_matrix_upload_all_impl(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag_data)
+    AMGX_RC AMGX_API AMGX_matrix_upload_all_unsorted(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data)
     {
         nvtxRange nvrf(__func__);
 
-        AMGX_CPU_PROFILER( "AMGX_matrix_upload_all " );
+        if (row_ptrs == NULL)
+        {
+            return AMGX_RC_BAD_PARAMETERS;
+        }
+
+        return AMGX_matrix_upload_coo_impl(mtx, n, nnz, block_dimx, block_dimy, row_ptrs, NULL, col_indices, data);
+    }
+
+    AMGX_RC AMGX_API AMGX_matrix_upload_all_host(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag_data)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_matrix_upload_all_host " );
         Resources *resources;
         AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL)
-        // should change to the convert(). this routine will catch possible memory exceptions and return corresponding errors. temporary catch.
+        HostParallelScope host_parallel(resources);
         AMGX_ERROR rc = AMGX_OK;
         AMGX_RC rc0 = AMGX_RC_OK;
 
@@ -2976,30 +3711,22 @@ extern "C" {
             switch (mode)
             {
 #define AMGX_CASE_LINE(CASE) case CASE:{ \
-      rc0 = matrix_upload_all<CASE>(mtx,n,nnz,block_dimx,block_dimy,row_ptrs,col_indices,data,diag_data,resources); \
+      rc0 = matrix_upload_all_host<CASE>(mtx,n,nnz,block_dimx,block_dimy,row_ptrs,col_indices,data,diag_data,resources); \
     }                             \
     break;
-                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
-                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORALL_BUILDS_HOST(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS_HOST(AMGX_CASE_LINE)
 #undef AMGX_CASE_LINE
 
                 default:
-                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
-                    //return AMGX_RC_BAD_MODE;
+                    // device modes have to copy the data anyway, use AMGX_matrix_upload_all
+                    return AMGX_RC_NOT_SUPPORTED_TARGET;
             }
         }
 
         AMGX_CATCHES(rc)
         AMGX_CHECK_API_ERROR(rc, resources)
         return rc0;
-        //return getCAPIerror(rc);
-    }
-
-    AMGX_RC AMGX_API AMGX_matrix_upload_all(AMGX_matrix_handle mtx, int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag_data)
-    {
-        nvtxRange nvrf(__func__);
-
-        return AMGX_matrix_upload_all_impl(mtx, n, nnz, block_dimx, block_dimy, row_ptrs, col_indices, data, diag_data);
     }
 
     AMGX_RC AMGX_API AMGX_matrix_replace_coefficients(AMGX_matrix_handle mtx, int n, int nnz, const void *data, const void *diag_data)
@@ -3208,6 +3935,45 @@ extern "C" {
         //return getCAPIerror(rc);
     }
 
+    AMGX_RC AMGX_API AMGX_matrix_get_value_only_uploads(AMGX_matrix_handle mtx, int *count)
+    {
+        nvtxRange nvrf(__func__);
+
+        Resources *resources;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL)
+        AMGX_ERROR rc = AMGX_OK;
+
+        if (count == NULL)
+        {
+            AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+        }
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from<AMGX_matrix_handle>(mtx);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+        typedef TemplateMode<CASE>::Type TConfig; \
+        Matrix<TConfig> &A = *get_mode_object_from<CASE,Matrix,AMGX_matrix_handle>(mtx); \
+        *count = A.manager != NULL ? A.manager->getValueOnlyUploads() : 0; \
+        } \
+        break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+    }
+
 
 // previously: AMGX_vector_create(AMGX_vector_handle *ret, AMGX_Mode mode)
     AMGX_RC AMGX_vector_create_impl(AMGX_vector_handle *vec, AMGX_resources_handle rsc, AMGX_Mode mode)
@@ -3761,6 +4527,154 @@ extern "C" {
         return getCAPIerror_x(rc);
     }
 
+    AMGX_RC AMGX_API AMGX_solver_save_aggregates(AMGX_solver_handle slv, const char *filename)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_solver_save_aggregates " );
+        Resources *resources = NULL;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromSolverHandle(slv, &resources)), NULL)
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from(slv);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+          solver_save_aggregates<CASE>(slv, filename); \
+        } \
+        break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+    }
+
+    AMGX_RC AMGX_API AMGX_solver_load_aggregates(AMGX_solver_handle slv, const char *filename)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_solver_load_aggregates " );
+        Resources *resources = NULL;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromSolverHandle(slv, &resources)), NULL)
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from(slv);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+          solver_load_aggregates<CASE>(slv, filename); \
+        } \
+        break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+    }
+
+    AMGX_RC AMGX_API AMGX_solver_get_diagnostics(AMGX_solver_handle slv, int max_levels, AMGX_level_diagnostics *levels, int rate_aggregates, int *num_levels, double *grid_complexity, double *operator_complexity)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_solver_get_diagnostics " );
+        Resources *resources = NULL;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromSolverHandle(slv, &resources)), NULL)
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            if (max_levels > 0 && levels == NULL)
+            {
+                FatalError("levels must not be NULL when max_levels > 0", AMGX_ERR_BAD_PARAMETERS);
+            }
+
+            AMGX_Mode mode = get_mode_from(slv);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE: { \
+          solver_get_diagnostics<CASE>(slv, max_levels, levels, rate_aggregates, num_levels, grid_complexity, operator_complexity); \
+        } \
+        break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+                    AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_MODE, resources)
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+    }
+
+    AMGX_RC AMGX_API AMGX_solver_get_memory_report(AMGX_solver_handle slv, char *report, size_t *size)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_solver_get_memory_report " );
+        Resources *resources = NULL;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromSolverHandle(slv, &resources)), NULL)
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            if (size == NULL)
+            {
+                FatalError("size must not be NULL", AMGX_ERR_BAD_PARAMETERS);
+            }
+
+            std::vector<amgx::memory::MemoryReportEntry> entries;
+            size_t device_peak, pinned_peak;
+            amgx::memory::getMemoryReport(resources, entries, device_peak, pinned_peak);
+            std::stringstream ss;
+
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                ss << (entries[i].device ? "device," : "pinned,") << amgx::memory::getMemoryTagName(entries[i].tag) << ","
+                   << entries[i].level << "," << entries[i].current_bytes << "," << entries[i].peak_bytes << "\n";
+            }
+
+            const std::string text = ss.str();
+
+            if (report != NULL && *size > 0)
+            {
+                const size_t copied = std::min(text.size(), *size - 1);
+                std::copy(text.begin(), text.begin() + copied, report);
+                report[copied] = '\0';
+            }
+
+            *size = text.size() + 1;
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return AMGX_RC_OK;
+    }
+
     AMGX_RC AMGX_solver_register_print_callback(AMGX_print_callback func)
     {
         nvtxRange nvrf(__func__);
@@ -4437,6 +5351,75 @@ extern "C" {
         return AMGX_free_system_maps_one_ring_impl(row_ptrs, col_indices, data, diag_data, rhs, sol, num_neighbors, neighbors, btl_sizes, btl_maps, lth_sizes, lth_maps);
     }
 
+    AMGX_RC AMGX_API AMGX_partition_graph(int n, int nnz, const int *row_ptrs, const int *col_indices, int num_parts, int *partition_vector, int64_t *edge_cut)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_partition_graph " );
+
+        if (n < 0 || nnz < 0 || num_parts < 1 || row_ptrs == NULL || (nnz > 0 && col_indices == NULL) || (n > 0 && partition_vector == NULL))
+        {
+            AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, NULL)
+        }
+
+        AMGX_ERROR rc = AMGX_OK;
+
+        AMGX_TRIES()
+        {
+            int64_t cut = partitionGraphKway(n, row_ptrs, col_indices, num_parts, partition_vector);
+
+            if (edge_cut != NULL)
+            {
+                *edge_cut = cut;
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, NULL)
+        return AMGX_RC_OK;
+    }
+
+    AMGX_RC AMGX_API AMGX_generate_system(AMGX_matrix_handle mtx, AMGX_vector_handle rhs, AMGX_vector_handle sol, const char *problem, int nx, int ny, int nz, const char *options)
+    {
+        nvtxRange nvrf(__func__);
+
+        AMGX_CPU_PROFILER( "AMGX_generate_system " );
+        Resources *resources;
+        AMGX_CHECK_API_ERROR(getAMGXerror(getResourcesFromMatrixHandle(mtx, &resources)), NULL)
+        HostParallelScope host_parallel(resources);
+
+        if (problem == NULL || nx < 1 || ny < 1 || nz < 1)
+        {
+            AMGX_CHECK_API_ERROR(AMGX_ERR_BAD_PARAMETERS, resources)
+        }
+
+        AMGX_ERROR rc = AMGX_OK;
+        AMGX_RC rc0 = AMGX_RC_OK;
+
+        AMGX_TRIES()
+        {
+            AMGX_Mode mode = get_mode_from<AMGX_matrix_handle>(mtx);
+
+            switch (mode)
+            {
+#define AMGX_CASE_LINE(CASE) case CASE:{ \
+      rc0 = generate_system<CASE>(mtx,rhs,sol,problem,nx,ny,nz,options,resources); \
+    }                             \
+    break;
+                    AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+                default:
+                    // the generated problems are real
+                    return AMGX_RC_BAD_MODE;
+            }
+        }
+
+        AMGX_CATCHES(rc)
+        AMGX_CHECK_API_ERROR(rc, resources)
+        return rc0;
+    }
+
     AMGX_RC AMGX_matrix_comm_from_maps_one_ring_impl(   AMGX_matrix_handle mtx,
             int allocated_halo_depth,
             int max_num_neighbors,
@@ -4959,6 +5942,7 @@ extern "C" {
 
         AMGX_CATCHES(rc)
         AMGX_CHECK_API_ERROR(rc, resources);
+        HostParallelScope host_parallel(resources);
         std::string solver_value, solver_scope;
         resources->getResourcesConfig()->getParameter<std::string>("solver", solver_value, "default", solver_scope);
         int rhs_from_a;
@@ -5167,6 +6151,7 @@ extern "C" {
 
         AMGX_CATCHES(rc)
         AMGX_CHECK_API_ERROR(rc, resources);
+        HostParallelScope host_parallel(resources);
         std::string solver_value, solver_scope;
         resources->getResourcesConfig()->getParameter<std::string>("solver", solver_value, "default", solver_scope);
         int rhs_from_a;
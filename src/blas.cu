@@ -20,6 +20,9 @@
 #include <thrust/inner_product.h>
 #include <thrust_wrapper.h>
 #include <amgx_cublas.h>
+#include <global_thread_handle.h>
+#include <resources.h>
+#include <type_traits>
 #ifdef AMGX_USE_LAPACK
 #include "mkl.h"
 #endif
@@ -259,6 +262,278 @@ thrust_nrmmax(InputIterator first,
     return result;
 }
 
+/****************************************
+ * Reproducible reductions
+ *
+ * The range is cut into chunks of REPRO_CHUNK_SIZE elements. Within a chunk, lane t of
+ * REPRO_CTA_SIZE lanes accumulates elements t, t + REPRO_CTA_SIZE, ... in order and the lane sums
+ * are combined by a fixed halving tree. The chunk sums are reduced the same way until one value
+ * is left. The order of the additions only depends on the length of the range, not on the grid,
+ * the device or the number of host threads.
+ ***************************************/
+
+namespace
+{
+thread_local bool reproducible_reductions = false;
+}
+
+void setReproducibleReductions(bool enable)
+{
+    reproducible_reductions = enable;
+}
+
+bool getReproducibleReductions()
+{
+    return reproducible_reductions;
+}
+
+ReproducibleReductionsScope::ReproducibleReductionsScope(const Resources *res) : m_previous(reproducible_reductions)
+{
+    if (res != NULL)
+    {
+        reproducible_reductions = res->getReproducibleReductions();
+    }
+}
+
+ReproducibleReductionsScope::~ReproducibleReductionsScope()
+{
+    reproducible_reductions = m_previous;
+}
+
+const int REPRO_CTA_SIZE = 256;
+const int REPRO_ITEMS_PER_THREAD = 8;
+const int REPRO_CHUNK_SIZE = REPRO_CTA_SIZE * REPRO_ITEMS_PER_THREAD;
+
+inline long long repro_num_chunks(long long n)
+{
+    return (n + REPRO_CHUNK_SIZE - 1) / REPRO_CHUNK_SIZE;
+}
+
+template <typename T>
+struct dotc_term
+{
+    const T *a;
+    const T *b;
+
+    dotc_term(const T *_a, const T *_b) : a(_a), b(_b) {}
+
+    __host__ __device__
+    T operator()(long long i) const
+    {
+        return types::util<T>::conjugate(a[i]) * b[i];
+    }
+};
+
+template <typename T>
+struct nrm1_term
+{
+    const T *x;
+
+    nrm1_term(const T *_x) : x(_x) {}
+
+    __host__ __device__
+    typename types::PODTypes<T>::type operator()(long long i) const
+    {
+        return types::util<T>::abs(x[i]);
+    }
+};
+
+template <typename T>
+struct nrm2_term
+{
+    const T *x;
+
+    nrm2_term(const T *_x) : x(_x) {}
+
+    __host__ __device__
+    typename types::PODTypes<T>::type operator()(long long i) const
+    {
+        return norm_squared<T>()(x[i]);
+    }
+};
+
+template <typename T>
+struct partial_sum_term
+{
+    const T *x;
+
+    partial_sum_term(const T *_x) : x(_x) {}
+
+    __host__ __device__
+    T operator()(long long i) const
+    {
+        return x[i];
+    }
+};
+
+template <typename OutType, typename Term>
+__global__ void reproducible_chunk_sums_kernel(const long long n, const Term term, OutType *chunk_sums)
+{
+    __shared__ OutType s_sums[REPRO_CTA_SIZE];
+    const long long base = (long long)blockIdx.x * REPRO_CHUNK_SIZE + threadIdx.x;
+    OutType sum = types::util<OutType>::get_zero();
+#pragma unroll
+
+    for (int k = 0; k < REPRO_ITEMS_PER_THREAD; k++)
+    {
+        const long long i = base + k * REPRO_CTA_SIZE;
+
+        if (i < n) { sum = sum + term(i); }
+    }
+
+    s_sums[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (int width = REPRO_CTA_SIZE / 2; width > 0; width >>= 1)
+    {
+        if (threadIdx.x < width)
+        {
+            s_sums[threadIdx.x] = s_sums[threadIdx.x] + s_sums[threadIdx.x + width];
+        }
+
+        __syncthreads();
+    }
+
+    if (threadIdx.x == 0)
+    {
+        chunk_sums[blockIdx.x] = s_sums[0];
+    }
+}
+
+// host version of the kernel above, chunks are independent so they can go to any number of threads
+template <typename OutType, typename Term>
+void reproducible_chunk_sums_host(const long long n, const Term &term, OutType *chunk_sums)
+{
+    const long long num_chunks = repro_num_chunks(n);
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = threshold > 0 && (size_t)n >= threshold;
+    #pragma omp parallel for if (parallel)
+#endif
+    for (long long c = 0; c < num_chunks; c++)
+    {
+        OutType lanes[REPRO_CTA_SIZE];
+        const long long base = c * REPRO_CHUNK_SIZE;
+
+        for (int t = 0; t < REPRO_CTA_SIZE; t++)
+        {
+            lanes[t] = types::util<OutType>::get_zero();
+        }
+
+        for (int k = 0; k < REPRO_ITEMS_PER_THREAD; k++)
+        {
+            for (int t = 0; t < REPRO_CTA_SIZE; t++)
+            {
+                const long long i = base + k * REPRO_CTA_SIZE + t;
+
+                if (i < n) { lanes[t] = lanes[t] + term(i); }
+            }
+        }
+
+        for (int width = REPRO_CTA_SIZE / 2; width > 0; width >>= 1)
+        {
+            for (int t = 0; t < width; t++)
+            {
+                lanes[t] = lanes[t] + lanes[t + width];
+            }
+        }
+
+        chunk_sums[c] = lanes[0];
+    }
+}
+
+template <typename OutType, typename Term>
+OutType reproducible_sum(const long long n, const Term &term, std::false_type)
+{
+    if (n == 0) { return types::util<OutType>::get_zero(); }
+
+    std::vector<OutType> partials(repro_num_chunks(n));
+    reproducible_chunk_sums_host(n, term, partials.data());
+
+    while (partials.size() > 1)
+    {
+        std::vector<OutType> next(repro_num_chunks(partials.size()));
+        reproducible_chunk_sums_host((long long)partials.size(), partial_sum_term<OutType>(partials.data()), next.data());
+        partials.swap(next);
+    }
+
+    return partials[0];
+}
+
+// The passes run on the current stream. Unless blocking, the sum is copied to host_out, which then
+// has to be pinned memory, without waiting for the stream.
+template <typename OutType, typename Term>
+void reproducible_sum_device(const long long n, const Term &term, OutType *host_out, bool blocking)
+{
+    if (n == 0)
+    {
+        *host_out = types::util<OutType>::get_zero();
+        return;
+    }
+
+    cudaStream_t stream = amgx::thrust::global_thread_handle::get_stream();
+    long long num_partials = repro_num_chunks(n);
+    const long long second_size = repro_num_chunks(num_partials);
+    // the passes alternate between the two halves, each pass writes fewer values than the one before
+    OutType *buffer = 0;
+    amgx::memory::cudaMallocAsync((void **) &buffer, (num_partials + second_size) * sizeof(OutType));
+    cudaCheckError();
+    OutType *in = buffer;
+    OutType *out = buffer + num_partials;
+    reproducible_chunk_sums_kernel<OutType> <<< (int)num_partials, REPRO_CTA_SIZE, 0, stream>>>(n, term, in);
+    cudaCheckError();
+
+    while (num_partials > 1)
+    {
+        const long long num_next = repro_num_chunks(num_partials);
+        reproducible_chunk_sums_kernel<OutType> <<< (int)num_next, REPRO_CTA_SIZE, 0, stream>>>(num_partials, partial_sum_term<OutType>(in), out);
+        cudaCheckError();
+        std::swap(in, out);
+        num_partials = num_next;
+    }
+
+    if (blocking)
+    {
+        cudaMemcpy(host_out, in, sizeof(OutType), cudaMemcpyDeviceToHost);
+    }
+    else
+    {
+        cudaMemcpyAsync(host_out, in, sizeof(OutType), cudaMemcpyDeviceToHost, stream);
+    }
+
+    // later allocations from the pool are ordered behind the copy on the same stream
+    amgx::memory::cudaFreeAsync((void *) buffer);
+    cudaCheckError();
+}
+
+template <typename OutType, typename Term>
+OutType reproducible_sum(const long long n, const Term &term, std::true_type)
+{
+    OutType result;
+    reproducible_sum_device(n, term, &result, true);
+    return result;
+}
+
+template <int MemSpace, typename T>
+T reproducible_dotc(const T *a, const T *b, long long n)
+{
+    return reproducible_sum<T>(n, dotc_term<T>(a, b), std::integral_constant<bool, MemSpace == AMGX_device>());
+}
+
+template <int MemSpace, typename T>
+typename types::PODTypes<T>::type reproducible_nrm1(const T *x, long long n)
+{
+    typedef typename types::PODTypes<T>::type OutType;
+    return reproducible_sum<OutType>(n, nrm1_term<T>(x), std::integral_constant<bool, MemSpace == AMGX_device>());
+}
+
+template <int MemSpace, typename T>
+typename types::PODTypes<T>::type reproducible_nrm2(const T *x, long long n)
+{
+    typedef typename types::PODTypes<T>::type OutType;
+    return std::sqrt(reproducible_sum<OutType>(n, nrm2_term<T>(x), std::integral_constant<bool, MemSpace == AMGX_device>()));
+}
+
 template <typename ForwardIterator,
           typename ScalarType>
 void thrust_scal(ForwardIterator first,
@@ -640,6 +915,11 @@ typename Vector::value_type dotc(const Vector &a, const Vector &b, int offset, i
     int a_last = (offset + size) * a.get_block_size();
     int b_first = offset * a.get_block_size();
 
+    if (getReproducibleReductions())
+    {
+        return reproducible_dotc<TConfig::memSpace>(a.raw() + a_first, b.raw() + b_first, a_last - a_first);
+    }
+
     if (TConfig::memSpace == AMGX_host)
     {
         return thrust_dotc(a.begin() + a_first, a.begin() + a_last, b.begin() + b_first);
@@ -674,6 +954,11 @@ typename Vector::value_type dotc(const Vector &a, const Vector &b, int offseta,
     int a_last = (offseta + size) * a.get_block_size();
     int b_first = offsetb * a.get_block_size();
 
+    if (getReproducibleReductions())
+    {
+        return reproducible_dotc<TConfig::memSpace>(a.raw() + a_first, b.raw() + b_first, a_last - a_first);
+    }
+
     if (TConfig::memSpace == AMGX_host)
     {
         return thrust_dotc(a.begin() + a_first, a.begin() + a_last, b.begin() + b_first);
@@ -822,6 +1107,12 @@ nrm1(const Vector &x, int offset, int size)
     if (x.get_block_dimx() == -1) { FatalError("x block dims not set", AMGX_ERR_NOT_IMPLEMENTED); }
 
 #endif
+
+    if (getReproducibleReductions())
+    {
+        return reproducible_nrm1<Vector::TConfig::memSpace>(x.raw() + offset * x.get_block_size(), (long long)size * x.get_block_size());
+    }
+
     typename types::PODTypes<typename Vector::value_type>::type out =
         thrust_nrm1<Vector::TConfig::memSpace>(x.begin() + offset * x.get_block_size(),
                     x.begin() + (offset + size) * x.get_block_size());
@@ -841,6 +1132,12 @@ nrm1(const Vector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> > &
 
 #endif
     int bsize = x.get_block_size();
+
+    if (getReproducibleReductions())
+    {
+        return reproducible_nrm1<AMGX_host>(x.raw() + offset * bsize, (long long)size * bsize);
+    }
+
     typedef typename Vector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::value_type ValueType;
     typedef typename types::PODTypes<ValueType>::type OutType;
     OutType out = types::util<OutType>::get_zero();
@@ -868,6 +1165,12 @@ nrm2(const Vector &x, int offset, int size)
     typedef typename Vector::value_type value_type;
     int x_first = offset * x.get_block_size();
     int x_last = (offset + size) * x.get_block_size();
+
+    if (getReproducibleReductions())
+    {
+        return reproducible_nrm2<Vector::TConfig::memSpace>(x.raw() + x_first, x_last - x_first);
+    }
+
     // We are not using CUBLAS for nrm2 since the implementation is slower.
     return thrust_nrm2<Vector::TConfig::memSpace>(x.begin() + x_first,
                        x.begin() + x_last);
@@ -885,6 +1188,12 @@ nrm2(const Vector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> > &
 
 #endif
     int bsize = x.get_block_size();
+
+    if (getReproducibleReductions())
+    {
+        return reproducible_nrm2<AMGX_host>(x.raw() + offset * bsize, (long long)size * bsize);
+    }
+
     typedef typename Vector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::value_type ValueType;
     typedef typename types::PODTypes<ValueType>::type OutType;
     OutType out = types::util<OutType>::get_zero();
@@ -917,6 +1226,36 @@ nrmmax(const Vector &x, int offset, int size)
 }
 
 
+template <class Vector>
+void nrm_async(const Vector &x, bool squared, typename types::PODTypes<typename Vector::value_type>::type *host_out, int offset, int size)
+{
+    if (size == -1) { size = x.size() / x.get_block_size(); }
+
+#ifndef NDEBUG
+
+    if (x.get_block_dimx() == -1) { FatalError("x block dims not set", AMGX_ERR_NOT_IMPLEMENTED); }
+
+#endif
+    typedef typename Vector::value_type ValueType;
+    typedef typename types::PODTypes<ValueType>::type OutType;
+    const ValueType *x_raw = x.raw() + offset * x.get_block_size();
+    const long long n = (long long)size * x.get_block_size();
+
+    if (Vector::TConfig::memSpace == AMGX_host)
+    {
+        *host_out = squared ? reproducible_sum<OutType>(n, nrm2_term<ValueType>(x_raw), std::false_type())
+                    : reproducible_sum<OutType>(n, nrm1_term<ValueType>(x_raw), std::false_type());
+    }
+    else if (squared)
+    {
+        reproducible_sum_device(n, nrm2_term<ValueType>(x_raw), host_out, false);
+    }
+    else
+    {
+        reproducible_sum_device(n, nrm1_term<ValueType>(x_raw), host_out, false);
+    }
+}
+
 
 /****************************************
  * Explict instantiations
@@ -1037,6 +1376,11 @@ AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
 AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
 #undef AMGX_CASE_LINE
 
+#define AMGX_CASE_LINE(CASE) template void nrm_async(const Vector<TemplateMode<CASE>::Type>& x, bool, types::PODTypes<Vector<TemplateMode<CASE>::Type>::value_type>::type *, int, int);
+AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
 #define AMGX_CASE_LINE(CASE) template typename types::PODTypes<typename Vector<TemplateMode<CASE>::Type>::value_type>::type nrmmax(const Vector<TemplateMode<CASE>::Type>& x, int, int);
 AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
 AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
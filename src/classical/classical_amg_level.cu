@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <matrix_io.h>
+#include <matrix_analysis.h>
 
 #include <csr_multiply.h>
 
@@ -276,6 +277,7 @@ void Classical_AMG_Level_Base<T_Config>::createCoarseMatrices()
                 are reusing the level structure (structure_reuse_levels > 0) */
     if (this->isReuseLevel() == false)
     {
+        amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, this->getLevelIndex());
         computeProlongationOperator();
     }
 
@@ -285,6 +287,7 @@ void Classical_AMG_Level_Base<T_Config>::createCoarseMatrices()
         /* WARNING: see above warning. */
         if (this->isReuseLevel() == false)
         {
+            amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_TRANSFER, this->getLevelIndex());
             computeRestrictionOperator();
         }
 
@@ -434,6 +437,16 @@ void Classical_AMG_Level_Base<T_Config>::computeProlongationOperator()
     }
 }
 
+template <class T_Config>
+void Classical_AMG_Level_Base<T_Config>::computeDiagnostics(LevelDiagnostics &d, bool rate_aggregates)
+{
+    // the splitting itself is released after the interpolation is built, only the counts remain
+    d.num_coarse_points = this->m_num_coarse_vertices;
+    d.num_fine_points = this->getA().get_num_rows() - this->m_num_coarse_vertices;
+    d.cf_ratio = d.num_fine_points > 0 ? d.num_coarse_points / (double)d.num_fine_points : 0.;
+    MatrixAnalysis<TConfig>::interpolationDiagnostics(P, d);
+}
+
 /**********************************************
  * computes R=P^T
  **********************************************/
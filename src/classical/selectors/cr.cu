@@ -16,6 +16,7 @@
 #include <thrust/functional.h>
 #include <thrust/random.h>
 #include <thrust/transform.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust_wrapper.h>
 #include <solvers/block_common_solver.h>
 
@@ -590,7 +591,11 @@ void CR_Selector<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >
 ::markCoarseFinePoints_1x1( Matrix_d &A,
                             IVector &cf_map)
 {
-    if (A.hasProps(DIAG)) { FatalError("Unsupported separate diag", AMGX_ERR_NOT_IMPLEMENTED); }
+    if (A.hasProps(DIAG))
+    {
+        this->markCoarseFinePoints_BxB(A, cf_map);
+        return;
+    }
 
     typedef typename Matrix_d::index_type IndexType;
     typedef typename Matrix_d::value_type ValueType;
@@ -618,6 +623,431 @@ void CR_Selector<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >
 } // end markCoarseFinePoints_1x1 (device specialization)
 
 
+/*************************************************************************
+ * CR for block systems and separate diagonals (host and device)
+ ************************************************************************/
+
+// largest block the CR block Jacobi sweeps invert in registers
+#define CR_MAX_BLOCK_SIZE 8
+
+// Condenses every block row to a scalar row for the strength (the block
+// values themselves for 1x1, minus the Frobenius norms of the blocks
+// otherwise) and inverts the diagonal blocks for the relaxation.
+template <typename IndexType, typename ValueType>
+struct cr_condense_rows
+{
+    const IndexType *row_offsets;
+    const IndexType *col_indices;
+    const IndexType *diag;
+    const ValueType *values;
+    const int bs;
+    ValueType *cond;
+    ValueType *Dinv;
+
+    cr_condense_rows(const IndexType *_row_offsets, const IndexType *_col_indices, const IndexType *_diag,
+                     const ValueType *_values, int _bs, ValueType *_cond, ValueType *_Dinv)
+        : row_offsets(_row_offsets), col_indices(_col_indices), diag(_diag), values(_values), bs(_bs),
+          cond(_cond), Dinv(_Dinv) {}
+
+    __host__ __device__ static ValueType block_norm(const ValueType *b, int bs2)
+    {
+        ValueType sum(0);
+
+        for (int k = 0; k < bs2; k++)
+        {
+            sum += b[k] * b[k];
+        }
+
+        return sqrt(sum);
+    }
+
+    __host__ __device__ void operator()(const int i) const
+    {
+        const int bs2 = bs * bs;
+        const ValueType *d = values + (size_t) diag[i] * bs2;
+
+        for (int j = row_offsets[i]; j < row_offsets[i + 1]; j++)
+        {
+            cond[j] = (col_indices[j] == i) ? ValueType(0) : (bs == 1 ? values[j] : -block_norm(values + (size_t) j * bs2, bs2));
+        }
+
+        // Gauss-Jordan with partial pivoting
+        ValueType a[CR_MAX_BLOCK_SIZE * CR_MAX_BLOCK_SIZE];
+        ValueType *inv = Dinv + (size_t) i * bs2;
+
+        for (int r = 0; r < bs; r++)
+        {
+            for (int c = 0; c < bs; c++)
+            {
+                a[r * bs + c] = d[r * bs + c];
+                inv[r * bs + c] = (r == c) ? ValueType(1) : ValueType(0);
+            }
+        }
+
+        for (int c = 0; c < bs; c++)
+        {
+            int p = c;
+
+            for (int r = c + 1; r < bs; r++)
+            {
+                if (fabs(a[r * bs + c]) > fabs(a[p * bs + c])) { p = r; }
+            }
+
+            for (int k = 0; k < bs && p != c; k++)
+            {
+                ValueType t = a[c * bs + k];
+                a[c * bs + k] = a[p * bs + k];
+                a[p * bs + k] = t;
+                t = inv[c * bs + k];
+                inv[c * bs + k] = inv[p * bs + k];
+                inv[p * bs + k] = t;
+            }
+
+            ValueType piv = isNotCloseToZero(a[c * bs + c]) ? a[c * bs + c] : epsilon(a[c * bs + c]);
+
+            for (int k = 0; k < bs; k++)
+            {
+                a[c * bs + k] /= piv;
+                inv[c * bs + k] /= piv;
+            }
+
+            for (int r = 0; r < bs; r++)
+            {
+                ValueType f = a[r * bs + c];
+
+                if (r == c || f == ValueType(0)) { continue; }
+
+                for (int k = 0; k < bs; k++)
+                {
+                    a[r * bs + k] -= f * a[c * bs + k];
+                    inv[r * bs + k] -= f * inv[c * bs + k];
+                }
+            }
+        }
+    }
+};
+
+// a block is strong if its condensed value is below theta times the most negative one of the row
+template <typename IndexType, typename ValueType>
+struct cr_strength
+{
+    const IndexType *row_offsets;
+    const IndexType *col_indices;
+    const ValueType *cond;
+    const ValueType theta;
+    bool *strong;
+
+    cr_strength(const IndexType *_row_offsets, const IndexType *_col_indices, const ValueType *_cond, ValueType _theta, bool *_strong)
+        : row_offsets(_row_offsets), col_indices(_col_indices), cond(_cond), theta(_theta), strong(_strong) {}
+
+    __host__ __device__ void operator()(const int i) const
+    {
+        ValueType row_min(0);
+
+        for (int j = row_offsets[i]; j < row_offsets[i + 1]; j++)
+        {
+            row_min = cond[j] < row_min ? cond[j] : row_min;
+        }
+
+        for (int j = row_offsets[i]; j < row_offsets[i + 1]; j++)
+        {
+            strong[j] = col_indices[j] != i && cond[j] < ValueType(0) && cond[j] <= theta * row_min;
+        }
+    }
+};
+
+// one block Jacobi sweep on A_ff e_f = 0, the error is zero on the coarse points
+template <typename IndexType, typename ValueType, typename ValueTypeB>
+struct cr_relax_fine
+{
+    const IndexType *row_offsets;
+    const IndexType *col_indices;
+    const IndexType *diag;
+    const ValueType *values;
+    const ValueType *Dinv;
+    const int *cf_map;
+    const int bs;
+    const int num_rows;
+    const bool separate_diag;
+    const ValueTypeB omega;
+    const ValueTypeB *x;
+    ValueTypeB *y;
+
+    cr_relax_fine(const IndexType *_row_offsets, const IndexType *_col_indices, const IndexType *_diag, const ValueType *_values,
+                  const ValueType *_Dinv, const int *_cf_map, int _bs, int _num_rows, bool _separate_diag, ValueTypeB _omega,
+                  const ValueTypeB *_x, ValueTypeB *_y)
+        : row_offsets(_row_offsets), col_indices(_col_indices), diag(_diag), values(_values), Dinv(_Dinv), cf_map(_cf_map),
+          bs(_bs), num_rows(_num_rows), separate_diag(_separate_diag), omega(_omega), x(_x), y(_y) {}
+
+    __host__ __device__ void operator()(const int i) const
+    {
+        const int bs2 = bs * bs;
+
+        if (cf_map[i] == COARSE)
+        {
+            for (int r = 0; r < bs; r++)
+            {
+                y[i * bs + r] = ValueTypeB(0);
+            }
+
+            return;
+        }
+
+        ValueTypeB res[CR_MAX_BLOCK_SIZE];
+
+        for (int r = 0; r < bs; r++)
+        {
+            res[r] = ValueTypeB(0);
+        }
+
+        // the diagonal block is either in the row or stored after the nonzeros
+        for (int j = row_offsets[i]; j < row_offsets[i + 1] + (separate_diag ? 1 : 0); j++)
+        {
+            const int jj = (j < row_offsets[i + 1]) ? j : diag[i];
+            const int col = (j < row_offsets[i + 1]) ? col_indices[j] : i;
+
+            if (col >= num_rows)
+            {
+                continue;
+            }
+
+            for (int r = 0; r < bs; r++)
+            {
+                for (int c = 0; c < bs; c++)
+                {
+                    res[r] -= values[(size_t) jj * bs2 + r * bs + c] * x[col * bs + c];
+                }
+            }
+        }
+
+        for (int r = 0; r < bs; r++)
+        {
+            ValueTypeB corr(0);
+
+            for (int c = 0; c < bs; c++)
+            {
+                corr += Dinv[(size_t) i * bs2 + r * bs + c] * res[c];
+            }
+
+            y[i * bs + r] = x[i * bs + r] + omega * corr;
+        }
+    }
+};
+
+// x_i^T D_i x_i with the whole diagonal block D_i, one term per block row
+template <typename IndexType, typename ValueType, typename ValueTypeB>
+struct cr_energy_term
+{
+    const IndexType *diag;
+    const ValueType *values;
+    const int bs;
+    const ValueTypeB *x;
+
+    cr_energy_term(const IndexType *_diag, const ValueType *_values, int _bs, const ValueTypeB *_x)
+        : diag(_diag), values(_values), bs(_bs), x(_x) {}
+
+    __host__ __device__ ValueTypeB operator()(const int i) const
+    {
+        const ValueType *d = values + (size_t) diag[i] * bs * bs;
+        ValueTypeB sum(0);
+
+        for (int r = 0; r < bs; r++)
+        {
+            for (int c = 0; c < bs; c++)
+            {
+                sum += x[i * bs + r] * d[r * bs + c] * x[i * bs + c];
+            }
+        }
+
+        return sum;
+    }
+};
+
+// error restricted to the fine points: v_out = v_in on F, 0 on C
+template <typename ValueTypeB>
+struct cr_fine_part
+{
+    const int *cf_map;
+    const int bs;
+    const ValueTypeB *v_in;
+    ValueTypeB *v_out;
+
+    cr_fine_part(const int *_cf_map, int _bs, const ValueTypeB *_v_in, ValueTypeB *_v_out)
+        : cf_map(_cf_map), bs(_bs), v_in(_v_in), v_out(_v_out) {}
+
+    __host__ __device__ void operator()(const int k) const
+    {
+        v_out[k] = (cf_map[k / bs] == COARSE) ? ValueTypeB(0) : v_in[k];
+    }
+};
+
+// size of the smoothed error of a block row
+template <typename ValueTypeB>
+struct cr_block_error
+{
+    const int *cf_map;
+    const int bs;
+    const ValueTypeB *v;
+
+    cr_block_error(const int *_cf_map, int _bs, const ValueTypeB *_v) : cf_map(_cf_map), bs(_bs), v(_v) {}
+
+    __host__ __device__ ValueTypeB operator()(const int i) const
+    {
+        ValueTypeB sum(0);
+
+        for (int r = 0; r < bs && cf_map[i] == FINE; r++)
+        {
+            sum += v[i * bs + r] * v[i * bs + r];
+        }
+
+        return sqrt(sum);
+    }
+};
+
+// Candidates are the fine points whose error is at least theta times the largest one. A candidate
+// becomes coarse if its error (ties broken by a hash of the index) beats the one of every strongly
+// connected candidate, so the new coarse points are independent.
+template <typename IndexType, typename ValueTypeB>
+struct cr_select_coarse
+{
+    const IndexType *row_offsets;
+    const IndexType *col_indices;
+    const bool *strong;
+    const int *cf_map;
+    const ValueTypeB *err;
+    const ValueTypeB threshold;
+    const int num_rows;
+    int *cf_map_out;
+
+    cr_select_coarse(const IndexType *_row_offsets, const IndexType *_col_indices, const bool *_strong, const int *_cf_map,
+                     const ValueTypeB *_err, ValueTypeB _threshold, int _num_rows, int *_cf_map_out)
+        : row_offsets(_row_offsets), col_indices(_col_indices), strong(_strong), cf_map(_cf_map), err(_err),
+          threshold(_threshold), num_rows(_num_rows), cf_map_out(_cf_map_out) {}
+
+    __host__ __device__ static unsigned int hash(unsigned int a)
+    {
+        a = (a + 0x7ed55d16) + (a << 12);
+        a = (a ^ 0xc761c23c) + (a >> 19);
+        a = (a + 0x165667b1) + (a << 5);
+        a = (a ^ 0xd3a2646c) + (a << 9);
+        return a;
+    }
+
+    __host__ __device__ bool beats(int i, int j) const
+    {
+        return err[i] > err[j] || (err[i] == err[j] && hash(i) > hash(j));
+    }
+
+    __host__ __device__ void operator()(const int i) const
+    {
+        cf_map_out[i] = cf_map[i];
+
+        if (cf_map[i] != FINE || err[i] < threshold)
+        {
+            return;
+        }
+
+        for (int j = row_offsets[i]; j < row_offsets[i + 1]; j++)
+        {
+            const int col = col_indices[j];
+
+            if (strong[j] && col < num_rows && cf_map[col] == FINE && err[col] >= threshold && !beats(i, col))
+            {
+                return;
+            }
+        }
+
+        cf_map_out[i] = COARSE;
+    }
+};
+
+template <class T_Config>
+void CR_SelectorBase<T_Config>::markCoarseFinePoints_BxB(Matrix<TConfig> &A,
+        IVector &cf_map)
+{
+    typedef typename Vector<TConfig>::value_type ValueTypeB;
+    const int num_rows = (int) A.get_num_rows();
+    const int bs = A.get_block_dimy();
+
+    if (bs > CR_MAX_BLOCK_SIZE)
+    {
+        FatalError("Unsupported block size CR selector", AMGX_ERR_NOT_SUPPORTED_BLOCKSIZE);
+    }
+
+    if (num_rows == 0) { return; }
+
+    const int num_nz = (int) A.get_num_nz();
+    const int max_rounds = 10;        // max number of CR iterations
+    const int pre = 10;               // relaxation sweeps per convergence estimate
+    const ValueTypeB alpha = 0.7;     // target per-sweep convergence factor of the F-relaxation
+    const ValueTypeB rho_thresh = 1.0e-2;
+    const ValueTypeB omega = 0.7;     // damping of the block Jacobi sweeps
+    const ValueTypeB candidate_theta = 0.1;
+    amgx::thrust::counting_iterator<int> rows_begin(0), rows_end(num_rows), points_end(num_rows * bs);
+    // condensed scalar rows, strength and inverted diagonal blocks
+    VVector cond(num_nz), Dinv(num_rows * bs * bs);
+    BVector strong(num_nz);
+    thrust_wrapper::for_each<TConfig::memSpace>(rows_begin, rows_end,
+            cr_condense_rows<IndexType, ValueType>(A.row_offsets.raw(), A.col_indices.raw(), A.diag.raw(), A.values.raw(),
+                    bs, cond.raw(), Dinv.raw()));
+    thrust_wrapper::for_each<TConfig::memSpace>(rows_begin, rows_end,
+            cr_strength<IndexType, ValueType>(A.row_offsets.raw(), A.col_indices.raw(), cond.raw(), ValueType(0.25), strong.raw()));
+    cudaCheckError();
+    // all points start fine
+    thrust_wrapper::fill<TConfig::memSpace>(cf_map.begin(), cf_map.begin() + num_rows, (int) FINE);
+    Vector<TConfig> v_err(num_rows * bs), v_u(num_rows * bs), v_tmp(num_rows * bs), err(num_rows);
+    initRandom(v_err);
+    IVector cf_map_new(num_rows);
+    ValueTypeB norm0 = 0;
+
+    for (int round = 1; round <= max_rounds; round++)
+    {
+        // v_u = v_err(fine), normalized in the energy norm
+        thrust_wrapper::for_each<TConfig::memSpace>(rows_begin, points_end,
+                cr_fine_part<ValueTypeB>(cf_map.raw(), bs, v_err.raw(), v_u.raw()));
+
+        for (int k = 0; k <= 5; k++)
+        {
+            for (int sms = 0; sms < pre && k > 0; sms++)
+            {
+                thrust_wrapper::for_each<TConfig::memSpace>(rows_begin, rows_end,
+                        cr_relax_fine<IndexType, ValueType, ValueTypeB>(A.row_offsets.raw(), A.col_indices.raw(), A.diag.raw(),
+                                A.values.raw(), Dinv.raw(), cf_map.raw(), bs, num_rows, A.hasProps(DIAG), omega, v_u.raw(), v_tmp.raw()));
+                v_u.swap(v_tmp);
+            }
+
+            // norm in the block diagonal energy, ||v||_D^2 = sum_i v_i^T D_i v_i
+            norm0 = sqrt(thrust_wrapper::transform_reduce<TConfig::memSpace>(rows_begin, rows_end,
+                         cr_energy_term<IndexType, ValueType, ValueTypeB>(A.diag.raw(), A.values.raw(), bs, v_u.raw()), ValueTypeB(0), amgx::thrust::plus<ValueTypeB>()));
+            thrust_wrapper::transform<TConfig::memSpace>(v_u.begin(), v_u.end(), amgx::thrust::make_constant_iterator(norm0 + 1.0e-12),
+                    v_u.begin(), amgx::thrust::divides<ValueTypeB>());
+            cudaCheckError();
+
+            // norm0 := rho after the first sweeps
+            if (k > 0 && (norm0 > 5 || norm0 < rho_thresh)) { break; }
+        }
+
+        // norm0 is the factor of pre sweeps
+        if (pow(norm0, ValueTypeB(1) / pre) <= alpha && round > 1)
+        {
+            break;
+        }
+
+        // v_err(fine) = v_u
+        thrust_wrapper::copy<TConfig::memSpace>(v_u.begin(), v_u.end(), v_err.begin());
+        // add an independent set of the slowest converging fine points to the coarse set
+        thrust_wrapper::transform<TConfig::memSpace>(rows_begin, rows_end, err.begin(), cr_block_error<ValueTypeB>(cf_map.raw(), bs, v_u.raw()));
+        ValueTypeB err_max = thrust_wrapper::reduce<TConfig::memSpace>(err.begin(), err.end(), ValueTypeB(0), amgx::thrust::maximum<ValueTypeB>());
+        thrust_wrapper::for_each<TConfig::memSpace>(rows_begin, rows_end,
+                cr_select_coarse<IndexType, ValueTypeB>(A.row_offsets.raw(), A.col_indices.raw(), strong.raw(), cf_map.raw(),
+                        err.raw(), candidate_theta * err_max, num_rows, cf_map_new.raw()));
+        thrust_wrapper::copy<TConfig::memSpace>(cf_map_new.begin(), cf_map_new.end(), cf_map.begin());
+        cudaCheckError();
+
+        if (thrust_wrapper::count<TConfig::memSpace>(cf_map.begin(), cf_map.begin() + num_rows, (int) FINE) == 0) { break; }
+    }
+}
+
 template <class T_Config>
 void CR_SelectorBase<T_Config>::markCoarseFinePoints( Matrix<TConfig> &A,
         FVector &weights,
@@ -629,13 +1059,18 @@ void CR_SelectorBase<T_Config>::markCoarseFinePoints( Matrix<TConfig> &A,
     ViewType oldView = A.currentView();
     A.setView(OWNED);
 
+    if (A.get_block_dimx() != A.get_block_dimy())
+    {
+        FatalError("Unsupported block size CR selector", AMGX_ERR_NOT_SUPPORTED_BLOCKSIZE);
+    }
+
     if (A.get_block_size() == 1)
     {
         markCoarseFinePoints_1x1(A, cf_map);
     }
     else
     {
-        FatalError("Unsupported block size CR selector", AMGX_ERR_NOT_SUPPORTED_BLOCKSIZE);
+        markCoarseFinePoints_BxB(A, cf_map);
     }
 
     A.setView(oldView);
@@ -34,6 +34,8 @@ void HMIS_Selector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
     AMG_Config cfg;
     cfg.parseParameterString("use_opt_kernels=0");
     cfg.setParameter("use_opt_kernels", this->m_use_opt_kernels, "default");
+    cfg.setParameter("rs_num_domains", this->m_rs_num_domains, "default");
+    cfg.setParameter("rs_tie_break", this->m_rs_tie_break, "default");
     RS_Selector<TConfig_h> *rs_selector = new RS_Selector<TConfig_h>(cfg, "default");
     rs_selector->markCoarseFinePoints(A, weights, s_con, cf_map, scratch, cf_map_init);
     delete rs_selector;
@@ -69,6 +71,8 @@ void HMIS_Selector<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec>
     AMG_Config cfg;
     cfg.parseParameterString("use_opt_kernels=0");
     cfg.setParameter("use_opt_kernels", this->m_use_opt_kernels, "default");
+    cfg.setParameter("rs_num_domains", this->m_rs_num_domains, "default");
+    cfg.setParameter("rs_tie_break", this->m_rs_tie_break, "default");
     // Copy matrix to host
     // First call Ruge Steuben coarsening
     RS_Selector<TConfig_h> *rs_selector = new RS_Selector<TConfig_h>(cfg, "default");
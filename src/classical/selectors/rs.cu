@@ -7,7 +7,11 @@
 #include <cutil.h>
 #include <util.h>
 #include <types.h>
+#include <thrust_wrapper.h>
+#include <distributed/amgx_omp.h>
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #include<thrust/count.h>
 
@@ -17,97 +21,287 @@ namespace amgx
 namespace classical
 {
 /*************************************************************************
- * marks the strongest connected (and indepent) points as coarse
+ * Bucket priority queue on the RS measure with a pointer to the highest
+ * non-empty bucket, which only moves down as far as the measures moved up.
+ *
+ * By default each bucket is an ordered set and ties go to the smallest
+ * index, as with the std::set the first pass used before. With
+ * smallest_first == false each bucket is a doubly linked list, updates
+ * are O(1) and a whole first pass is O(nnz), but ties go to the point
+ * queued last.
  ************************************************************************/
+class RS_BucketQueue
+{
+    public:
+        RS_BucketQueue(int n, bool smallest_first) : m_next(n, -1), m_prev(n, -1), m_bucket(n, 0), m_top(0), m_smallest_first(smallest_first) {}
 
-typedef std::pair< int, int> pair_type; // give it a more meaningful name
+        void push(int i, int w)
+        {
+            if (w >= (int) m_head.size())
+            {
+                m_head.resize(std::max(2 * (int) m_head.size(), w + 1), -1);
 
-struct compare
-{
-    bool operator()(const pair_type &a, const pair_type &b) const
-    {
-        if (a.first < b.first) { return true; }
-        else if ( (a.first == b.first) && (b.second < a.second) ) { return true; }
-        else { return false; }
-    }
+                if (m_smallest_first) { m_sets.resize(m_head.size()); }
+            }
+
+            m_bucket[i] = w;
+            m_top = std::max(m_top, w);
+
+            if (m_smallest_first)
+            {
+                m_sets[w].insert(i);
+                return;
+            }
+
+            m_prev[i] = -1;
+            m_next[i] = m_head[w];
+
+            if (m_head[w] >= 0) { m_prev[m_head[w]] = i; }
+
+            m_head[w] = i;
+        }
+
+        // no-op if i is not queued
+        void remove(int i)
+        {
+            int w = m_bucket[i];
+
+            if (w == 0) { return; }
+
+            m_bucket[i] = 0;
+
+            if (m_smallest_first)
+            {
+                m_sets[w].erase(i);
+                return;
+            }
+
+            if (m_prev[i] >= 0) { m_next[m_prev[i]] = m_next[i]; }
+            else { m_head[w] = m_next[i]; }
+
+            if (m_next[i] >= 0) { m_prev[m_next[i]] = m_prev[i]; }
+        }
+
+        void update(int i, int w)
+        {
+            remove(i);
+
+            if (w > 0) { push(i, w); }
+        }
+
+        // point with the largest weight, -1 if the queue is empty
+        int top()
+        {
+            if (m_smallest_first)
+            {
+                while (m_top > 0 && m_sets[m_top].empty()) { m_top--; }
+
+                return m_top > 0 ? *m_sets[m_top].begin() : -1;
+            }
+
+            while (m_top > 0 && m_head[m_top] < 0) { m_top--; }
+
+            return m_top > 0 ? m_head[m_top] : -1;
+        }
+
+    private:
+        std::vector<int> m_head, m_next, m_prev, m_bucket;
+        std::vector<std::set<int> > m_sets;
+        int m_top;
+        bool m_smallest_first;
 };
 
-template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
-void RS_Selector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
-::markCoarseFinePoints_1x1(Matrix_h &A,
-                           FVector &weights,
-                           const BVector &s_con,
-                           IVector &cf_map,
-                           IVector &scratch,
-                           int cf_map_init)
+/*************************************************************************
+ * Classical RS first pass over the UNASSIGNED points of [begin, end),
+ * following only the strong connections inside the range. ST holds the
+ * transpose of S for the rows of the range (local rows, global columns)
+ * and i_weights the initial measures (local).
+ ************************************************************************/
+template <class Matrix_h, class BVector, class IVector>
+void rsFirstPass(const Matrix_h &A, const BVector &s_con, IVector &cf_map, int begin, int end,
+                 const std::vector<int> &ST_row_offsets, const std::vector<int> &ST_col_indices,
+                 std::vector<int> &i_weights, bool smallest_first)
 {
-    // Create matrix S_T (for each vertex a list of
-    int num_rows = A.get_num_rows();
-    int num_nz = A.col_indices.size();
-    IVector ST_row_offsets(num_rows + 1);
-    IVector ST_col_indices(num_nz);
+    RS_BucketQueue nodes_list(end - begin, smallest_first);
 
-    for (int i = 0; i <= num_rows; i++)
+    for (int j = begin; j < end; j++)
     {
-        ST_row_offsets[i] = 0;
+        if (cf_map[j] == UNASSIGNED && i_weights[j - begin] > 0)
+        {
+            nodes_list.push(j - begin, i_weights[j - begin]);
+        }
     }
 
-    for (int i = 0; i < num_nz; i++)
+    // nothing depends on these, make them fine and count them as a dependent of their neighbours
+    for (int j = begin; j < end; j++)
     {
-        int col = A.col_indices[i];
+        if (cf_map[j] != UNASSIGNED || i_weights[j - begin] > 0)
+        {
+            continue;
+        }
 
-        if (s_con[i] && col < num_rows)
+        cf_map[j] = FINE;
+
+        for (int k = A.row_offsets[j]; k < A.row_offsets[j + 1]; k++)
         {
-            ST_row_offsets[col + 1]++;
+            int neighbor = A.col_indices[k];
+
+            if (s_con[k] && neighbor >= begin && neighbor < end && cf_map[neighbor] == UNASSIGNED)
+            {
+                nodes_list.update(neighbor - begin, ++i_weights[neighbor - begin]);
+            }
         }
     }
 
-    for (int i = 0; i < num_rows; i++)
+    int top;
+
+    while ((top = nodes_list.top()) >= 0)
     {
-        ST_row_offsets[i + 1] += ST_row_offsets[i];
+        int index = top + begin;
+        cf_map[index] = COARSE;
+        nodes_list.remove(top);
+
+        for (int j = ST_row_offsets[top]; j < ST_row_offsets[top + 1]; j++)
+        {
+            int neighbor = ST_col_indices[j];
+
+            if (cf_map[neighbor] == UNASSIGNED)
+            {
+                cf_map[neighbor] = FINE;
+                nodes_list.remove(neighbor - begin);
+
+                for (int k = A.row_offsets[neighbor]; k < A.row_offsets[neighbor + 1]; k++)
+                {
+                    int d2_neighbor = A.col_indices[k];
+
+                    if (s_con[k] && d2_neighbor >= begin && d2_neighbor < end && cf_map[d2_neighbor] == UNASSIGNED)
+                    {
+                        nodes_list.update(d2_neighbor - begin, ++i_weights[d2_neighbor - begin]);
+                    }
+                }
+            }
+        }
+
+        for (int j = A.row_offsets[index]; j < A.row_offsets[index + 1]; j++)
+        {
+            int neighbor = A.col_indices[j];
+
+            if (!s_con[j] || neighbor < begin || neighbor >= end || cf_map[neighbor] != UNASSIGNED)
+            {
+                continue;
+            }
+
+            int weight = --i_weights[neighbor - begin];
+            nodes_list.update(neighbor - begin, weight);
+
+            if (weight <= 0)
+            {
+                cf_map[neighbor] = FINE;
+
+                for (int k = A.row_offsets[neighbor]; k < A.row_offsets[neighbor + 1]; k++)
+                {
+                    int d2_neighbor = A.col_indices[k];
+
+                    if (s_con[k] && d2_neighbor >= begin && d2_neighbor < end && cf_map[d2_neighbor] == UNASSIGNED)
+                    {
+                        nodes_list.update(d2_neighbor - begin, ++i_weights[d2_neighbor - begin]);
+                    }
+                }
+            }
+        }
     }
+}
 
-    for (int i = 0; i < num_rows; i++)
+/*************************************************************************
+ * Transpose of the strong connections between the rows of [begin, end)
+ ************************************************************************/
+template <class Matrix_h, class BVector>
+void buildStrongTranspose(const Matrix_h &A, const BVector &s_con, int begin, int end,
+                          std::vector<int> &ST_row_offsets, std::vector<int> &ST_col_indices)
+{
+    ST_row_offsets.assign(end - begin + 1, 0);
+
+    for (int i = begin; i < end; i++)
     {
-        for (int j = A.row_offsets[i]; j < A.row_offsets[i + 1]; j++)
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1]; k++)
         {
-            int col = A.col_indices[j];
+            int col = A.col_indices[k];
 
-            if (s_con[j] && col < num_rows)
+            if (s_con[k] && col >= begin && col < end)
             {
-                ST_col_indices[ST_row_offsets[col]] = i;
-                ST_row_offsets[col]++;
+                ST_row_offsets[col - begin + 1]++;
             }
         }
     }
 
-    for (int i = num_rows; i > 0; i--)
+    for (int i = 0; i < end - begin; i++)
     {
-        ST_row_offsets[i] = ST_row_offsets[i - 1];
+        ST_row_offsets[i + 1] += ST_row_offsets[i];
     }
 
-    ST_row_offsets[0] = 0;
-    // Compute the measure, which is row length of S_T
-    IVector i_weights(num_rows);
+    ST_col_indices.resize(ST_row_offsets[end - begin]);
+    std::vector<int> pos(ST_row_offsets.begin(), ST_row_offsets.end() - 1);
 
-    for (int i = 0; i < num_rows; i++)
+    for (int i = begin; i < end; i++)
     {
-        i_weights[i] = ST_row_offsets[i + 1] - ST_row_offsets[i];
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1]; k++)
+        {
+            int col = A.col_indices[k];
+
+            if (s_con[k] && col >= begin && col < end)
+            {
+                ST_col_indices[pos[col - begin]++] = i;
+            }
+        }
     }
+}
 
-    // Initialize the map
-    int num_left = 0;
+/*************************************************************************
+ * marks the strongest connected (and indepent) points as coarse
+ *
+ * With m_num_domains != 1 the rows are split in contiguous blocks that are
+ * coarsened independently on host threads. As in Falgout coarsening, the
+ * decisions on the points with strong connections across blocks are then
+ * dropped and those points are coarsened again with the global graph,
+ * starting from the interior C points.
+ ************************************************************************/
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void RS_Selector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
+::markCoarseFinePoints_1x1(Matrix_h &A,
+                           FVector &weights,
+                           const BVector &s_con,
+                           IVector &cf_map,
+                           IVector &scratch,
+                           int cf_map_init)
+{
+    int num_rows = A.get_num_rows();
+    int num_domains = this->m_num_domains;
+
+    if (num_domains <= 0)
+    {
+#ifdef AMGX_WITH_OPENMP
+        num_domains = omp_get_max_threads();
+#else
+        num_domains = 1;
+#endif
+    }
+
+    num_domains = std::max(1, std::min(num_domains, num_rows));
+    std::vector<char> isolated_rows(num_rows, 0);
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = num_domains > 1 && threshold > 0 && (size_t) num_rows >= threshold;
+    #pragma omp parallel for if (parallel)
+#endif
 
     for (int j = 0; j < num_rows; j++)
     {
-        int isolated = true;
+        bool isolated = true;
 
         for (int k = A.row_offsets[j]; k < A.row_offsets[j + 1]; k++)
         {
             // Only consider interior connections
-            int col = A.col_indices[k];
-
-            if (col < num_rows && s_con[k] )
+            if (A.col_indices[k] < num_rows && s_con[k])
             {
                 isolated = false;
                 break;
@@ -116,149 +310,189 @@ void RS_Selector<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
 
         if (isolated)
         {
-            if (cf_map_init == 3) { cf_map[j] = COARSE; }
-            else { cf_map[j] = STRONG_FINE; }
-
-            i_weights[j] = 0;
+            cf_map[j] = (cf_map_init == 3) ? COARSE : STRONG_FINE;
+            isolated_rows[j] = 1;
         }
         else
         {
             cf_map[j] = UNASSIGNED;
-            num_left++;
         }
     }
 
-    std::set<pair_type, compare> nodes_list;
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for schedule(static, 1) if (parallel)
+#endif
 
-    for (int j = 0; j < num_rows; j++)
+    for (int d = 0; d < num_domains; d++)
     {
-        int weight = i_weights[j];
+        int begin = (int) ((long long) num_rows * d / num_domains);
+        int end = (int) ((long long) num_rows * (d + 1) / num_domains);
+        std::vector<int> ST_row_offsets, ST_col_indices;
+        buildStrongTranspose(A, s_con, begin, end, ST_row_offsets, ST_col_indices);
+        // the measure is the row length of S_T
+        std::vector<int> i_weights(end - begin);
+
+        for (int i = 0; i < end - begin; i++)
+        {
+            i_weights[i] = ST_row_offsets[i + 1] - ST_row_offsets[i];
+        }
 
-        if (cf_map[j] != STRONG_FINE)
+        rsFirstPass(A, s_con, cf_map, begin, end, ST_row_offsets, ST_col_indices, i_weights, this->m_tie_break == 0);
+    }
+
+    if (num_domains == 1)
+    {
+        return;
+    }
+
+    // boundary points: strong connections to another block, in either direction
+    std::vector<int> domain_begin(num_domains + 1);
+
+    for (int d = 0; d <= num_domains; d++)
+    {
+        domain_begin[d] = (int) ((long long) num_rows * d / num_domains);
+    }
+
+    std::vector<char> boundary(num_rows, 0);
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for schedule(static, 1) if (parallel)
+#endif
+
+    for (int d = 0; d < num_domains; d++)
+    {
+        for (int i = domain_begin[d]; i < domain_begin[d + 1]; i++)
         {
-            if (weight > 0)
+            for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1] && !boundary[i]; k++)
             {
-                nodes_list.insert(pair_type(weight, j));
+                int col = A.col_indices[k];
+                boundary[i] = s_con[k] && col < num_rows && (col < domain_begin[d] || col >= domain_begin[d + 1]);
             }
-            else
-            {
-                cf_map[j] = FINE;
+        }
+    }
 
-                for (int k = A.row_offsets[j]; k < A.row_offsets[j + 1]; k++)
-                {
-                    int neighbor = A.col_indices[k];
+    // the rows with cross connections are few, their columns are marked serially
+    std::vector<int> cross_rows;
 
-                    if (s_con[k] && neighbor < num_rows)
-                    {
-                        if (cf_map[neighbor] != STRONG_FINE)
-                        {
-                            if (neighbor < j)
-                            {
-                                int new_weight = i_weights[neighbor];
-
-                                if (new_weight > 0)
-                                {
-                                    nodes_list.erase(pair_type(new_weight, neighbor));
-                                }
-
-                                new_weight = ++(i_weights[neighbor]);
-                                nodes_list.insert(pair_type(new_weight, neighbor));
-                            }
-                            else
-                            {
-                                int new_weight = ++(i_weights[neighbor]);
-                            }
-                        }
-                    } // if s_con
-                }
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (boundary[i] == 1) { cross_rows.push_back(i); }
+    }
 
-                --num_left;
+    for (int r = 0; r < (int) cross_rows.size(); r++)
+    {
+        int i = cross_rows[r];
+
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1]; k++)
+        {
+            if (s_con[k] && A.col_indices[k] < num_rows && !boundary[A.col_indices[k]])
+            {
+                boundary[A.col_indices[k]] = 2;
             }
         }
     }
 
-    // First pass of Ruge Steuben coarsening
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for if (parallel)
+#endif
 
-    while (num_left > 0)
+    for (int i = 0; i < num_rows; i++)
     {
-        int index = nodes_list.rbegin()->second;
-        cf_map[index] = COARSE;
-        int weight = i_weights[index];
-        i_weights[index] = 0;
-        --num_left;
-        nodes_list.erase(pair_type(weight, index));
+        if (boundary[i] && !isolated_rows[i]) { cf_map[i] = UNASSIGNED; }
+    }
+
+    // fine points that lost their coarse neighbours are coarsened again, the boundary points
+    // already covered by an interior C point become fine
+    std::vector<int> new_cf_map(cf_map.begin(), cf_map.end());
+    std::vector<char> candidate(num_rows, 0);
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for if (parallel)
+#endif
 
-        for (int j = ST_row_offsets[index]; j < ST_row_offsets[index + 1]; j++)
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (cf_map[i] != FINE && cf_map[i] != UNASSIGNED)
         {
-            int neighbor = ST_col_indices[j];
+            continue;
+        }
 
-            if (cf_map[neighbor] == UNASSIGNED)
-            {
-                cf_map[neighbor] = FINE;
-                int weight = i_weights[neighbor];
-                nodes_list.erase(pair_type(weight, neighbor));
-                --num_left;
+        bool covered = false;
 
-                for (int k = A.row_offsets[neighbor]; k < A.row_offsets[neighbor + 1]; k++)
-                {
-                    int d2_neighbor = A.col_indices[k];
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1] && !covered; k++)
+        {
+            covered = s_con[k] && A.col_indices[k] < num_rows && cf_map[A.col_indices[k]] == COARSE;
+        }
 
-                    if (s_con[k] && d2_neighbor < num_rows)
-                    {
-                        if (cf_map[d2_neighbor] == UNASSIGNED)
-                        {
-                            int weight = i_weights[d2_neighbor];
-                            nodes_list.erase(pair_type(weight, d2_neighbor));
-                            int new_weight = ++(i_weights[d2_neighbor]);
-                            //printf("d2_neighbor = %d, new_weight = %d \n",d2_neighbor,new_weight);
-                            nodes_list.insert(pair_type(new_weight, d2_neighbor));
-                        }
-                    }
-                }
-            }
+        new_cf_map[i] = covered ? FINE : UNASSIGNED;
+    }
+
+    std::copy(new_cf_map.begin(), new_cf_map.end(), cf_map.begin());
+    // the points depending on what is left are the only ones the measure needs
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for if (parallel)
+#endif
+
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (cf_map[i] != FINE && cf_map[i] != UNASSIGNED)
+        {
+            continue;
         }
 
-        for (int j = A.row_offsets[index]; j < A.row_offsets[index + 1]; j++)
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1] && !candidate[i]; k++)
         {
-            int neighbor = A.col_indices[j];
+            candidate[i] = s_con[k] && A.col_indices[k] < num_rows && cf_map[A.col_indices[k]] == UNASSIGNED;
+        }
+    }
+
+    // RS on the remaining points with the global graph, measure |S_T^U| + 2 |S_T^F|
+    std::vector<int> ST_row_offsets(num_rows + 1, 0), ST_col_indices, dependents;
+    std::vector<int> i_weights(num_rows, 0);
+
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (candidate[i]) { dependents.push_back(i); }
+    }
 
-            if (s_con[j] && neighbor < num_rows)
+    for (int r = 0; r < (int) dependents.size(); r++)
+    {
+        int i = dependents[r];
+
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1]; k++)
+        {
+            int col = A.col_indices[k];
+
+            if (s_con[k] && col < num_rows && cf_map[col] == UNASSIGNED)
             {
-                if (cf_map[neighbor] == UNASSIGNED)
-                {
-                    int weight = i_weights[neighbor];
-                    nodes_list.erase(pair_type(weight, neighbor));
-                    i_weights[neighbor] = --weight;
+                ST_row_offsets[col + 1]++;
+                i_weights[col] += (cf_map[i] == FINE) ? 2 : 1;
+            }
+        }
+    }
 
-                    if (weight > 0)
-                    {
-                        nodes_list.insert(pair_type(weight, neighbor));
-                    }
-                    else
-                    {
-                        cf_map[neighbor] = FINE;
-                        --num_left;
-
-                        for (int k = A.row_offsets[neighbor]; k < A.row_offsets[neighbor + 1]; k++)
-                        {
-                            int d2_neighbor = A.col_indices[k];
-
-                            if (s_con[k] && d2_neighbor < num_rows)
-                            {
-                                if (cf_map[d2_neighbor] == UNASSIGNED)
-                                {
-                                    int new_weight = i_weights[d2_neighbor];
-                                    nodes_list.erase(pair_type(new_weight, d2_neighbor));
-                                    new_weight = ++(i_weights[d2_neighbor]);
-                                    nodes_list.insert(std::pair<const int, int>(new_weight, d2_neighbor));
-                                }
-                            }
-                        }
-                    }
-                }
-            } // if s_con
+    for (int i = 0; i < num_rows; i++)
+    {
+        ST_row_offsets[i + 1] += ST_row_offsets[i];
+    }
+
+    ST_col_indices.resize(ST_row_offsets[num_rows]);
+    std::vector<int> pos(ST_row_offsets.begin(), ST_row_offsets.end() - 1);
+
+    for (int r = 0; r < (int) dependents.size(); r++)
+    {
+        int i = dependents[r];
+
+        for (int k = A.row_offsets[i]; k < A.row_offsets[i + 1]; k++)
+        {
+            int col = A.col_indices[k];
+
+            if (s_con[k] && col < num_rows && cf_map[col] == UNASSIGNED)
+            {
+                ST_col_indices[pos[col]++] = i;
+            }
         }
     }
+
+    rsFirstPass(A, s_con, cf_map, 0, num_rows, ST_row_offsets, ST_col_indices, i_weights, this->m_tie_break == 0);
 }
 
 /*************************************************************************
@@ -273,7 +507,20 @@ void RS_Selector<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >:
         IVector &scratch,
         int cf_map_init)
 {
-    FatalError("Ruge Steuben coarsening not implemented on GPU (it's a sequential algorithm)", AMGX_ERR_NOT_IMPLEMENTED);
+    // RS is a sequential algorithm, run it on the host like HMIS does
+    Matrix_h A_h = A;
+    FVector_h weights_h = weights;
+    BVector_h s_con_h = s_con;
+    IVector_h scratch_h = scratch;
+    IVector_h cf_map_h = cf_map;
+    AMG_Config cfg;
+    cfg.parseParameterString("use_opt_kernels=0");
+    cfg.setParameter("use_opt_kernels", this->m_use_opt_kernels, "default");
+    cfg.setParameter("rs_num_domains", this->m_num_domains, "default");
+    cfg.setParameter("rs_tie_break", this->m_tie_break, "default");
+    RS_Selector<TConfig_h> rs_selector(cfg, "default");
+    rs_selector.markCoarseFinePoints(A_h, weights_h, s_con_h, cf_map_h, scratch_h, cf_map_init);
+    cf_map = cf_map_h;
 }
 
 template <class T_Config>
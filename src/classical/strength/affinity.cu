@@ -23,6 +23,8 @@
 #include <thrust/random.h>
 
 #include <sm_utils.inl>
+#include <solvers/block_common_solver.h>
+#include <distributed/amgx_omp.h>
 /*
 * Note:
 * This implementation assumes that off-diag entries all have the opposite sign
@@ -51,16 +53,20 @@ Strength_Affinity<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >
     std::string default_cfg_scope = "default";
     affinity_iters = cfg.AMG_Config::template getParameter<int>("affinity_iterations", cfg_scope);
     n_TV = cfg.AMG_Config::template getParameter<int>("affinity_vectors", cfg_scope);
-
-    if (n_TV > 32)
-    {
-        FatalError("Strength affinity: Test vectors > 32 is not supported, exiting", AMGX_ERR_NOT_SUPPORTED_TARGET);
-    }
-
+    m_max_TV = std::max(n_TV, 32);
     solver = new MulticolorGaussSeidelSolver<TConfig_d>(cfg, cfg_scope);
     this->solver->set_max_iters(affinity_iters);
 }
 
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+Strength_Affinity<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::Strength_Affinity(AMG_Config &cfg,
+        const std::string &cfg_scope)  : Strength_AffinityBase<TConfig_h>(cfg, cfg_scope)
+{
+    affinity_iters = cfg.AMG_Config::template getParameter<int>("affinity_iterations", cfg_scope);
+    n_TV = cfg.AMG_Config::template getParameter<int>("affinity_vectors", cfg_scope);
+    m_max_TV = std::max(n_TV, 32);
+}
+
 /*************************************************************************
 * "random" hash function for both device and host
 ************************************************************************/
@@ -118,88 +124,24 @@ static __device__ __inline__ T cahedRead (const T *ar)
     return utils::Ld<utils::LD_NC>::load(ar);
 }
 
-// ! shfl is defined for int/float only in arch 600
 template< typename ValueType >
-__forceinline__ __device__ void reduce_inwarp_mul(
-    const ValueType vValueA,
-    const ValueType vValueB,
-    const int vecId,
-    const int n_per_warp,
-    volatile ValueType *smem,
-    double *s_xy)
+__forceinline__ __device__ ValueType warp_sum(ValueType sum)
 {
-    ValueType sum = vValueA * vValueB;
 #pragma unroll
 
-    for ( int offset = 16 / n_per_warp ; offset > 0 ; offset /= 2 )
-    {
-        sum += utils::shfl_xor(sum, offset, 16);
-    }
-
-    *s_xy = sum;
-}
-
-template< typename ValueType >
-__forceinline__ __device__ void reduce_inblock_mul(
-    const int blockSize,
-    const ValueType vValueA,
-    const ValueType vValueB,
-    const int vecId,
-    const int n_per_block,
-    volatile ValueType *smem,
-    double *s_xy)
-{
-    ValueType sum = vValueA * vValueB;
-    smem[threadIdx.x] = sum;
-    __syncthreads();
-
-    if (blockSize >= 512)
+    for ( int offset = 16 ; offset > 0 ; offset /= 2 )
     {
-        if (vecId < 256 / n_per_block)
-        {
-            smem[threadIdx.x] = sum = sum + smem[threadIdx.x + 256 / n_per_block];
-        }
-
-        __syncthreads();
-    }
-
-    if (blockSize >= 256)
-    {
-        if (vecId < 128 / n_per_block)
-        {
-            smem[threadIdx.x] = sum = sum + smem[threadIdx.x + 128 / n_per_block];
-        }
-
-        __syncthreads();
+        sum += utils::shfl_xor(sum, offset);
     }
 
-    if (blockSize >= 128)
-    {
-        if (vecId <  64 / n_per_block)
-        {
-            smem[threadIdx.x] = sum = sum + smem[threadIdx.x +  64 / n_per_block];
-        }
-
-        __syncthreads();
-    }
-
-#pragma unroll
-
-    for ( int offset = 16  ; offset > 0 ; offset /= 2 )
-        if ( vecId < offset )
-        {
-            smem[threadIdx.x] = sum = sum + smem[threadIdx.x + offset];
-        }
-
-    if ( vecId == 0 )
-    {
-        // If laneId=0, then sum is in smem[threadIdx.x].
-        *s_xy = sum;
-    }
+    return sum;
 }
 
 /*************************************************************************
 * Computes affinity matrix (device)
+*
+* One warp per row, the lanes stride over the test vectors so there is no
+* limit on their number. The three dots of an edge are reduced in the warp.
 ************************************************************************/
 
 template< typename IndexType, typename ValueTypeA, typename ValueTypeB, int kCtaSize >
@@ -212,50 +154,50 @@ void computeAffinity_1x1_Kernel(const int *A_rows,
                                 ValueTypeA *affinity
                                )
 {
-    const ValueTypeB epsilon = 1.e-12;
-    const int tid =  blockDim.x * blockIdx.x + threadIdx.x;
-    const int vid = tid % nTV;
-    const int num_vecs_per_warp = 32 / nTV;
-    const int num_rows_per_iter = gridDim.x * blockDim.x / nTV;
-    //const int num_vecs_per_block = blockDim.x / nTV;
-    ValueTypeB *smem = NULL;
-    double s_xx, s_xy, s_yy;
-
-    for ( int aRowId = tid / nTV ; aRowId < A_num_rows ;
+    const double epsilon = 1.e-12;
+    const int num_warps = kCtaSize / 32;
+    const int num_rows_per_iter = num_warps * gridDim.x;
+    const int warpId = threadIdx.x / 32;
+    const int laneId = threadIdx.x % 32;
+
+    for ( int aRowId = blockIdx.x * num_warps + warpId ; aRowId < A_num_rows ;
             aRowId += num_rows_per_iter )
     {
-        const int aRowBegin = A_rows[aRowId];
-        const int aRowEnd   = A_rows[aRowId + 1];
-        ValueTypeB vValueA = X[aRowId * nTV + vid];
-        reduce_inwarp_mul(vValueA, vValueA, vid, num_vecs_per_warp, smem, &s_xx);
-#if 0
+        const ValueTypeB *x = X + (size_t) aRowId * nTV;
+        double s_xx = 0.;
 
-        if (num_vecs_per_warp > 0)
-        {
-            reduce_inwarp_mul(vValueA, vValueA, vid, num_vecs_per_warp, smem, &s_xx);
-        }
-        else
+        for ( int vid = laneId ; vid < nTV ; vid += 32 )
         {
-            reduce_inblock_mul(kCtaSize, vValueA, vValueA, vid, num_vecs_per_block, smem, &s_xx);
+            s_xx += (double) x[vid] * x[vid];
         }
 
-#endif
+        s_xx = warp_sum(s_xx);
 
-        for ( IndexType aRowIt = aRowBegin ; aRowIt <  aRowEnd;
-                aRowIt++ )
+        for ( IndexType aRowIt = A_rows[aRowId] ; aRowIt < A_rows[aRowId + 1] ; aRowIt++ )
         {
             IndexType aColId = A_cols[aRowIt];
 
-            if (aColId != aRowId)
+            if (aColId == aRowId)
             {
-                ValueTypeB vValueB = cahedRead(X + aColId * nTV + vid);
-                reduce_inwarp_mul(vValueA, vValueB, vid, num_vecs_per_warp, smem, &s_xy);
-                reduce_inwarp_mul(vValueB, vValueB, vid, num_vecs_per_warp, smem, &s_yy);
+                continue;
+            }
 
-                if (vid == 0)
-                {
-                    affinity[aRowIt] = (s_xy * s_xy / (s_xx * s_yy + epsilon));
-                }
+            const ValueTypeB *y = X + (size_t) aColId * nTV;
+            double s_xy = 0., s_yy = 0.;
+
+            for ( int vid = laneId ; vid < nTV ; vid += 32 )
+            {
+                double yv = cahedRead(y + vid);
+                s_xy += x[vid] * yv;
+                s_yy += yv * yv;
+            }
+
+            s_xy = warp_sum(s_xy);
+            s_yy = warp_sum(s_yy);
+
+            if (laneId == 0)
+            {
+                affinity[aRowIt] = (s_xy * s_xy / (s_xx * s_yy + epsilon));
             }
         }
     }
@@ -429,7 +371,7 @@ computeStrongConnectionsAndWeights_1x1(Matrix_d &A,
     }
     else
     {
-        this->n_TV = min(level_counter, 32);
+        this->n_TV = min(level_counter, m_max_TV);
         unsigned int nTV_num_rows = this->n_TV * A.get_num_rows();
         m_rhs.resize(nTV_num_rows, 0.0);
 
@@ -512,6 +454,158 @@ computeStrongConnectionsAndWeights_1x1(Matrix_d &A,
 }
 
 
+/*************************************************************************
+* Computes the strength matrix and the connection weights (host)
+*
+* The test vectors are relaxed together with weighted Jacobi on A x = 0, one
+* SpMM per sweep, and the affinities use a batched dot per edge.
+************************************************************************/
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec,
+          AMGX_IndPrecision t_indPrec>
+void Strength_Affinity<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::
+computeStrongConnectionsAndWeights_1x1(Matrix_h &A,
+                                       BVector &s_con,
+                                       FVector &weights,
+                                       const double max_row_sum)
+{
+    typedef typename Vector<TConfig_h>::value_type ValueTypeB;
+    bool level_opt_flag = ((int) max_row_sum != -1);
+    const int num_rows = A.get_num_rows();
+
+    if (!is_random_initialized)
+    {
+        initRandom(m_x, this->n_TV * num_rows);
+
+        if (level_opt_flag) { is_random_initialized = true; }
+
+        level_counter = n_TV;
+    }
+    else
+    {
+        this->n_TV = std::min(level_counter, m_max_TV);
+
+        if (m_x.size() < this->n_TV * num_rows)
+        {
+            initRandom(m_x, this->n_TV * num_rows);
+        }
+    }
+
+    level_counter *= 2;
+    const int nTV = this->n_TV;
+    const ValueTypeB omega = ValueTypeB(2) / ValueTypeB(3);
+    m_x_new.resize(m_x.size());
+    // with an external diagonal A.diag points past the off-diagonal entries of the row
+    const bool external_diag = A.hasProps(DIAG);
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = threshold > 0 && (size_t) A.get_num_nz() * nTV >= threshold;
+#endif
+
+    for (int iter = 0; iter < affinity_iters; iter++)
+    {
+#ifdef AMGX_WITH_OPENMP
+        #pragma omp parallel for if (parallel)
+#endif
+
+        for (int row = 0; row < num_rows; row++)
+        {
+            const ValueTypeB *x = m_x.raw();
+            ValueTypeB *y = m_x_new.raw() + (size_t) row * nTV;
+            ValueType diag = A.values[A.diag[row]];
+
+            for (int v = 0; v < nTV; v++)
+            {
+                y[v] = external_diag ? diag * x[(size_t) row * nTV + v] : ValueTypeB(0);
+            }
+
+            for (int j = A.row_offsets[row]; j < A.row_offsets[row + 1]; j++)
+            {
+                const int col = A.col_indices[j];
+
+                if (col >= num_rows) { continue; }
+
+                const ValueType a = A.values[j];
+
+                for (int v = 0; v < nTV; v++)
+                {
+                    y[v] += a * x[(size_t) col * nTV + v];
+                }
+            }
+
+            diag = isNotCloseToZero(diag) ? diag : epsilon(diag);
+
+            for (int v = 0; v < nTV; v++)
+            {
+                y[v] = x[(size_t) row * nTV + v] - omega * y[v] / diag;
+            }
+        }
+
+        m_x.swap(m_x_new);
+    }
+
+    m_aff_values.resize(A.get_num_nz());
+#ifdef AMGX_WITH_OPENMP
+    #pragma omp parallel for if (parallel)
+#endif
+
+    for (int row = 0; row < num_rows; row++)
+    {
+        const ValueTypeB *x = m_x.raw() + (size_t) row * nTV;
+        double s_xx = 0.;
+        ValueType maxVal(0);
+
+        for (int v = 0; v < nTV; v++)
+        {
+            s_xx += (double) x[v] * x[v];
+        }
+
+        for (int j = A.row_offsets[row]; j < A.row_offsets[row + 1]; j++)
+        {
+            const int col = A.col_indices[j];
+
+            if (col == row || col >= num_rows)
+            {
+                m_aff_values[j] = ValueType(0);
+                continue;
+            }
+
+            const ValueTypeB *y = m_x.raw() + (size_t) col * nTV;
+            double s_xy = 0., s_yy = 0.;
+
+            for (int v = 0; v < nTV; v++)
+            {
+                s_xy += (double) x[v] * y[v];
+                s_yy += (double) y[v] * y[v];
+            }
+
+            m_aff_values[j] = s_xy * s_xy / (s_xx * s_yy + 1.e-12);
+            maxVal = std::max(maxVal, m_aff_values[j]);
+        }
+
+        const ValueType threshold = maxVal * this->alpha;
+
+        for (int j = A.row_offsets[row]; j < A.row_offsets[row + 1]; j++)
+        {
+            s_con[j] = A.col_indices[j] != row && m_aff_values[j] > threshold;
+        }
+    }
+
+    // sum of the columns of S, with a random number to break ties
+    for (int row = 0; row < num_rows; row++)
+    {
+        weights[row] += A.is_matrix_singleGPU() ? ourHash(row) : ourHash((int) A.manager->base_index() + row);
+
+        for (int j = A.row_offsets[row]; j < A.row_offsets[row + 1]; j++)
+        {
+            if (s_con[j] && A.col_indices[j] < num_rows)
+            {
+                weights[A.col_indices[j]] += 1.0f;
+            }
+        }
+    }
+}
+
+
 /****************************************
  * Explict instantiations
  ***************************************/
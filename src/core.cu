@@ -69,6 +69,7 @@
 #include <classical/selectors/pmis.h>
 #include <classical/selectors/aggressive_pmis.h>
 #include <classical/selectors/hmis.h>
+#include <classical/selectors/rs.h>
 #include <classical/selectors/aggressive_hmis.h>
 #include <classical/selectors/dummy_selector.h>
 #include <classical/selectors/cr.h>
@@ -331,11 +332,19 @@ inline void registerParameters()
     AMG_Config::registerParameter<int>("num_streams", "number of additional CUDA streams / threads used for async execution", 0);
     AMG_Config::registerParameter<int>("serialize_threads", "flag that enables thread serialization for debugging <0|1>", 0, bool_flag_values);
     AMG_Config::registerParameter<int>("high_priority_stream", "flag that enables high priority CUDA stream <0|1>", 0, bool_flag_values);
+    AMG_Config::registerParameter<int>("host_parallel_threshold", "minimum number of elements for which host loops run on OpenMP threads, and host sorts, scans, reductions and transforms on the OpenMP backend in builds with AMGX_HOST_OPENMP, 0 keeps them sequential", 32768);
+    AMG_Config::registerParameter<int>("reproducible_reductions", "flag that makes dot products and norms sum in a fixed order, so results are bitwise identical for any number of host threads or GPU multiprocessors <0|1>", 0, bool_flag_values);
+    AMG_Config::registerParameter<int>("memory_accounting", "flag that accounts the device and pinned host allocations of the solvers on these resources to the subsystem and hierarchy level that made them, reported by print_grid_stats and AMGX_solver_get_memory_report <0|1>", 0, bool_flag_values);
+    AMG_Config::registerParameter<int>("setup_cache_size", "number of coarse-grid structures kept by the resources for reuse by solvers set up on a matrix with a known sparsity pattern and configuration, 0 disables the cache", 0);
     //Register System Parameters (in distributed setting)
     std::vector<std::string> communicator_values;
     communicator_values.push_back("MPI");
     communicator_values.push_back("MPI_DIRECT");
     AMG_Config::registerParameter<std::string>("communicator", "type of communicator <MPI|MPI_DIRECT>", "MPI");
+    std::vector<std::string> read_partitioner_values;
+    read_partitioner_values.push_back("EQUAL_ROWS");
+    read_partitioner_values.push_back("GRAPH");
+    AMG_Config::registerParameter<std::string>("read_partitioner", "partitioning used by AMGX_read_system_distributed when no partition vector is given <EQUAL_ROWS|GRAPH>", "EQUAL_ROWS", read_partitioner_values);
     std::vector<ViewType> viewtype_values;
     viewtype_values.push_back(INTERIOR);
     viewtype_values.push_back(OWNED);
@@ -389,6 +398,12 @@ inline void registerParameters()
     //[F]GMRES
     AMG_Config::registerParameter<int>("gmres_n_restart", "the number of Krylov vectors used in FGMRES or GMRES solver ", 20);
     AMG_Config::registerParameter<int>("gmres_krylov_dim", "maximum size fo the krylov subspace. Can be smaller than restart, in that case the algorithm minimizes the quasi residual (QGMRES). Set to zero to automatically match the restart <0>", 0);
+    std::vector<std::string> gmres_basis_storage_values;
+    gmres_basis_storage_values.push_back("FULL");
+    gmres_basis_storage_values.push_back("FLOAT");
+    gmres_basis_storage_values.push_back("BFLOAT16");
+    AMG_Config::registerParameter<std::string>("gmres_basis_storage", "precision the Krylov basis vectors of GMRES and FGMRES are kept in between iterations, orthogonalization is always carried out in the working precision. Compressed storage needs real values and, for FGMRES, gmres_krylov_dim=0 <FULL|FLOAT|BFLOAT16>", "FULL", gmres_basis_storage_values);
+    AMG_Config::registerParameter<int>("fgmres_fixed_preconditioner", "flag that tells FGMRES the preconditioner is a fixed linear operator, so the preconditioned vectors are not stored and the preconditioner is applied once more to the combination of the basis at the end of each restart cycle. Needs gmres_krylov_dim=0 <0|1>", 0, bool_flag_values);
     //IDR
     AMG_Config::registerParameter<int>("subspace_dim_s", "the number of dimensions of the small system ", 8);
     //DENSE_LU_SOLVER
@@ -421,6 +436,7 @@ inline void registerParameters()
     algorithm_values.push_back(ENERGYMIN);
     AMG_Config::registerParameter<AlgorithmType>("algorithm", "the AMG algorithm <CLASSICAL,AGGREGATION,ENERGYMIN>", CLASSICAL, algorithm_values);
     AMG_Config::registerParameter<int>("amg_host_levels_rows", "levels with number of rows below this number will be solved on host. -1 to disable", -1);
+    AMG_Config::registerParameter<int>("amg_host_levels_auto", "flag to place the coarse levels of a device hierarchy on the host where a cycle cost model, calibrated by timing the smoother and SpMV of each level on both memory spaces during setup, predicts a cheaper cycle. Replaces amg_host_levels_rows <0|1>", 0, bool_flag_values);
     //Register Cycle Parameters
     AMG_Config::registerParameter<std::string>("cycle", "the cycle algorithm <V|W|F|CG|CGF>", "V", getAllCycles());
     AMG_Config::registerParameter<int>("max_levels", "the maximum number of levels", 100);
@@ -442,6 +458,7 @@ inline void registerParameters()
     AMG_Config::registerParameter<int>("reuse_scale", "option to reuse the scale for the <x> next iterations. <0>", 0 );
     AMG_Config::registerParameter<int>("scaling_smoother_steps", "how many smoothing steps should be applied to the error before computing the scale. <2>", 2);
     AMG_Config::registerParameter<int>("intensive_smoothing", "drastically increases smoothing iterations number", 0);
+    AMG_Config::registerParameter<int>("fused_cycle_kernels", "flag that lets the cycle compute and restrict the residual in one pass, and fold the prolongated correction into the first post-smoothing sweep, on levels and smoothers that support it (aggregation, scalar, single GPU, JACOBI_L1 smoother for the correction) <0|1>", 0, bool_flag_values);
     //Register Interpolator Parameters
     //Aggregation (Coarse Generators)
     std::vector<std::string> coarse_gen_values = getAllCoarseGenerators();
@@ -456,13 +473,15 @@ inline void registerParameters()
     //Register Selector (SIZE_[2|4|8]) Parameters
     std::vector<std::string> classical_selector_values = getClassicalSelectors(), aggregation_selector_values = getAggregationSelectors(), combined_selectors = classical_selector_values;
     combined_selectors.insert(combined_selectors.end(), aggregation_selector_values.begin(), aggregation_selector_values.end());
-    AMG_Config::registerParameter<std::string>("selector", "the coarse grid selection algorithm (Classical: <PMIS|AGGRESSIVE_PMIS|HMIS|AGGRESSIVE_HMIS|DUMMY>, Aggregation: <SIZE_2|SIZE_4|SIZE_8|MULTI_PAIRWISE>)", "PMIS", combined_selectors);
+    AMG_Config::registerParameter<std::string>("selector", "the coarse grid selection algorithm (Classical: <PMIS|AGGRESSIVE_PMIS|HMIS|AGGRESSIVE_HMIS|RS|DUMMY>, Aggregation: <SIZE_2|SIZE_4|SIZE_8|MULTI_PAIRWISE>)", "PMIS", combined_selectors);
     AMG_Config::registerParameter<int>("aggressive_levels", "the number of levels to use aggressive coarsening for (Classical only)", 0);
     AMG_Config::registerParameter<std::string>("aggressive_selector", "the aggressive coarse grid selection algorithm, DEFAULT is same as \"selector\" (Classical only) <PMIS|HMIS|DEFAULT>", "DEFAULT", classical_selector_values);
     AMG_Config::registerParameter<std::string>("aggressive_interpolator", "the interpolation algorithm for aggressive coarsening (Classical only) <MULTIPASS>", "MULTIPASS", classical_selector_values);
     AMG_Config::registerParameter<int>("handshaking_phases", "number of handshaking phases for aggregation step, valid values are 1 or 2 phases <1>", 1);
     AMG_Config::registerParameter<int>("aggregation_edge_weight_component", "The component in the block matrices to use to compute the edge weights in the aggregation procedure <0>", 0);
     AMG_Config::registerParameter<int>("max_matching_iterations", "the maximum number of 'matching' iterations in the size2_selector, size4_selector and size8_selector algorithms <15>", 15);
+    AMG_Config::registerParameter<int>("rs_num_domains", "for selector=RS or HMIS: number of contiguous row blocks the Ruge-Stueben first pass is split into and coarsened in parallel on host threads, the points coupled across blocks are coarsened again afterwards. 0 uses one block per OpenMP thread <1>", 1);
+    AMG_Config::registerParameter<int>("rs_tie_break", "for selector=RS or HMIS: point the Ruge-Stueben first pass makes coarse among equal measures. 0: smallest index, 1: last queued, O(1) queue updates <0>", 0, 0, 1);
     AMG_Config::registerParameter<double>("max_unassigned_percentage", "the maximum percentage of vertices that are left unaggregated in first phase of matching algorithms <0.05>", 0.05);
     //Register Selector (MULTI_PAIRWISE) Parameters
     AMG_Config::registerParameter<int>("weight_formula", "choose the weight formula. 0: wij=0.5*(|a_ij|+|aji|)/max(|a_ii|,|a_jj|). 1: wij=-0.5(a_ij/a_ii + a_ji/a_jj) <0>", 0);
@@ -533,6 +552,8 @@ inline void registerParameters()
     AMG_Config::registerParameter<int>("print_vis_data", "flag that allows to print information about the solver convergence <0|1>", 0);
     AMG_Config::registerParameter<int>("print_aggregation_info", "flag that allows to print additional information about aggregation AMG hierarchy<0|1>", 0);
     AMG_Config::registerParameter<int>("obtain_timings", "flag that cause the solvers to print total setup and solve times <0|1>", 0);
+    AMG_Config::registerParameter<int>("convergence_check_frequency", "number of iterations between two convergence checks of a solver, the last iteration is always checked", 1);
+    AMG_Config::registerParameter<int>("convergence_check_lag", "number of convergence checks by which the decision lags behind the norm computation, the norms are copied to the host without synchronizing (single GPU, scalar L1 and L2 norms), 0 checks synchronously", 0);
     AMG_Config::registerParameter<int>("store_res_history", "flag that allows to store the residual history of a solver solver <0|1>", 0);
     AMG_Config::registerParameter<int>("convergence_analysis", "number of levels that will be analysed. 0=no analysis, 1=only finest, 2=finest and second finest etc. <0>", 0);
     // Register Matrix scaling parameters
@@ -645,6 +666,7 @@ struct registerClasses<T_Config, false>
         classical::SelectorFactory<T_Config>::registerFactory("AGGRESSIVE_PMIS", new classical::Aggressive_PMIS_SelectorFactory<T_Config>);
         classical::SelectorFactory<T_Config>::registerFactory("HMIS", new classical::HMIS_SelectorFactory<T_Config>);
         classical::SelectorFactory<T_Config>::registerFactory("AGGRESSIVE_HMIS", new classical::Aggressive_HMIS_SelectorFactory<T_Config>);
+        classical::SelectorFactory<T_Config>::registerFactory("RS", new classical::RS_SelectorFactory<T_Config>);
         classical::SelectorFactory<T_Config>::registerFactory("DUMMY", new classical::Dummy_SelectorFactory<T_Config>);
         classical::SelectorFactory<T_Config>::registerFactory("CR", new classical::CR_SelectorFactory<T_Config>);
         //Energymin (Selectors)
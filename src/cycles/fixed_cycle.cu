@@ -124,9 +124,16 @@ void FixedCycle<T_Config, CycleDispatcher>::cycle( AMG_Class *amg, AMG_Level<T_C
             r.set_block_dimx(1);
             int offset, size;
             A.getOffsetAndSizeForView(OWNED, &offset, &size);
-            //compute residual
+            const bool fused_kernels = amg->getFusedCycleKernels();
+            //compute residual, restricting it in the same pass when the level supports it
             level->Profile.tic("ComputeResidual");
-            axmb(A, x, b, r, offset, size);
+            const bool restricted = fused_kernels && level->computeAndRestrictResidual(b, x, r, bc);
+
+            if (!restricted)
+            {
+                axmb(A, x, b, r, offset, size);
+            }
+
             level->Profile.toc("ComputeResidual");
             //apply restriction
             // in classical the current level is consolidated while in aggregation this is the next one.
@@ -145,9 +152,12 @@ void FixedCycle<T_Config, CycleDispatcher>::cycle( AMG_Class *amg, AMG_Level<T_C
                 isRootPartition_flag = A.manager->isRootPartition();
             }
 
-            level->Profile.tic("restrictRes");
-            level->restrictResidual(r, bc);
-            level->Profile.toc("restrictRes");
+            if (!restricted)
+            {
+                level->Profile.tic("restrictRes");
+                level->restrictResidual(r, bc);
+                level->Profile.toc("restrictRes");
+            }
 
             // we have to be very carreful with !A.is_matrix_singleGPU() by A.is_matrix_distributed().
             // In classical consolidation we want to use A.is_matrix_distributed() in order to consolidateVector / unconsolidateVector
@@ -185,34 +195,44 @@ void FixedCycle<T_Config, CycleDispatcher>::cycle( AMG_Class *amg, AMG_Level<T_C
                 level->unconsolidateVector(xc);
             }
 
-            //prolongate correction
-            level->prolongateAndApplyCorrection(xc, bc, x, r);
-            level->Profile.toc("proCorr");
-            //post smooth
-            *smoothing_direction = 1;
-            level->Profile.tic("Smoother");
+            int n_postsweeps;
+
+            if (level->isFinest() && amg->getNumFinestsweeps() != -1)
             {
-                AMGX_CPU_PROFILER( "FixedCycle::cycle_@postmooth" );
-                int n_postsweeps;
+                n_postsweeps = amg->getNumPostsweeps() == 0 ? 0 : amg->getNumFinestsweeps();
+            }
+            else
+            {
+                n_postsweeps = amg->getNumPostsweeps();
 
-                if (level->isFinest() && amg->getNumFinestsweeps() != -1)
+                if (amg->getNumPostsweeps() != 0 && amg->getIntensiveSmoothing())
                 {
-                    n_postsweeps = amg->getNumPostsweeps() == 0 ? 0 : amg->getNumFinestsweeps();
+                    n_postsweeps = std::max(n_postsweeps + levelnum - 2, 0);
                 }
-                else
-                {
-                    n_postsweeps = amg->getNumPostsweeps();
+            }
 
-                    if (amg->getNumPostsweeps() != 0 && amg->getIntensiveSmoothing())
-                    {
-                        n_postsweeps = std::max(n_postsweeps + levelnum - 2, 0);
-                    }
-                }
+            if ( amg->m_cfg->AMG_Config::template getParameter<int>( "error_scaling", amg->m_cfg_scope ) > 3 )
+            {
+                n_postsweeps = 0;
+            }
 
-                if ( amg->m_cfg->AMG_Config::template getParameter<int>( "error_scaling", amg->m_cfg_scope ) > 3 )
-                {
-                    n_postsweeps = 0;
-                }
+            //prolongate correction, folded into the first post-smoothing sweep when the level and smoother support it
+            *smoothing_direction = 1;
+
+            if ( fused_kernels && n_postsweeps > 0 && level->prolongateAndSmooth(xc, b, x, smoother) )
+            {
+                n_postsweeps--;
+            }
+            else
+            {
+                level->prolongateAndApplyCorrection(xc, bc, x, r);
+            }
+
+            level->Profile.toc("proCorr");
+            //post smooth
+            level->Profile.tic("Smoother");
+            {
+                AMGX_CPU_PROFILER( "FixedCycle::cycle_@postmooth" );
 
                 if ( n_postsweeps > 0 )
                 {
@@ -113,6 +113,7 @@ template <class T>
 void CommsMPIHostBufferStream<T_Config>::do_setup(T &b, const Matrix<TConfig> &m, int num_rings)
 {
 #ifdef AMGX_WITH_MPI
+    amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_COMMS);
     int bsize = b.get_block_size();
     int num_cols = b.get_num_cols();
 
@@ -213,6 +214,7 @@ template <class T>
 void CommsMPIHostBufferStream<T_Config>::do_setup_L2H(T &b, Matrix<TConfig> &m, int num_rings)
 {
 #ifdef AMGX_WITH_MPI
+    amgx::memory::MemoryTagScope memory_tag(amgx::memory::MEMORY_TAG_COMMS);
     int num_neighbors = m.manager->neighbors.size();
     int bsize = b.get_block_size();
     b.requests.resize(2 * num_neighbors);
@@ -1051,34 +1051,16 @@ void DistributedManager<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indP
 }
 
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
-template <typename t_colIndex>
-std::map<t_colIndex, int> DistributedManager<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::loadDistributed_LocalToGlobal(int num_rows, I64Vector_h &off_diag_cols)
+void DistributedManager<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::loadDistributed_LocalToGlobal(int num_rows, I64Vector_h &off_diag_cols, GlobalToLocalMap &global_to_local)
 {
-    // sort global column indices
-    amgx::thrust::sort(off_diag_cols.begin(), off_diag_cols.end());
-    // find unique columns and set local <-> global mappings
-    // 1) Removed unneeded vector 2) Create map on host first, upload later (less thrust calls)
+    // deduplicate global column indices through the hash map, so only the unique halo columns have to be sorted,
+    // local halo indices follow ascending global order
     I64Vector_h local_to_global_h;
-    std::map<t_colIndex, int> global_to_local;        // temporary
-
-    if (off_diag_cols.size() > 0)
-    {
-        global_to_local[off_diag_cols[0]] = num_rows;
-        local_to_global_h.push_back(off_diag_cols[0]);
-    }
+    global_to_local.renumber(off_diag_cols.raw(), off_diag_cols.size(), num_rows, local_to_global_h);
 
-    for (int i = 1; i < off_diag_cols.size(); i++)
-    {
-        if (off_diag_cols[i] != off_diag_cols[i - 1])
-        {
-            global_to_local[off_diag_cols[i]] = num_rows + local_to_global_h.size();
-            local_to_global_h.push_back(off_diag_cols[i]);
-        }
-    }
     // Upload finished map in one piece
     this->local_to_global_map.resize(local_to_global_h.size());
     amgx::thrust::copy(local_to_global_h.begin(), local_to_global_h.end(), this->local_to_global_map.begin());
-    return global_to_local;
 }
 
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
@@ -1202,45 +1184,44 @@ void DistributedManager<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indP
 
     int h_cidx_allocated = 0;
     const t_colIndex *h_col_indices_global = (const t_colIndex *)this->getHostPointerForData(col_indices, num_nonzeros * sizeof(t_colIndex), &h_cidx_allocated);
-    // gather all off-diag columns
+    // gather all off-diag columns and, in the same pass, set 1 for my local columns (scanned below to compute local row indices)
     I64Vector_h off_diag_cols;
+    IVector_h my_indices(num_rows_global);
 
     for (int i = 0; i < num_nonzeros; i++)
     {
-        if (partitionVec[h_col_indices_global[i]] != my_id)
+        t_colIndex col_index = h_col_indices_global[i];
+
+        if (partitionVec[col_index] != my_id)
         {
-            off_diag_cols.push_back(ipartition_map[h_col_indices_global[i]]);
+            off_diag_cols.push_back(ipartition_map[col_index]);
         }
-    }
-
-    auto global_to_local = loadDistributed_LocalToGlobal<t_colIndex>(num_rows, off_diag_cols);
-
-    // set 1, then scan to compute local row indices
-    IVector_h my_indices(num_rows_global);
-
-    for (int i = 0; i < num_nonzeros; i++)
-    {
-        if (partitionVec[h_col_indices_global[i]] == my_id)     // find my local columns and set to 1
+        else
         {
-            my_indices[ipartition_map[h_col_indices_global[i]]] = 1;
+            my_indices[ipartition_map[col_index]] = 1;
         }
     }
 
+    GlobalToLocalMap global_to_local;
+    loadDistributed_LocalToGlobal(num_rows, off_diag_cols, global_to_local);
     thrust_wrapper::exclusive_scan<AMGX_host>(my_indices.begin(), my_indices.end(), my_indices.begin());
     // remap colums to local
     IVector_h local_col_indices(num_nonzeros);
 
+    #pragma omp parallel for
     for (int i = 0; i < num_nonzeros; i++)
     {
-        if (partitionVec[h_col_indices_global[i]] != my_id)
+        t_colIndex col_index = h_col_indices_global[i];
+
+        if (partitionVec[col_index] != my_id)
         {
             // off-diag
-            local_col_indices[i] = global_to_local[ipartition_map[h_col_indices_global[i]]];
+            local_col_indices[i] = global_to_local[ipartition_map[col_index]];
         }
         else
         {
             // diag
-            local_col_indices[i] = my_indices[ipartition_map[h_col_indices_global[i]]];
+            local_col_indices[i] = my_indices[ipartition_map[col_index]];
         }
     }
     free(ipartition_map);
@@ -1288,35 +1269,33 @@ void DistributedManager<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indP
 
     int h_cidx_allocated = 0;
     const t_colIndex *h_col_indices_global = (const t_colIndex *)this->getHostPointerForData(col_indices, num_nonzeros * sizeof(t_colIndex), &h_cidx_allocated);
-    // gather all off-diag columns
-    I64Vector_h off_diag_cols;
-    for (int i = 0; i < num_nonzeros; i++)
-    {
-        if (!in_local_diagonal_block(h_col_indices_global[i]))
-        {
-            off_diag_cols.push_back(h_col_indices_global[i]);
-        }
-    }
-    auto global_to_local = loadDistributed_LocalToGlobal<t_colIndex>(num_rows, off_diag_cols);
-    // set 1, then scan to compute local row indices
+    // gather all off-diag columns and, in the same pass, set 1 for my local columns (scanned below to compute local row indices)
     // "coordinate-shift" columns so they lie in much smaller range of my diagonal indices
+    I64Vector_h off_diag_cols;
     int diagonal_size = this->part_offsets_h[my_id  + 1] - this->part_offsets_h[my_id];
     IVector_h my_indices(diagonal_size);
     for (int i = 0; i < num_nonzeros; i++)
     {
         t_colIndex col_index = h_col_indices_global[i];
-        if (in_local_diagonal_block(h_col_indices_global[i]))     // find my local columns and set to 1
+        if (!in_local_diagonal_block(col_index))
+        {
+            off_diag_cols.push_back(col_index);
+        }
+        else
         {
-            // olumns that are on *my* diag partition cannot have an index from 0..num_rows_global
+            // columns that are on *my* diag partition cannot have an index from 0..num_rows_global
             // instead, part_offsets_h[my_id] <= col_index < part_offsets[my_id+1]
             col_index -= this->part_offsets_h[my_id];
             my_indices[col_index] = 1;
         }
     }
+    GlobalToLocalMap global_to_local;
+    loadDistributed_LocalToGlobal(num_rows, off_diag_cols, global_to_local);
     thrust_wrapper::exclusive_scan<AMGX_host>(my_indices.begin(), my_indices.end(), my_indices.begin());
 
     // remap colums to local
     IVector_h local_col_indices(num_nonzeros);
+    #pragma omp parallel for
     for (int i = 0; i < num_nonzeros; i++)
     {
         t_colIndex col_index = h_col_indices_global[i];
@@ -1712,6 +1691,8 @@ void DistributedManagerBase<TConfig>::setAConsolidationFlags( Matrix<TConfig> &i
 template <class TConfig>
 void DistributedManagerBase<TConfig>::uploadMatrix(int n, int nnz, int block_dimx, int block_dimy, const int *row_ptrs, const int *col_indices, const void *data, const void *diag, Matrix<TConfig> &in_A)
 {
+    // the local structure may change, the next global upload must not reuse the maps
+    this->m_structure_fingerprint = 0;
     this->setAConsolidationFlags(in_A);
 
     if (this->m_is_fine_level_consolidated)
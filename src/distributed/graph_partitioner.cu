@@ -0,0 +1,405 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <distributed/graph_partitioner.h>
+#include <error.h>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <climits>
+#include <cmath>
+
+namespace amgx
+{
+
+namespace
+{
+
+// weighted undirected graph in CSR form, used on every level of the multilevel hierarchy
+struct PartGraph
+{
+    std::vector<int> xadj;
+    std::vector<int> adj;
+    std::vector<int> adjw;
+    std::vector<int> vwgt;
+
+    int num_vertices() const { return (int)vwgt.size(); }
+};
+
+// symmetrized adjacency graph of the matrix without self loops, unit vertex and edge weights
+void build_graph(int n, const int *row_offsets, const int *col_indices, PartGraph &g)
+{
+    std::vector<int> pos(n + 1, 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            int j = col_indices[jj];
+
+            if (j == i || j < 0 || j >= n) { continue; }
+
+            pos[i + 1]++;
+            pos[j + 1]++;
+        }
+    }
+
+    std::partial_sum(pos.begin(), pos.end(), pos.begin());
+    std::vector<int> both(pos[n]);
+    std::vector<int> fill(pos.begin(), pos.end() - 1);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            int j = col_indices[jj];
+
+            if (j == i || j < 0 || j >= n) { continue; }
+
+            both[fill[i]++] = j;
+            both[fill[j]++] = i;
+        }
+    }
+
+    // (i,j) and (j,i) of a structurally symmetric matrix collapse into one edge
+    g.xadj.assign(n + 1, 0);
+    g.adj.clear();
+    g.adj.reserve(both.size() / 2);
+
+    for (int i = 0; i < n; i++)
+    {
+        std::sort(both.begin() + pos[i], both.begin() + pos[i + 1]);
+
+        for (int k = pos[i]; k < pos[i + 1]; k++)
+        {
+            if (k == pos[i] || both[k] != both[k - 1])
+            {
+                g.adj.push_back(both[k]);
+            }
+        }
+
+        g.xadj[i + 1] = (int)g.adj.size();
+    }
+
+    g.adjw.assign(g.adj.size(), 1);
+    g.vwgt.assign(n, 1);
+}
+
+// heavy-edge matching in random vertex order, returns the number of coarse vertices
+int match_heavy_edge(const PartGraph &g, std::mt19937 &rng, int max_vwgt, std::vector<int> &cmap)
+{
+    const int n = g.num_vertices();
+    std::vector<int> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), rng);
+    std::vector<int> match(n, -1);
+
+    for (int k = 0; k < n; k++)
+    {
+        const int v = perm[k];
+
+        if (match[v] != -1) { continue; }
+
+        int best = v;
+        int best_w = -1;
+
+        for (int e = g.xadj[v]; e < g.xadj[v + 1]; e++)
+        {
+            const int u = g.adj[e];
+
+            if (match[u] == -1 && g.adjw[e] > best_w && g.vwgt[v] + g.vwgt[u] <= max_vwgt)
+            {
+                best = u;
+                best_w = g.adjw[e];
+            }
+        }
+
+        match[v] = best;
+        match[best] = v;
+    }
+
+    cmap.assign(n, -1);
+    int nc = 0;
+
+    for (int v = 0; v < n; v++)
+    {
+        if (cmap[v] == -1)
+        {
+            cmap[v] = nc;
+            cmap[match[v]] = nc;
+            nc++;
+        }
+    }
+
+    return nc;
+}
+
+// collapse matched vertices, summing vertex weights and the weights of parallel edges
+void contract(const PartGraph &g, const std::vector<int> &cmap, int nc, PartGraph &cg)
+{
+    const int n = g.num_vertices();
+    std::vector<int> members_ptr(nc + 1, 0);
+    std::vector<int> members(n);
+
+    for (int v = 0; v < n; v++)
+    {
+        members_ptr[cmap[v] + 1]++;
+    }
+
+    std::partial_sum(members_ptr.begin(), members_ptr.end(), members_ptr.begin());
+    std::vector<int> fill(members_ptr.begin(), members_ptr.end() - 1);
+
+    for (int v = 0; v < n; v++)
+    {
+        members[fill[cmap[v]]++] = v;
+    }
+
+    cg.xadj.assign(nc + 1, 0);
+    cg.vwgt.assign(nc, 0);
+    cg.adj.clear();
+    cg.adjw.clear();
+    // position of coarse neighbour in cg.adj, entries from earlier rows are below the row start
+    std::vector<int> marker(nc, -1);
+
+    for (int c = 0; c < nc; c++)
+    {
+        const int row_start = (int)cg.adj.size();
+
+        for (int m = members_ptr[c]; m < members_ptr[c + 1]; m++)
+        {
+            const int v = members[m];
+            cg.vwgt[c] += g.vwgt[v];
+
+            for (int e = g.xadj[v]; e < g.xadj[v + 1]; e++)
+            {
+                const int cu = cmap[g.adj[e]];
+
+                if (cu == c) { continue; }
+
+                if (marker[cu] >= row_start)
+                {
+                    cg.adjw[marker[cu]] += g.adjw[e];
+                }
+                else
+                {
+                    marker[cu] = (int)cg.adj.size();
+                    cg.adj.push_back(cu);
+                    cg.adjw.push_back(g.adjw[e]);
+                }
+            }
+        }
+
+        cg.xadj[c + 1] = (int)cg.adj.size();
+    }
+}
+
+// greedy graph growing: breadth-first regions of balanced weight, one part after the other
+void grow_initial_partition(const PartGraph &g, int num_parts, std::vector<int> &part)
+{
+    const int n = g.num_vertices();
+    int64_t remaining = std::accumulate(g.vwgt.begin(), g.vwgt.end(), (int64_t)0);
+    part.assign(n, -1);
+    std::vector<int> queue;
+    queue.reserve(n);
+    int next_seed = 0;
+
+    for (int p = 0; p < num_parts; p++)
+    {
+        const int64_t target = remaining / (num_parts - p);
+        int64_t pw = 0;
+        size_t head = 0;
+        queue.clear();
+
+        while (pw < target)
+        {
+            if (head == queue.size())
+            {
+                // region exhausted its connected component, continue from the next unassigned vertex
+                while (next_seed < n && part[next_seed] != -1) { next_seed++; }
+
+                if (next_seed == n) { break; }
+
+                part[next_seed] = p;
+                pw += g.vwgt[next_seed];
+                queue.push_back(next_seed);
+                continue;
+            }
+
+            const int v = queue[head++];
+
+            for (int e = g.xadj[v]; e < g.xadj[v + 1] && pw < target; e++)
+            {
+                const int u = g.adj[e];
+
+                if (part[u] == -1)
+                {
+                    part[u] = p;
+                    pw += g.vwgt[u];
+                    queue.push_back(u);
+                }
+            }
+        }
+
+        remaining -= pw;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        if (part[v] == -1) { part[v] = num_parts - 1; }
+    }
+}
+
+// greedy boundary refinement: move vertices to the adjacent part with the largest cut reduction,
+// zero-gain moves only when they improve balance, overweight parts shed vertices even at a loss
+void refine(const PartGraph &g, int num_parts, int64_t max_pwgt, std::vector<int> &part, int max_passes)
+{
+    const int n = g.num_vertices();
+    std::vector<int64_t> pwgt(num_parts, 0);
+
+    for (int v = 0; v < n; v++)
+    {
+        pwgt[part[v]] += g.vwgt[v];
+    }
+
+    std::vector<int> conn(num_parts, 0);
+    std::vector<int> touched;
+
+    for (int pass = 0; pass < max_passes; pass++)
+    {
+        int moves = 0;
+
+        for (int v = 0; v < n; v++)
+        {
+            const int from = part[v];
+            const int vw = g.vwgt[v];
+            bool boundary = false;
+            touched.clear();
+
+            for (int e = g.xadj[v]; e < g.xadj[v + 1]; e++)
+            {
+                const int q = part[g.adj[e]];
+
+                if (conn[q] == 0) { touched.push_back(q); }
+
+                conn[q] += g.adjw[e];
+                boundary = boundary || (q != from);
+            }
+
+            const bool overweight = pwgt[from] > max_pwgt;
+
+            if ((boundary || overweight) && pwgt[from] - vw > 0)
+            {
+                int best = from;
+                int best_gain = overweight ? INT_MIN : 0;
+
+                for (size_t t = 0; t < touched.size(); t++)
+                {
+                    const int q = touched[t];
+
+                    if (q == from || pwgt[q] + vw > max_pwgt) { continue; }
+
+                    const int gain = conn[q] - conn[from];
+                    const bool better = gain > best_gain ||
+                                        (gain == best_gain && pwgt[q] + vw < pwgt[from] && (best == from || pwgt[q] < pwgt[best]));
+
+                    if (better)
+                    {
+                        best = q;
+                        best_gain = gain;
+                    }
+                }
+
+                if (best != from)
+                {
+                    part[v] = best;
+                    pwgt[from] -= vw;
+                    pwgt[best] += vw;
+                    moves++;
+                }
+            }
+
+            for (size_t t = 0; t < touched.size(); t++)
+            {
+                conn[touched[t]] = 0;
+            }
+        }
+
+        if (moves == 0) { break; }
+    }
+}
+
+} // end anonymous namespace
+
+int64_t partitionGraphKway(int num_rows, const int *row_offsets, const int *col_indices, int num_parts, int *partition, double imbalance)
+{
+    if (num_parts < 1 || num_rows < 0 || imbalance < 1.0)
+    {
+        FatalError("Bad parameters passed to the graph partitioner", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    if (num_parts == 1)
+    {
+        std::fill(partition, partition + num_rows, 0);
+        return 0;
+    }
+
+    std::vector<PartGraph> levels(1);
+    std::vector<std::vector<int> > cmaps;
+    build_graph(num_rows, row_offsets, col_indices, levels[0]);
+    // fixed seed: every rank has to produce the same partition
+    std::mt19937 rng(5489u);
+    const int coarsen_to = std::max(20 * num_parts, 100);
+    // cap coarse vertex weight so the coarsest graph can still be balanced
+    const int max_vwgt = std::max(1, (int)(1.5 * num_rows / coarsen_to));
+
+    while (levels.back().num_vertices() > coarsen_to)
+    {
+        std::vector<int> cmap;
+        const int nc = match_heavy_edge(levels.back(), rng, max_vwgt, cmap);
+
+        // matching stalled, further levels would not pay for themselves
+        if (nc > 0.95 * levels.back().num_vertices()) { break; }
+
+        PartGraph cg;
+        contract(levels.back(), cmap, nc, cg);
+        cmaps.push_back(std::move(cmap));
+        levels.push_back(std::move(cg));
+    }
+
+    const int64_t max_pwgt = (int64_t)std::ceil(imbalance * num_rows / num_parts);
+    std::vector<int> part;
+    grow_initial_partition(levels.back(), num_parts, part);
+    refine(levels.back(), num_parts, max_pwgt, part, 16);
+
+    for (int l = (int)cmaps.size() - 1; l >= 0; l--)
+    {
+        const std::vector<int> &cmap = cmaps[l];
+        std::vector<int> fine_part(cmap.size());
+
+        for (size_t v = 0; v < cmap.size(); v++)
+        {
+            fine_part[v] = part[cmap[v]];
+        }
+
+        part.swap(fine_part);
+        refine(levels[l], num_parts, max_pwgt, part, 8);
+    }
+
+    std::copy(part.begin(), part.end(), partition);
+    const PartGraph &g = levels[0];
+    int64_t edge_cut = 0;
+
+    for (int v = 0; v < num_rows; v++)
+    {
+        for (int e = g.xadj[v]; e < g.xadj[v + 1]; e++)
+        {
+            edge_cut += (part[v] != part[g.adj[e]]) ? 1 : 0;
+        }
+    }
+
+    return edge_cut / 2;
+}
+
+} // namespace amgx
@@ -12,6 +12,8 @@
 #include <amgx_timer.h>
 #include <algorithm>
 #include <iomanip>
+#include <atomic>
+#include <unordered_map>
 
 #if defined(_WIN32)
 #include <stddef.h>
@@ -746,6 +748,269 @@ cudaStream_t getStream()
     return manager.m_main_stream;
 }
 
+// Memory accounting: every live allocation remembers the owner and the counter it was charged to.
+class MemoryAccounting
+{
+    public:
+        static MemoryAccounting &get_instance()
+        {
+            static MemoryAccounting s_instance;
+            return s_instance;
+        }
+
+        void record_allocation(void *ptr, size_t size, bool device, const void *owner, MemoryTag tag, int level)
+        {
+            const int level_slot = level < 0 ? 0 : 1 + std::min(level, MEMORY_ACCOUNTING_MAX_LEVELS - 1);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Allocation &allocation = m_allocations[ptr];
+
+            // the pointer was freed behind our back (e.g. while accounting was off), drop the old charge
+            if (allocation.counter != NULL)
+            {
+                release(allocation);
+            }
+
+            Ledger &ledger = m_ledgers[owner];
+            allocation.size = size;
+            allocation.device = device;
+            allocation.ledger = &ledger;
+            allocation.counter = &ledger.counters[device ? 1 : 0][tag][level_slot];
+            charge(allocation.counter, size);
+            charge(&ledger.totals[device ? 1 : 0], size);
+        }
+
+        void record_free(void *ptr)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::unordered_map<void *, Allocation>::iterator it = m_allocations.find(ptr);
+
+            if (it != m_allocations.end())
+            {
+                release(it->second);
+                m_allocations.erase(it);
+            }
+        }
+
+        void report(const void *owner, std::vector<MemoryReportEntry> &entries, size_t &device_peak_bytes, size_t &pinned_peak_bytes)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            entries.clear();
+            device_peak_bytes = 0;
+            pinned_peak_bytes = 0;
+            std::map<const void *, Ledger>::const_iterator it = m_ledgers.find(owner);
+
+            if (it == m_ledgers.end())
+            {
+                return;
+            }
+
+            const Ledger &ledger = it->second;
+
+            for (int space = 1; space >= 0; space--)
+            {
+                for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++)
+                {
+                    for (int slot = 0; slot <= MEMORY_ACCOUNTING_MAX_LEVELS; slot++)
+                    {
+                        const Counter &c = ledger.counters[space][tag][slot];
+
+                        if (c.peak > 0)
+                        {
+                            MemoryReportEntry entry = {(MemoryTag)tag, slot - 1, space == 1, c.current, c.peak};
+                            entries.push_back(entry);
+                        }
+                    }
+                }
+            }
+
+            device_peak_bytes = ledger.totals[1].peak;
+            pinned_peak_bytes = ledger.totals[0].peak;
+        }
+
+        void reset_peaks(const void *owner)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<const void *, Ledger>::iterator it = m_ledgers.find(owner);
+
+            if (it == m_ledgers.end())
+            {
+                return;
+            }
+
+            Ledger &ledger = it->second;
+
+            for (int space = 0; space < 2; space++)
+            {
+                ledger.totals[space].peak = ledger.totals[space].current;
+
+                for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++)
+                {
+                    for (int slot = 0; slot <= MEMORY_ACCOUNTING_MAX_LEVELS; slot++)
+                    {
+                        ledger.counters[space][tag][slot].peak = ledger.counters[space][tag][slot].current;
+                    }
+                }
+            }
+        }
+
+        // the owner's address may be reused by the next Resources, which has to start from zero
+        void release_owner(const void *owner)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<const void *, Ledger>::iterator it = m_ledgers.find(owner);
+
+            if (it == m_ledgers.end())
+            {
+                return;
+            }
+
+            for (std::unordered_map<void *, Allocation>::iterator a = m_allocations.begin(); a != m_allocations.end(); )
+            {
+                if (a->second.ledger == &it->second)
+                {
+                    a = m_allocations.erase(a);
+                }
+                else
+                {
+                    ++a;
+                }
+            }
+
+            m_ledgers.erase(it);
+        }
+
+    private:
+        struct Counter
+        {
+            size_t current, peak;
+            Counter() : current(0), peak(0) {}
+        };
+
+        struct Ledger
+        {
+            // [pinned host, device][tag][no level, level 0, level 1, ...]
+            Counter counters[2][MEMORY_TAG_COUNT][MEMORY_ACCOUNTING_MAX_LEVELS + 1];
+            Counter totals[2];
+        };
+
+        struct Allocation
+        {
+            size_t size;
+            bool device;
+            Ledger *ledger;
+            Counter *counter;
+            Allocation() : size(0), device(false), ledger(NULL), counter(NULL) {}
+        };
+
+        static void charge(Counter *c, size_t size)
+        {
+            c->current += size;
+            c->peak = std::max(c->peak, c->current);
+        }
+
+        static void release(const Allocation &allocation)
+        {
+            allocation.counter->current -= allocation.size;
+            allocation.ledger->totals[allocation.device ? 1 : 0].current -= allocation.size;
+        }
+
+        std::mutex m_mutex;
+        std::unordered_map<void *, Allocation> m_allocations;
+        // std::map keeps the ledgers in place, allocations point into them
+        std::map<const void *, Ledger> m_ledgers;
+};
+
+// set once the accounting was enabled, frees have to be looked up from then on
+static std::atomic<bool> s_memory_accounting_used(false);
+static thread_local MemoryTag s_memory_tag = MEMORY_TAG_OTHER;
+static thread_local int s_memory_level = -1;
+static thread_local const void *s_memory_owner = NULL;
+static thread_local bool s_memory_accounting = false;
+
+const char *getMemoryTagName(MemoryTag tag)
+{
+    static const char *names[MEMORY_TAG_COUNT] = {"other", "matrix", "transfer", "smoother", "solver", "comms", "coloring"};
+    return tag < MEMORY_TAG_COUNT ? names[tag] : "unknown";
+}
+
+MemoryTag getMemoryTag()
+{
+    return s_memory_tag;
+}
+
+int getMemoryLevel()
+{
+    return s_memory_level;
+}
+
+void setMemoryTag(MemoryTag tag, int level)
+{
+    s_memory_tag = tag;
+    s_memory_level = level;
+}
+
+const void *getMemoryOwner()
+{
+    return s_memory_owner;
+}
+
+bool getMemoryAccounting()
+{
+    return s_memory_accounting;
+}
+
+MemoryOwnerScope::MemoryOwnerScope(const void *owner, bool enabled) : m_owner(s_memory_owner), m_enabled(s_memory_accounting)
+{
+    if (enabled)
+    {
+        s_memory_accounting_used.store(true);
+    }
+
+    s_memory_owner = owner;
+    s_memory_accounting = enabled;
+}
+
+MemoryOwnerScope::~MemoryOwnerScope()
+{
+    s_memory_owner = m_owner;
+    s_memory_accounting = m_enabled;
+}
+
+void getMemoryReport(const void *owner, std::vector<MemoryReportEntry> &entries, size_t &device_peak_bytes, size_t &pinned_peak_bytes)
+{
+    MemoryAccounting::get_instance().report(owner, entries, device_peak_bytes, pinned_peak_bytes);
+}
+
+void resetMemoryPeaks(const void *owner)
+{
+    MemoryAccounting::get_instance().reset_peaks(owner);
+}
+
+void releaseMemoryOwner(const void *owner)
+{
+    if (s_memory_accounting_used.load(std::memory_order_relaxed))
+    {
+        MemoryAccounting::get_instance().release_owner(owner);
+    }
+}
+
+static inline void accountAllocation(void *ptr, size_t size, bool device)
+{
+    if (ptr != NULL && s_memory_accounting)
+    {
+        MemoryAccounting::get_instance().record_allocation(ptr, size, device, s_memory_owner, s_memory_tag, s_memory_level);
+    }
+}
+
+// frees are looked up even when the accounting was turned off again, so no stale charges are left behind
+static inline void accountFree(void *ptr)
+{
+    if (ptr != NULL && s_memory_accounting_used.load(std::memory_order_relaxed))
+    {
+        MemoryAccounting::get_instance().record_free(ptr);
+    }
+}
+
 void cudaHostRegister(void *ptr, int size)
 {
     MemoryManager &manager = MemoryManager::get_instance();
@@ -810,6 +1075,11 @@ cudaError_t cudaMallocHost(void **ptr, size_t size)
         error = ::cudaMallocHost(ptr, size);
     }
 
+    if ( error == cudaSuccess )
+    {
+        accountAllocation(*ptr, size, false);
+    }
+
     return error;
 }
 
@@ -827,6 +1097,7 @@ cudaError_t cudaFreeHost(void *ptr)
 
     size_t freed_size = 0;
     cudaError_t error = cudaSuccess;
+    accountFree(ptr);
 
     if ( pool != NULL && pool->is_allocated(ptr) )
     {
@@ -847,7 +1118,14 @@ cudaError_t cudaMallocAsync(void **ptr, size_t size, cudaStream_t stream)
 #ifdef USE_CUDAMALLOCASYNC
     if (manager.uses_cudamallocasync())
     {
-        return ::cudaMallocAsync(ptr, size, stream);
+        cudaError_t error = ::cudaMallocAsync(ptr, size, stream);
+
+        if ( error == cudaSuccess )
+        {
+            accountAllocation(*ptr, size, true);
+        }
+
+        return error;
     }
 #endif
 
@@ -953,12 +1231,18 @@ cudaError_t cudaMallocAsync(void **ptr, size_t size, cudaStream_t stream)
     }
 
 #endif
+    if ( error == cudaSuccess )
+    {
+        accountAllocation(*ptr, size, true);
+    }
+
     return error;
 }
 
 cudaError_t cudaFreeAsync(void *ptr, cudaStream_t stream)
 {
     MemoryManager &manager = MemoryManager::get_instance();
+    accountFree(ptr);
 
 #ifdef USE_CUDAMALLOCASYNC
     if (manager.uses_cudamallocasync())
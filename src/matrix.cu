@@ -11,6 +11,11 @@
 #include <thrust/device_ptr.h>
 #include <thrust/sort.h>
 #include <thrust/gather.h>
+#include <thrust/reduce.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
 #include <vector_thrust_allocator.h>
 #include <cusp/detail/format_utils.h>
 #include <permute.h>
@@ -29,6 +34,21 @@ struct row_length : public amgx::thrust::unary_function<T, T>
     }
 };
 
+// 1 if the k-th sorted triplet starts a new (row, col) entry, 0 if it duplicates the previous one
+template<typename IndexType>
+struct triplet_segment_head : public amgx::thrust::unary_function<IndexType, IndexType>
+{
+    const IndexType *rows;
+    const IndexType *cols;
+
+    triplet_segment_head(const IndexType *rows, const IndexType *cols) : rows(rows), cols(cols) {}
+
+    __host__ __device__ IndexType operator()(const IndexType k) const
+    {
+        return (k == 0 || rows[k] != rows[k - 1] || cols[k] != cols[k - 1]) ? 1 : 0;
+    }
+};
+
 namespace amgx
 {
 
@@ -704,6 +724,8 @@ MatrixBase<T_Config>::resize(index_type num_rows, index_type num_cols, index_typ
     }
 
     {
+        // every fill path resizes the matrix, a triplet map of the previous contents is stale
+        clearAssemblyMap();
         this->num_rows = num_rows;
         this->num_cols = num_cols;
         this->num_nz = num_nz;
@@ -981,6 +1003,77 @@ MatrixBase<T_Config>::sortByRowAndColumn()
     this->set_initialized(1);
 }
 
+template<class T_Config>
+void
+MatrixBase<T_Config>::assembleFromTriplets(index_type num_rows, const IVector &in_row_indices, const IVector &in_col_indices, const MVector &in_values)
+{
+    const index_type num_entries = in_row_indices.size();
+
+    if (in_col_indices.size() != num_entries || in_values.size() != num_entries)
+    {
+        FatalError("assembleFromTriplets: row, column and value arrays differ in size", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    this->set_initialized(0);
+    this->resize(0, 0, 0, 1, 1, 1);
+    this->delProps(COO | DIAG);
+    this->addProps(CSR);
+    // compute permutation and sort by (I,J), with the same two stable sorts as sortByRowAndColumn.
+    // The map is kept in locals until the last resize, which clears the members.
+    IVector permutation(num_entries);
+    thrust_wrapper::sequence<T_Config::memSpace>(permutation.begin(), permutation.end());
+    IVector I(in_col_indices);
+    thrust_wrapper::stable_sort_by_key<T_Config::memSpace>(I.begin(), I.end(), permutation.begin());
+    thrust_wrapper::gather<T_Config::memSpace>(permutation.begin(), permutation.end(), in_row_indices.begin(), I.begin());
+    thrust_wrapper::stable_sort_by_key<T_Config::memSpace>(I.begin(), I.end(), permutation.begin());
+    IVector J(num_entries);
+    thrust_wrapper::gather<T_Config::memSpace>(permutation.begin(), permutation.end(), in_col_indices.begin(), J.begin());
+    cudaCheckError();
+    // duplicates of the same (I,J) share a segment
+    IVector segments(num_entries);
+    thrust_wrapper::transform<T_Config::memSpace>(amgx::thrust::counting_iterator<index_type>(0), amgx::thrust::counting_iterator<index_type>(num_entries), segments.begin(), triplet_segment_head<index_type>(I.raw(), J.raw()));
+    thrust_wrapper::inclusive_scan<T_Config::memSpace>(segments.begin(), segments.end(), segments.begin());
+    cudaCheckError();
+    const index_type num_nz = (num_entries > 0) ? (index_type)segments[num_entries - 1] : 0;
+    this->resize(num_rows, num_rows, num_nz, 1);
+    // sum the duplicates while writing the column indices and the values
+    IVector new_row_indices(num_nz);
+    amgx::thrust::reduce_by_key(amgx::thrust::make_zip_iterator(amgx::thrust::make_tuple(I.begin(), J.begin())),
+                                amgx::thrust::make_zip_iterator(amgx::thrust::make_tuple(I.end(), J.end())),
+                                amgx::thrust::make_permutation_iterator(in_values.begin(), permutation.begin()),
+                                amgx::thrust::make_zip_iterator(amgx::thrust::make_tuple(new_row_indices.begin(), this->col_indices.begin())),
+                                this->values.begin(),
+                                amgx::thrust::equal_to< amgx::thrust::tuple<index_type, index_type> >(),
+                                amgx::thrust::plus<value_type>());
+    cudaCheckError();
+    cusp::detail::indices_to_offsets(new_row_indices, this->row_offsets);
+    cudaCheckError();
+    m_assembly_permutation.swap(permutation);
+    m_assembly_segments.swap(segments);
+    this->computeDiagonal();
+    this->set_initialized(1);
+}
+
+template<class T_Config>
+void
+MatrixBase<T_Config>::replaceAssembledValues(const MVector &in_values)
+{
+    if (in_values.size() != m_assembly_permutation.size())
+    {
+        FatalError("replaceAssembledValues: number of values differs from the assembled triplets", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    // segments are sorted, so a single reduction over the permuted input refills every slot
+    amgx::thrust::reduce_by_key(m_assembly_segments.begin(),
+                                m_assembly_segments.end(),
+                                amgx::thrust::make_permutation_iterator(in_values.begin(), m_assembly_permutation.begin()),
+                                amgx::thrust::make_discard_iterator(),
+                                this->values.begin(),
+                                amgx::thrust::equal_to<index_type>(),
+                                amgx::thrust::plus<value_type>());
+    cudaCheckError();
+}
+
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void
 Matrix<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::computeDiagonal()
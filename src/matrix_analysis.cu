@@ -3,6 +3,11 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <matrix_analysis.h>
+#include <thrust_wrapper.h>
+#include <distributed/amgx_omp.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <limits>
+#include <cmath>
 #include <sstream>
 #include <string>
 #include <iostream>
@@ -792,6 +797,240 @@ void MatrixAnalysis<T_Config>::aggregatesQuality2(const typename Matrix<T_Config
     return;
 }
 
+namespace
+{
+
+inline double real_part(float v) { return v; }
+inline double real_part(double v) { return v; }
+inline double real_part(const cuComplex &v) { return types::get_re(v); }
+inline double real_part(const cuDoubleComplex &v) { return types::get_re(v); }
+
+// eigenvalues of the symmetric m x m matrix M (overwritten) by cyclic Jacobi rotations, ascending
+void symmetric_eigenvalues(std::vector<double> &M, int m, std::vector<double> &eig)
+{
+    for (int sweep = 0; sweep < 50; sweep++)
+    {
+        double off = 0., norm = 0.;
+
+        for (int p = 0; p < m; p++)
+            for (int q = 0; q < m; q++)
+            {
+                norm += M[p * m + q] * M[p * m + q];
+                off += p != q ? M[p * m + q] * M[p * m + q] : 0.;
+            }
+
+        if (off <= 1e-24 * norm) { break; }
+
+        for (int p = 0; p < m - 1; p++)
+            for (int q = p + 1; q < m; q++)
+            {
+                const double apq = M[p * m + q];
+
+                if (std::abs(apq) <= 1e-300) { continue; }
+
+                const double theta = (M[q * m + q] - M[p * m + p]) / (2. * apq);
+                const double t = (theta >= 0. ? 1. : -1.) / (std::abs(theta) + std::sqrt(theta * theta + 1.));
+                const double c = 1. / std::sqrt(t * t + 1.), s = t * c;
+
+                for (int k = 0; k < m; k++)
+                {
+                    const double akp = M[k * m + p], akq = M[k * m + q];
+                    M[k * m + p] = c * akp - s * akq;
+                    M[k * m + q] = s * akp + c * akq;
+                }
+
+                for (int k = 0; k < m; k++)
+                {
+                    const double apk = M[p * m + k], aqk = M[q * m + k];
+                    M[p * m + k] = c * apk - s * aqk;
+                    M[q * m + k] = s * apk + c * aqk;
+                }
+            }
+    }
+
+    eig.resize(m);
+
+    for (int p = 0; p < m; p++)
+    {
+        eig[p] = M[p * m + p];
+    }
+
+    std::sort(eig.begin(), eig.end());
+}
+
+// 1 / lambda_2(D_G^-1 A_G) for the aggregate of the m sorted rows in members, using the first
+// component of every block. Infinite when the aggregate is disconnected or not positive.
+template <class Matrix_h, class IVector_h>
+double aggregate_quality(const Matrix_h &A, const IVector_h &aggregates, int g, const int *members, int m)
+{
+    const int bs = A.get_block_size();
+    std::vector<double> S(m * m, 0.), d(m), eig;
+
+    for (int r = 0; r < m; r++)
+    {
+        const int i = members[r];
+        d[r] = real_part(A.values[A.diag[i] * bs]);
+
+        for (int e = A.row_offsets[i]; e < A.row_offsets[i + 1]; e++)
+        {
+            const int j = A.col_indices[e];
+
+            if (j < (int)aggregates.size() && aggregates[j] == g)
+            {
+                const int c = (int)(std::lower_bound(members, members + m, j) - members);
+                S[r * m + c] += 0.5 * real_part(A.values[e * bs]);
+                S[c * m + r] += 0.5 * real_part(A.values[e * bs]);
+            }
+        }
+
+        if (A.hasProps(DIAG))
+        {
+            S[r * m + r] += d[r];
+        }
+    }
+
+    for (int r = 0; r < m; r++)
+    {
+        if (!(d[r] > 0.)) { return std::numeric_limits<double>::infinity(); }
+
+        // zero row sums, the constant is the null space of A_G
+        double row_sum = 0.;
+
+        for (int c = 0; c < m; c++)
+        {
+            row_sum += S[r * m + c];
+        }
+
+        S[r * m + r] -= row_sum;
+    }
+
+    for (int r = 0; r < m; r++)
+        for (int c = 0; c < m; c++)
+        {
+            S[r * m + c] /= std::sqrt(d[r] * d[c]);
+        }
+
+    symmetric_eigenvalues(S, m, eig);
+    return eig[1] > 1e-12 * std::abs(eig[m - 1]) ? 1. / eig[1] : std::numeric_limits<double>::infinity();
+}
+
+struct row_length
+{
+    const int *row_offsets;
+
+    row_length(const int *_row_offsets) : row_offsets(_row_offsets) {}
+
+    __host__ __device__ int operator()(int i) const
+    {
+        return row_offsets[i + 1] - row_offsets[i];
+    }
+};
+
+} // namespace
+
+template<class T_Config>
+void MatrixAnalysis<T_Config>::aggregateDiagnostics(const typename Matrix<T_Config>::IVector &aggregates, int num_aggregates, bool rate_aggregates, LevelDiagnostics &d)
+{
+    typedef TemplateConfig<AMGX_host, T_Config::vecPrec, T_Config::matPrec, T_Config::indPrec> TConfig_h;
+    typename Matrix<TConfig_h>::IVector aggs = aggregates;
+    const int n = std::min((int)aggs.size(), (int)A->get_num_rows());
+    // rows of every aggregate in increasing order
+    std::vector<int> agg_offsets(num_aggregates + 1, 0), members(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (aggs[i] >= 0 && aggs[i] < num_aggregates) { agg_offsets[aggs[i] + 1]++; }
+    }
+
+    for (int g = 0; g < num_aggregates; g++)
+    {
+        agg_offsets[g + 1] += agg_offsets[g];
+    }
+
+    std::vector<int> cursor(agg_offsets.begin(), agg_offsets.end() - 1);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (aggs[i] >= 0 && aggs[i] < num_aggregates) { members[cursor[aggs[i]]++] = i; }
+    }
+
+    d.num_aggregates = num_aggregates;
+    d.max_aggregate_size = 0;
+    d.singletons = 0;
+
+    for (int k = 0; k < AGGREGATE_HISTOGRAM_BINS; k++)
+    {
+        d.aggregate_size_histogram[k] = 0;
+    }
+
+    for (int g = 0; g < num_aggregates; g++)
+    {
+        const int size = agg_offsets[g + 1] - agg_offsets[g];
+
+        if (size == 0) { continue; }
+
+        d.aggregate_size_histogram[std::min(size, AGGREGATE_HISTOGRAM_BINS) - 1]++;
+        d.max_aggregate_size = std::max(d.max_aggregate_size, size);
+        d.singletons += size == 1;
+    }
+
+    d.aggregate_quality = 0.;
+    d.unrated_aggregates = 0;
+
+    if (!rate_aggregates)
+    {
+        return;
+    }
+
+    // the rating reads the aggregate blocks of A, copy the level matrix to the host once
+    Matrix<TConfig_h> Ah = *A;
+    // the small dense eigenproblems are independent, one aggregate per iteration
+    std::vector<double> quality(num_aggregates, 0.);
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = threshold > 0 && (size_t)n >= threshold;
+    #pragma omp parallel for schedule(dynamic, 64) if (parallel)
+#endif
+    for (int g = 0; g < num_aggregates; g++)
+    {
+        const int size = agg_offsets[g + 1] - agg_offsets[g];
+
+        if (size > MAX_RATED_AGGREGATE)
+        {
+            quality[g] = -1.;
+        }
+        else if (size > 1)
+        {
+            quality[g] = aggregate_quality(Ah, aggs, g, &members[agg_offsets[g]], size);
+        }
+    }
+
+    for (int g = 0; g < num_aggregates; g++)
+    {
+        d.unrated_aggregates += quality[g] < 0.;
+        d.aggregate_quality = std::max(d.aggregate_quality, quality[g]);
+    }
+}
+
+template<class T_Config>
+void MatrixAnalysis<T_Config>::interpolationDiagnostics(const Matrix<T_Config> &P, LevelDiagnostics &d)
+{
+    const int n = P.get_num_rows();
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    amgx::thrust::counting_iterator<int> rows_begin(0), rows_end(n);
+    d.interp_min_row_length = thrust_wrapper::transform_reduce<T_Config::memSpace>(rows_begin, rows_end, row_length(P.row_offsets.raw()),
+                              std::numeric_limits<int>::max(), amgx::thrust::minimum<int>());
+    d.interp_max_row_length = thrust_wrapper::transform_reduce<T_Config::memSpace>(rows_begin, rows_end, row_length(P.row_offsets.raw()),
+                              0, amgx::thrust::maximum<int>());
+    d.interp_avg_row_length = (double)P.get_num_nz() / n;
+    cudaCheckError();
+}
+
 template<class T_Config>
 void MatrixAnalysis<T_Config>::visualizeAggregates(typename Matrix<TConfig>::IVector &aggregates)
 {
@@ -156,6 +156,9 @@ bool MatrixIO<T_Config>::writeSystemMatrixMarket(const char *fname, const Matrix
     // Note: we don't actaully have any guarantee that columns are sorted here
     // if (is_mtx) { fout << "sorted "; }
 
+    // CSR output below is ordered by row, which lets distributed reads seek to their rows
+    if (is_mtx && !A.hasProps(COO) && A.hasProps(CSR)) { fout << "rowsorted "; }
+
     if (is_rhs) { fout << "rhs "; }
 
     if (is_soln) { fout << "solution"; }
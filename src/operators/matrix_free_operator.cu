@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+namespace amgx
+{
+
+template <class T_Config> class Operator;
+
+}
+
+#include <operators/matrix_free_operator.h>
+
+namespace amgx
+{
+
+template <typename TConfig>
+void MatrixFreeOperator<TConfig>::apply(const Vector<TConfig> &v, Vector<TConfig> &res, ViewType view)
+{
+    // the callback has no way to exchange halos, the rows of the operator are all owned
+    if (!m_A->is_matrix_singleGPU())
+    {
+        FatalError("Matrix-free operators are only supported on a single GPU", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+
+    int N = m_A->get_num_rows() * m_A->get_block_dimy();
+
+    if (v.size() < N || res.size() < N)
+    {
+        FatalError("Vector sizes do not match the matrix-free operator", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    m_apply(v.raw(), res.raw(), m_user_data);
+    cudaCheckError();
+    res.dirtybit = 1;
+}
+
+#define AMGX_CASE_LINE(CASE) template class MatrixFreeOperator<TemplateMode<CASE>::Type>;
+AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+}
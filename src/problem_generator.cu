@@ -0,0 +1,497 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <problem_generator.h>
+#include <thrust_wrapper.h>
+#include <distributed/amgx_omp.h>
+#include <error.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace amgx
+{
+
+namespace
+{
+
+// largest number of block entries in a row of any stencil problem (27-point)
+const int MAX_STENCIL_ROW = 27;
+// largest number of neighbours per vertex of the random graph
+const int MAX_RANDOM_DEGREE = 64;
+
+inline uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// uniform in [0, 1), symmetric in a and b
+inline double edge_uniform(int64_t a, int64_t b, unsigned int seed)
+{
+    const uint64_t lo = (uint64_t)std::min(a, b), hi = (uint64_t)std::max(a, b);
+    const uint64_t h = splitmix64(splitmix64(lo ^ ((uint64_t)seed << 32)) ^ hi);
+    return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int problem_dim(const ProblemDesc &p)
+{
+    return p.nz > 1 ? 3 : 2;
+}
+
+bool in_pattern(const ProblemDesc &p, int dx, int dy, int dz)
+{
+    const int dist = std::abs(dx) + std::abs(dy) + std::abs(dz);
+
+    switch (p.kind)
+    {
+        case PROBLEM_POISSON9:
+        case PROBLEM_POISSON27:
+        case PROBLEM_ROTATED_ANISO:
+            return true;
+
+        case PROBLEM_ELASTICITY:
+            return dist <= 2;
+
+        default:
+            return dist <= 1;
+    }
+}
+
+double jump_coefficient(const ProblemDesc &p, int64_t i, int64_t j, int64_t k)
+{
+    const int64_t bi = i * p.jump_blocks / p.nx;
+    const int64_t bj = j * p.jump_blocks / p.ny;
+    const int64_t bk = k * p.jump_blocks / p.nz;
+    return ((bi + bj + bk) % 2) ? p.contrast : 1.;
+}
+
+// Block of the operator coupling point (i, j, k) with its neighbour at offset (dx, dy, dz),
+// block_size() x block_size() values in row-major order.
+void stencil_block(const ProblemDesc &p, int64_t i, int64_t j, int64_t k, int dx, int dy, int dz, double *block)
+{
+    const bool center = dx == 0 && dy == 0 && dz == 0;
+    const int dim = problem_dim(p);
+
+    switch (p.kind)
+    {
+        case PROBLEM_POISSON5:
+            block[0] = center ? 4. : -1.;
+            break;
+
+        case PROBLEM_POISSON7:
+            block[0] = center ? 6. : -1.;
+            break;
+
+        case PROBLEM_POISSON9:
+            block[0] = center ? 8. : -1.;
+            break;
+
+        case PROBLEM_POISSON27:
+            block[0] = center ? 26. : -1.;
+            break;
+
+        case PROBLEM_ANISO:
+            block[0] = center ? 2. * p.eps + 2. * (dim - 1) : (dx != 0 ? -p.eps : -1.);
+            break;
+
+        case PROBLEM_ROTATED_ANISO:
+        {
+            // finite difference stencil of -div(Q diag(1, eps) Q^T grad u), Q the rotation by theta
+            const double t = p.theta * M_PI / 180.;
+            const double C = cos(t), S = sin(t);
+            const double a = 0.5 * (p.eps - 1.) * C * S;
+
+            if (center) { block[0] = 2. * (p.eps + 1.); }
+            else if (dx == 0) { block[0] = -(p.eps * S * S + C * C); }
+            else if (dy == 0) { block[0] = -(p.eps * C * C + S * S); }
+            else { block[0] = dx == dy ? a : -a; }
+
+            break;
+        }
+
+        case PROBLEM_JUMP:
+        {
+            // harmonic mean of the coefficients on the faces, the cell's own on the boundary
+            const double ki = jump_coefficient(p, i, j, k);
+
+            if (!center)
+            {
+                const double kn = jump_coefficient(p, i + dx, j + dy, k + dz);
+                block[0] = -2. * ki * kn / (ki + kn);
+                break;
+            }
+
+            block[0] = 0.;
+
+            for (int d = 0; d < 2 * dim; d++)
+            {
+                const int s = (d & 1) ? 1 : -1;
+                const int64_t ni = i + (d / 2 == 0 ? s : 0), nj = j + (d / 2 == 1 ? s : 0), nk = k + (d / 2 == 2 ? s : 0);
+                const bool inside = ni >= 0 && ni < p.nx && nj >= 0 && nj < p.ny && nk >= 0 && nk < p.nz;
+                const double kn = inside ? jump_coefficient(p, ni, nj, nk) : ki;
+                block[0] += 2. * ki * kn / (ki + kn);
+            }
+
+            break;
+        }
+
+        case PROBLEM_CONVDIFF:
+        {
+            // unit diffusion stencil plus first order upwinding of v h per direction
+            const double c[3] = { p.vx / (p.nx + 1), p.vy / (p.ny + 1), p.vz / (p.nz + 1) };
+
+            if (center)
+            {
+                block[0] = 2. * dim;
+
+                for (int d = 0; d < dim; d++)
+                {
+                    block[0] += std::abs(c[d]);
+                }
+            }
+            else
+            {
+                const int d = dx != 0 ? 0 : (dy != 0 ? 1 : 2);
+                const int s = dx + dy + dz;
+                block[0] = -1. - ((c[d] > 0 && s < 0) || (c[d] < 0 && s > 0) ? std::abs(c[d]) : 0.);
+            }
+
+            break;
+        }
+
+        case PROBLEM_ELASTICITY:
+        {
+            // -mu lap u - (lambda + mu) grad div u, central differences for the mixed derivatives
+            const double lambda = p.E * p.nu / ((1. + p.nu) * (1. - 2. * p.nu));
+            const double mu = p.E / (2. * (1. + p.nu));
+            const int off[3] = { dx, dy, dz };
+            const int dist = std::abs(dx) + std::abs(dy) + std::abs(dz);
+
+            for (int a = 0; a < dim; a++)
+            {
+                for (int b = 0; b < dim; b++)
+                {
+                    double v = 0.;
+
+                    if (center)
+                    {
+                        v = a == b ? 2. * dim * mu + 2. * (lambda + mu) : 0.;
+                    }
+                    else if (dist == 1)
+                    {
+                        v = a == b ? -mu - (off[a] != 0 ? lambda + mu : 0.) : 0.;
+                    }
+                    else if (a != b && off[a] != 0 && off[b] != 0)
+                    {
+                        v = -(lambda + mu) * off[a] * off[b] / 4.;
+                    }
+
+                    block[a * dim + b] = v;
+                }
+            }
+
+            break;
+        }
+
+        default:
+            FatalError("Unsupported stencil problem", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+}
+
+// sorted neighbours of a vertex of the random graph: row +- d_m modulo n for degree / 2 offsets
+int random_neighbours(const ProblemDesc &p, int64_t row, int64_t *nbrs)
+{
+    const int64_t n = p.num_rows();
+    int count = 0;
+
+    if (n < 2)
+    {
+        return 0;
+    }
+
+    for (int m = 0; m < p.degree / 2; m++)
+    {
+        const int64_t d = 1 + (int64_t)(splitmix64(((uint64_t)p.seed << 32) + m) % (uint64_t)(n - 1));
+        nbrs[count++] = (row + d) % n;
+        nbrs[count++] = (row - d + n) % n;
+    }
+
+    std::sort(nbrs, nbrs + count);
+    return (int)(std::unique(nbrs, nbrs + count) - nbrs);
+}
+
+// Entries of one row, returns their number. Only counts when cols is NULL.
+template <typename ValueType, typename ColIndex>
+int problem_row(const ProblemDesc &p, int64_t row, ColIndex *cols, ValueType *vals)
+{
+    const int bs = p.block_size();
+    const int bs_sq = bs * bs;
+    int count = 0;
+
+    if (p.kind == PROBLEM_RANDOM_SPD)
+    {
+        int64_t nbrs[MAX_RANDOM_DEGREE];
+        const int num_nbrs = random_neighbours(p, row, nbrs);
+        double diag = p.shift;
+
+        for (int m = 0; m < num_nbrs; m++)
+        {
+            diag += 0.1 + 0.9 * edge_uniform(row, nbrs[m], p.seed);
+        }
+
+        bool diag_done = false;
+
+        for (int m = 0; m <= num_nbrs; m++)
+        {
+            if (!diag_done && (m == num_nbrs || nbrs[m] > row))
+            {
+                if (cols) { cols[count] = (ColIndex)row; vals[count] = ValueType(diag); }
+
+                count++;
+                diag_done = true;
+            }
+
+            if (m < num_nbrs)
+            {
+                if (cols) { cols[count] = (ColIndex)nbrs[m]; vals[count] = ValueType(-(0.1 + 0.9 * edge_uniform(row, nbrs[m], p.seed))); }
+
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    const int64_t i = row % p.nx, j = (row / p.nx) % p.ny, k = row / (p.nx * p.ny);
+    double block[9];
+
+    for (int dz = -1; dz <= 1; dz++)
+    {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                if (i + dx < 0 || i + dx >= p.nx || j + dy < 0 || j + dy >= p.ny || k + dz < 0 || k + dz >= p.nz ||
+                        !in_pattern(p, dx, dy, dz))
+                {
+                    continue;
+                }
+
+                if (cols)
+                {
+                    cols[count] = (ColIndex)(row + (dz * p.ny + dy) * p.nx + dx);
+                    stencil_block(p, i, j, k, dx, dy, dz, block);
+
+                    for (int e = 0; e < bs_sq; e++)
+                    {
+                        vals[count * bs_sq + e] = ValueType(block[e]);
+                    }
+                }
+
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+// row lengths of rows [row_begin, row_end) scanned into row_offsets, returns the number of entries
+int count_rows(const ProblemDesc &p, int64_t row_begin, int64_t row_end, int *row_offsets)
+{
+    const int64_t n = row_end - row_begin;
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = threshold > 0 && (size_t)n >= threshold;
+    #pragma omp parallel for if (parallel)
+#endif
+    for (int64_t r = 0; r < n; r++)
+    {
+        row_offsets[r + 1] = problem_row<double, int64_t>(p, row_begin + r, NULL, NULL);
+    }
+
+    int64_t nnz = 0;
+    row_offsets[0] = 0;
+
+    for (int64_t r = 0; r < n; r++)
+    {
+        nnz += row_offsets[r + 1];
+
+        if (nnz > INT_MAX)
+        {
+            FatalError("Generated rows have more than INT_MAX nonzeros, generate fewer rows per rank", AMGX_ERR_BAD_PARAMETERS);
+        }
+
+        row_offsets[r + 1] = (int)nnz;
+    }
+
+    return (int)nnz;
+}
+
+template <typename ValueType, typename ColIndex>
+void fill_rows(const ProblemDesc &p, int64_t row_begin, int64_t row_end, const int *row_offsets, ColIndex *cols, ValueType *vals)
+{
+    const int64_t n = row_end - row_begin;
+    const int bs_sq = p.block_size() * p.block_size();
+#ifdef AMGX_WITH_OPENMP
+    const size_t threshold = getHostParallelThreshold();
+    const bool parallel = threshold > 0 && (size_t)n >= threshold;
+    #pragma omp parallel for if (parallel)
+#endif
+    for (int64_t r = 0; r < n; r++)
+    {
+        problem_row(p, row_begin + r, cols + row_offsets[r], vals + (int64_t)row_offsets[r] * bs_sq);
+    }
+}
+
+} // namespace
+
+ProblemDesc::ProblemDesc()
+    : kind(PROBLEM_POISSON7), nx(1), ny(1), nz(1), eps(1e-3), theta(45.), contrast(1e3), jump_blocks(4),
+      vx(100.), vy(100.), vz(100.), E(1.), nu(0.3), degree(8), shift(1e-2), seed(1)
+{
+}
+
+int ProblemDesc::block_size() const
+{
+    return kind == PROBLEM_ELASTICITY ? (nz > 1 ? 3 : 2) : 1;
+}
+
+int ProblemDesc::max_row_length() const
+{
+    return kind == PROBLEM_RANDOM_SPD ? degree + 1 : MAX_STENCIL_ROW;
+}
+
+ProblemDesc parseProblem(const std::string &name, int64_t nx, int64_t ny, int64_t nz, const std::string &options)
+{
+    ProblemDesc p;
+    const char *names[] = { "poisson5", "poisson7", "poisson9", "poisson27", "aniso", "rotated_aniso", "jump", "convdiff", "elasticity", "random_spd" };
+    const int num_names = sizeof(names) / sizeof(names[0]);
+    int kind = 0;
+
+    while (kind < num_names && name != names[kind]) { kind++; }
+
+    if (kind == num_names)
+    {
+        FatalError("Unknown problem " + name, AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    p.kind = (ProblemKind)kind;
+    p.nx = nx;
+    p.ny = ny;
+    p.nz = nz;
+
+    if (nx < 1 || ny < 1 || nz < 1)
+    {
+        FatalError("Problem grid sizes must be positive", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    if ((p.kind == PROBLEM_POISSON5 || p.kind == PROBLEM_POISSON9 || p.kind == PROBLEM_ROTATED_ANISO) && nz != 1)
+    {
+        FatalError("Problem " + name + " is two dimensional, nz must be 1", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    std::stringstream ss(options);
+    std::string item;
+
+    while (std::getline(ss, item, ','))
+    {
+        item.erase(std::remove(item.begin(), item.end(), ' '), item.end());
+
+        if (item.empty()) { continue; }
+
+        const size_t eq = item.find('=');
+
+        if (eq == std::string::npos)
+        {
+            FatalError("Problem option " + item + " is not of the form key=value", AMGX_ERR_BAD_PARAMETERS);
+        }
+
+        const std::string key = item.substr(0, eq);
+        const double value = atof(item.c_str() + eq + 1);
+
+        if (key == "eps") { p.eps = value; }
+        else if (key == "theta") { p.theta = value; }
+        else if (key == "contrast") { p.contrast = value; }
+        else if (key == "jump_blocks") { p.jump_blocks = (int)value; }
+        else if (key == "vx") { p.vx = value; }
+        else if (key == "vy") { p.vy = value; }
+        else if (key == "vz") { p.vz = value; }
+        else if (key == "E") { p.E = value; }
+        else if (key == "nu") { p.nu = value; }
+        else if (key == "degree") { p.degree = (int)value; }
+        else if (key == "shift") { p.shift = value; }
+        else if (key == "seed") { p.seed = (unsigned int)value; }
+        else { FatalError("Unknown problem option " + key, AMGX_ERR_BAD_PARAMETERS); }
+    }
+
+    if (p.jump_blocks < 1 || p.degree < 0 || p.degree > MAX_RANDOM_DEGREE || p.nu <= -1. || p.nu >= 0.5)
+    {
+        FatalError("Invalid problem options " + options, AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    return p;
+}
+
+template <typename ValueType, typename ColIndex>
+void generateProblemRows(const ProblemDesc &p, int64_t row_begin, int64_t row_end,
+                         std::vector<int> &row_offsets, std::vector<ColIndex> &col_indices, std::vector<ValueType> &values)
+{
+    if (row_begin < 0 || row_end < row_begin || row_end > p.num_rows())
+    {
+        FatalError("Generated row range is outside of the problem", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    const int bs = p.block_size();
+    row_offsets.resize(row_end - row_begin + 1);
+    const int nnz = count_rows(p, row_begin, row_end, row_offsets.data());
+    col_indices.resize(nnz);
+    values.resize((size_t)nnz * bs * bs);
+    fill_rows(p, row_begin, row_end, row_offsets.data(), col_indices.data(), values.data());
+}
+
+template <class TConfig>
+void generateProblem(const ProblemDesc &p, Matrix<TConfig> &A)
+{
+    typedef typename TConfig::template setMemSpace<AMGX_host>::Type TConfig_h;
+
+    if (p.num_rows() > INT_MAX)
+    {
+        FatalError("Problem is too large for a single rank", AMGX_ERR_BAD_PARAMETERS);
+    }
+
+    const int n = (int)p.num_rows();
+    const int bs = p.block_size();
+    std::vector<int> row_offsets(n + 1);
+    const int nnz = count_rows(p, 0, n, row_offsets.data());
+    // fill straight into the matrix storage
+    Matrix<TConfig_h> A_h;
+    A_h.set_initialized(0);
+    A_h.addProps(CSR);
+    A_h.resize(n, n, nnz, bs, bs);
+    std::copy(row_offsets.begin(), row_offsets.end(), A_h.row_offsets.begin());
+    fill_rows(p, 0, n, row_offsets.data(), A_h.col_indices.raw(), A_h.values.raw());
+    A_h.computeDiagonal();
+    A_h.set_initialized(1);
+    A.set_initialized(0);
+    A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+}
+
+template void generateProblemRows<float, int>(const ProblemDesc &, int64_t, int64_t, std::vector<int> &, std::vector<int> &, std::vector<float> &);
+template void generateProblemRows<double, int>(const ProblemDesc &, int64_t, int64_t, std::vector<int> &, std::vector<int> &, std::vector<double> &);
+template void generateProblemRows<float, int64_t>(const ProblemDesc &, int64_t, int64_t, std::vector<int> &, std::vector<int64_t> &, std::vector<float> &);
+template void generateProblemRows<double, int64_t>(const ProblemDesc &, int64_t, int64_t, std::vector<int> &, std::vector<int64_t> &, std::vector<double> &);
+
+#define AMGX_CASE_LINE(CASE) template void generateProblem(const ProblemDesc &, Matrix<TemplateMode<CASE>::Type> &);
+AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+} // namespace amgx
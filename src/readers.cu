@@ -116,6 +116,126 @@ void skip_vals(std::ifstream &fin, int num_values)
     }
 }
 
+// true for lines holding no token, the stream reads skip them
+bool mm_blank_line(const std::string &line)
+{
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+// Row of the first non-blank line starting at or after byte pos in the entries section of a
+// row-sorted MatrixMarket file. Lines that are not entries (vector sections, end of file)
+// compare greater than any row. line_start receives the offset of that line.
+int mm_row_at(std::ifstream &fin, std::streamoff pos, int entry_tokens, std::streamoff &line_start)
+{
+    std::string line;
+    fin.clear();
+    fin.seekg(pos - 1);
+    // lands on pos itself if the previous character ends a line
+    fin.ignore(INT_MAX, '\n');
+    bool found = false;
+
+    // the last line may have no newline, getline still returns it
+    while (!found && !fin.eof())
+    {
+        line_start = fin.tellg();
+
+        if (!std::getline(fin, line))
+        {
+            break;
+        }
+
+        found = !mm_blank_line(line);
+    }
+
+    if (!found)
+    {
+        fin.clear();
+        fin.seekg(0, std::ios::end);
+        line_start = fin.tellg();
+        return INT_MAX;
+    }
+
+    std::istringstream tokens(line);
+    std::string token;
+    int num_tokens = 0;
+
+    while (tokens >> token) { num_tokens++; }
+
+    if (num_tokens != entry_tokens)
+    {
+        return INT_MAX;
+    }
+
+    int row;
+    std::istringstream(line) >> row;
+    return row;
+}
+
+// Bisection over byte offsets for the first entry line with row >= target in [lo, hi),
+// hi being the end of the file or a position known to be past the target
+std::streamoff mm_find_row(std::ifstream &fin, std::streamoff lo, std::streamoff hi, int target, int entry_tokens)
+{
+    std::streamoff line_start;
+
+    if (mm_row_at(fin, lo, entry_tokens, line_start) >= target)
+    {
+        return line_start;
+    }
+
+    while (hi - lo > 1)
+    {
+        std::streamoff mid = lo + (hi - lo) / 2;
+
+        if (mm_row_at(fin, mid, entry_tokens, line_start) >= target)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid;
+        }
+    }
+
+    mm_row_at(fin, hi, entry_tokens, line_start);
+    return line_start;
+}
+
+// number of non-blank lines in the byte range [begin, end), counting a last line that is
+// cut off by end or by the end of the file without a newline
+int mm_count_lines(std::ifstream &fin, std::streamoff begin, std::streamoff end)
+{
+    std::vector<char> buf(1 << 20);
+    int lines = 0;
+    bool in_line = false;
+    fin.clear();
+    fin.seekg(begin);
+
+    while (begin < end)
+    {
+        std::streamoff chunk = std::min<std::streamoff>(end - begin, buf.size());
+        fin.read(buf.data(), chunk);
+
+        for (std::streamoff k = 0; k < chunk; k++)
+        {
+            const char c = buf[k];
+
+            if (c == '\n')
+            {
+                lines += in_line;
+                in_line = false;
+            }
+            else if (c != ' ' && c != '\t' && c != '\r')
+            {
+                in_line = true;
+            }
+        }
+
+        begin += chunk;
+    }
+
+    return lines + in_line;
+}
+
 
 template <typename T>
 T getBoostValue();
@@ -767,7 +887,7 @@ bool ReadMatrixMarket<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
 
     // process amgx config string
     int block_dimx = 1, block_dimy = 1, index_base = 1;
-    bool diag_prop = false, rhs = false, soln = false, mtx = false, sorted = false;
+    bool diag_prop = false, rhs = false, soln = false, mtx = false, sorted = false, row_sorted = false;
     std::list<int> block_sizes;
 
     if (nvConfig.size() > 0)
@@ -782,6 +902,8 @@ bool ReadMatrixMarket<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
 
             if (*it == "sorted") {sorted = true; continue;}
 
+            if (*it == "rowsorted") {row_sorted = true; continue;}
+
             if (*it == "base0") {index_base = 0; continue;}
 
             if (isdigit((*it)[0])) { int bsize; std::istringstream(*it) >> bsize; block_sizes.push_back(bsize); continue;};
@@ -1006,9 +1128,60 @@ bool ReadMatrixMarket<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
         if (symmetric || hermitian) { has_jj = true; }
 
         int explicit_zeroes = 0;
+        // When entries are ordered by row, the rows of this partition are located by bisection
+        // over byte offsets and only those slices of the file are parsed, one slice per run of
+        // consecutive rows. The vector sections that follow are read from entries_end on.
+        int entries_to_read = entries;
+        std::streamoff entries_end = -1;
+        std::vector<std::streamoff> slice_offsets;
+        std::vector<int> slice_first_entry;
+        size_t next_slice = 0;
 
-        for (int e = 0; e < entries; e++)
+        if (!read_all && (sorted || row_sorted) && !symmetric && !hermitian && !diag_prop)
         {
+            std::vector<int> run_start;
+
+            for (int r = 0; r < n_rows_part; r++)
+            {
+                if (r == 0 || partRowVec[r] != partRowVec[r - 1] + 1)
+                {
+                    run_start.push_back(r);
+                }
+            }
+
+            run_start.push_back(n_rows_part);
+
+            // very fragmented partitions are cheaper to read with the full scan
+            if (run_start.size() - 1 <= 1024)
+            {
+                const int entry_tokens = types::util<ValueTypeA>::is_complex ? 4 : 3;
+                std::streamoff pos = fin.tellg();
+                fin.seekg(0, std::ios::end);
+                const std::streamoff file_end = fin.tellg();
+                entries_to_read = 0;
+
+                for (size_t r = 0; r + 1 < run_start.size(); r++)
+                {
+                    std::streamoff slice_begin = mm_find_row(fin, pos, file_end, partRowVec[run_start[r]] * block_dimx + index_base, entry_tokens);
+                    pos = mm_find_row(fin, slice_begin, file_end, (partRowVec[run_start[r + 1] - 1] + 1) * block_dimx + index_base, entry_tokens);
+                    slice_offsets.push_back(slice_begin);
+                    slice_first_entry.push_back(entries_to_read);
+                    entries_to_read += mm_count_lines(fin, slice_begin, pos) / block_size;
+                }
+
+                entries_end = mm_find_row(fin, pos, file_end, INT_MAX, entry_tokens);
+            }
+        }
+
+        for (int e = 0; e < entries_to_read; e++)
+        {
+            if (next_slice < slice_offsets.size() && e == slice_first_entry[next_slice])
+            {
+                fin.clear();
+                fin.seekg(slice_offsets[next_slice]);
+                next_slice++;
+            }
+
             for (int kx = 0; kx < block_dimx; kx++)
                 for (int ky = 0; ky < block_dimy; ky++)
                 {
@@ -1177,6 +1350,12 @@ bool ReadMatrixMarket<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
             }
         } // end of entries loop
 
+        if (entries_end >= 0)
+        {
+            fin.clear();
+            fin.seekg(entries_end);
+        }
+
         int diagIdx = 0;
 
         if (check_zero_diagonal)
@@ -1738,27 +1917,49 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
     int n_rows_part = partRowVec.size();
     IVector_h row_offsets_part(n_rows_part + 1);
     IVector_h row_start_glb(n_rows_part); // Store global row start positions here
-    int beginEnd[2];
     int n_nonzeros_part = 0;
+    // Rows of a partition are mostly consecutive in the file, so every section is read
+    // with one fseek/fread per run of consecutive global rows instead of one per row.
+    // run_start holds the positions in partRowVec where a run begins, plus n_rows_part.
+    std::vector<int> run_start;
+
+    for (int i = 0; i < n_rows_part; i++)
+    {
+        if (i == 0 || partRowVec[i] != partRowVec[i - 1] + 1)
+        {
+            run_start.push_back(i);
+        }
+    }
+
+    run_start.push_back(n_rows_part);
+    const int num_runs = run_start.size() - 1;
+    std::vector<int> run_offsets;
 
-    for (int i = 0; i < partRowVec.size(); i++)
+    for (int r = 0; r < num_runs; r++)
     {
-        if (fseek(fin, data_pos + partRowVec[i]*sizeof(int), SEEK_SET) != 0)
+        const int first = run_start[r];
+        const int len = run_start[r + 1] - first;
+
+        if (fseek(fin, data_pos + partRowVec[first]*sizeof(int), SEEK_SET) != 0)
         {
             FatalError("fseek error", AMGX_ERR_IO);
         }
 
-        is_read = fread(beginEnd, sizeof(int), 2, fin);
+        run_offsets.resize(len + 1);
+        is_read = fread(run_offsets.data(), sizeof(int), len + 1, fin);
 
-        if (is_read != 2)
+        if (is_read != len + 1)
         {
             err =  "fread failed reading row_offsets, exiting";
             FatalError(err, AMGX_ERR_IO);
         }
 
-        row_start_glb[i] = beginEnd[0];
-        row_offsets_part[i] = n_nonzeros_part;
-        n_nonzeros_part += beginEnd[1] - beginEnd[0];
+        for (int k = 0; k < len; k++)
+        {
+            row_start_glb[first + k] = run_offsets[k];
+            row_offsets_part[first + k] = n_nonzeros_part;
+            n_nonzeros_part += run_offsets[k + 1] - run_offsets[k];
+        }
     }
 
     row_offsets_part[n_rows_part] = n_nonzeros_part;
@@ -1797,21 +1998,21 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
     amgx::thrust::copy(row_offsets_part.begin(), row_offsets_part.end(), A.row_offsets.begin());
     cudaCheckError();
     data_pos += (num_rows + 1) * sizeof(int);
-    n_nonzeros_part = 0;
-    int row_nnz;
+    int run_nnz;
 
-    for (int i = 0; i < partRowVec.size(); i++)
+    for (int r = 0; r < num_runs; r++)
     {
-        if (fseek(fin, data_pos + sizeof(int)*row_start_glb[i], SEEK_SET) != 0)
+        const int first = run_start[r];
+
+        if (fseek(fin, data_pos + sizeof(int)*row_start_glb[first], SEEK_SET) != 0)
         {
             FatalError("fseek error", AMGX_ERR_IO);
         }
 
-        row_nnz = row_offsets_part[i + 1] - row_offsets_part[i];
-        is_read = fread(column_indices_ptr + n_nonzeros_part, sizeof(int), row_nnz, fin);
-        n_nonzeros_part += row_nnz;
+        run_nnz = row_offsets_part[run_start[r + 1]] - row_offsets_part[first];
+        is_read = fread(column_indices_ptr + row_offsets_part[first], sizeof(int), run_nnz, fin);
 
-        if (is_read != row_nnz)
+        if (is_read != run_nnz)
         {
             err = "fread failed reading column_indices, exiting";
             FatalError(err, AMGX_ERR_IO);
@@ -1822,21 +2023,21 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
     //temperary array for storing ValueTypeA data
     // double storage for complex
     std::vector< UpValueTypeA > temp(n_nonzeros_part * block_dimy * block_dimx);
-    n_nonzeros_part = 0;
 
-    for (int i = 0; i < partRowVec.size(); i++)
+    for (int r = 0; r < num_runs; r++)
     {
-        if (fseek(fin, data_pos + sizeof(UpValueTypeA)*row_start_glb[i] * block_dimy * block_dimx, SEEK_SET) != 0)
+        const int first = run_start[r];
+
+        if (fseek(fin, data_pos + sizeof(UpValueTypeA)*row_start_glb[first] * block_dimy * block_dimx, SEEK_SET) != 0)
         {
             FatalError("fseek error", AMGX_ERR_IO);
         }
 
-        row_nnz = row_offsets_part[i + 1] - row_offsets_part[i];
+        run_nnz = row_offsets_part[run_start[r + 1]] - row_offsets_part[first];
         //read in data as a ValueTypeA
-        is_read = fread(&temp[n_nonzeros_part * block_dimy * block_dimx], sizeof(UpValueTypeA), row_nnz * block_dimy * block_dimx, fin);
-        n_nonzeros_part += row_nnz;
+        is_read = fread(&temp[row_offsets_part[first] * block_dimy * block_dimx], sizeof(UpValueTypeA), run_nnz * block_dimy * block_dimx, fin);
 
-        if (is_read != row_nnz * block_dimy * block_dimx)
+        if (is_read != run_nnz * block_dimy * block_dimx)
         {
             err = "fread failed reading off-diagonal values, exiting";
             FatalError(err, AMGX_ERR_IO);
@@ -1852,16 +2053,19 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
         temp.resize(n_rows_part * block_dimx * block_dimy);
 
         //read in diagonal data as a ValueTypeA
-        for (int i = 0; i < partRowVec.size(); i++)
+        for (int r = 0; r < num_runs; r++)
         {
-            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[i] * block_dimx * block_dimy, SEEK_SET) != 0)
+            const int first = run_start[r];
+            const int len = run_start[r + 1] - first;
+
+            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[first] * block_dimx * block_dimy, SEEK_SET) != 0)
             {
                 FatalError("fseek error", AMGX_ERR_IO);
             }
 
-            is_read = fread(&temp[i * block_dimx * block_dimy], sizeof(UpValueTypeA), block_dimx * block_dimy, fin);
+            is_read = fread(&temp[first * block_dimx * block_dimy], sizeof(UpValueTypeA), len * block_dimx * block_dimy, fin);
 
-            if (is_read != block_dimx * block_dimy)
+            if (is_read != len * block_dimx * block_dimy)
             {
                 err = "fread failed reading diagonal values, exiting";
                 FatalError(err, AMGX_ERR_IO);
@@ -1886,18 +2090,21 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
 
     if (is_rhs)
     {
-        for (int i = 0; i < partRowVec.size(); i++)
+        for (int r = 0; r < num_runs; r++)
         {
-            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[i] * block_dimy, SEEK_SET) != 0)
+            const int first = run_start[r];
+            const int len = run_start[r + 1] - first;
+
+            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[first] * block_dimy, SEEK_SET) != 0)
             {
                 FatalError("fseek error", AMGX_ERR_IO);
             }
 
             //read in data as a double (doublecomplex)
-            is_read = fread(&temp[i * block_dimy], sizeof(UpValueTypeA), block_dimy, fin);
+            is_read = fread(&temp[first * block_dimy], sizeof(UpValueTypeA), len * block_dimy, fin);
 
             // if the rhs exists, we must have read the whole thing
-            if (is_read != block_dimy)
+            if (is_read != len * block_dimy)
             {
                 err = "fread failed reading rhs, exiting";
                 FatalError(err, AMGX_ERR_IO);
@@ -1923,17 +2130,20 @@ bool ReadNVAMGBinary<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec>
         x.set_block_dimy(block_dimy);
         temp.resize(n_rows_part * block_dimx);
 
-        for (int i = 0; i < partRowVec.size(); i++)
+        for (int r = 0; r < num_runs; r++)
         {
-            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[i] * block_dimx, SEEK_SET) != 0)
+            const int first = run_start[r];
+            const int len = run_start[r + 1] - first;
+
+            if (fseek(fin, data_pos + sizeof(UpValueTypeA) * partRowVec[first] * block_dimx, SEEK_SET) != 0)
             {
                 FatalError("fseek error", AMGX_ERR_IO);
             }
 
             //read in data as a double
-            is_read = fread(&temp[i * block_dimx], sizeof(UpValueTypeA), block_dimx, fin);
+            is_read = fread(&temp[first * block_dimx], sizeof(UpValueTypeA), len * block_dimx, fin);
 
-            if (is_read != block_dimx)
+            if (is_read != len * block_dimx)
             {
                 err = "fread failed reading rhs, exiting";
                 FatalError(err, AMGX_ERR_IO);
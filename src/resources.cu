@@ -7,6 +7,9 @@
 
 #include <amgx_cusparse.h>
 #include <amgx_cublas.h>
+#include <thrust_wrapper.h>
+#include <blas.h>
+#include <algorithm>
 
 namespace amgx
 {
@@ -67,6 +70,10 @@ Resources::Resources() : m_cfg_self(true), m_root_pool_expanded(false), m_tmng(n
     m_cfg->getParameter<int>("num_streams", m_num_streams, "default", solver_scope);
     m_cfg->getParameter<int>("high_priority_stream", m_high_priority_stream, "default", solver_scope);
     m_cfg->getParameter<int>("serialize_threads", m_serialize_threads, "default", solver_scope);
+    m_setup_cache.setCapacity(std::max(0, m_cfg->getParameter<int>("setup_cache_size", solver_scope)));
+    m_host_parallel_threshold = std::max(0, m_cfg->getParameter<int>("host_parallel_threshold", solver_scope));
+    m_reproducible_reductions = m_cfg->getParameter<int>("reproducible_reductions", solver_scope) != 0;
+    m_memory_accounting = m_cfg->getParameter<int>("memory_accounting", solver_scope) != 0;
     amgx::allocate_resources(m_pool_size, m_max_alloc_size, m_scaling_factor, m_scaling_threshold, m_pool_size_limit);
     // setup NV libraries
     Cusparse &c = Cusparse::get_instance();
@@ -99,6 +106,10 @@ Resources::Resources(AMG_Configuration *cfg, void *comm, int device_num, const i
     m_cfg->getParameter<int>("num_streams", m_num_streams, "default", solver_scope);
     m_cfg->getParameter<int>("high_priority_stream", m_high_priority_stream, "default", solver_scope);
     m_cfg->getParameter<int>("serialize_threads", m_serialize_threads, "default", solver_scope);
+    m_setup_cache.setCapacity(std::max(0, m_cfg->getParameter<int>("setup_cache_size", solver_scope)));
+    m_host_parallel_threshold = std::max(0, m_cfg->getParameter<int>("host_parallel_threshold", solver_scope));
+    m_reproducible_reductions = m_cfg->getParameter<int>("reproducible_reductions", solver_scope) != 0;
+    m_memory_accounting = m_cfg->getParameter<int>("memory_accounting", solver_scope) != 0;
 
     // loop over all devices
     for (int i = 0; i < device_num; i++)
@@ -143,6 +154,7 @@ Resources::~Resources()
     Cusparse &c = Cusparse::get_instance();
     c.destroy_handle();
     Cublas::destroy_handle();
+    amgx::memory::releaseMemoryOwner(this);
 
     // loop over all devices
     for (int i = 0; i < m_devices.size(); i++)
@@ -145,7 +145,7 @@ Chebyshev_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
     // Setup the preconditionner
     if (!no_preconditioner)
     {
-        m_preconditioner->setup(*this->m_A, reuse_matrix_structure);
+        m_preconditioner->setup(this->m_A->getPreconditionerOperator(), reuse_matrix_structure);
     }
 
     // The number of elements in temporary vectors.
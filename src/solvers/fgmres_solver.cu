@@ -239,6 +239,16 @@ FGMRES_Solver<T_Config>::FGMRES_Solver( AMG_Config &cfg, const std::string &cfg_
         m_krylov_size = std::min( m_krylov_size, krylov_param );
     }
 
+    m_basis_storage = getKrylovBasisStorage(cfg.AMG_Config::template getParameter<std::string>("gmres_basis_storage", cfg_scope));
+    m_fixed_preconditioner = cfg.AMG_Config::template getParameter<int>("fgmres_fixed_preconditioner", cfg_scope) != 0;
+    // with a single vector per restart x is updated every iteration and no basis is kept
+    m_compact = (m_basis_storage != KRYLOV_BASIS_FULL || m_fixed_preconditioner) && m_R > 1 && this->m_max_iters > 1;
+
+    if ( m_compact && m_krylov_size < std::min( this->m_max_iters, m_R ) )
+    {
+        FatalError("FGMRES with gmres_basis_storage other than FULL or fgmres_fixed_preconditioner=1 does not support a truncated Krylov subspace, set gmres_krylov_dim=0", AMGX_ERR_CONFIGURATION);
+    }
+
     //Using L2 norm is ok, however we will do the extra computations
     //if( this->m_norm_type != L2 )
     //  FatalError("FGMRES only works with L2 norm. Other norms would require extra computations. ", AMGX_ERR_NOT_SUPPORTED_TARGET);
@@ -262,6 +272,16 @@ FGMRES_Solver<T_Config>::printSolverParameters() const
 {
     std::cout << "gmres_n_restart=" << this->m_R << std::endl;
 
+    if (m_basis_storage != KRYLOV_BASIS_FULL)
+    {
+        std::cout << "gmres_basis_storage=" << (m_basis_storage == KRYLOV_BASIS_FLOAT ? "FLOAT" : "BFLOAT16") << std::endl;
+    }
+
+    if (m_fixed_preconditioner)
+    {
+        std::cout << "fgmres_fixed_preconditioner=1" << std::endl;
+    }
+
     if (use_preconditioner)
     {
         std::cout << "preconditioner: " << this->m_preconditioner->getName() << " with scope name: " << this->m_preconditioner->getScope() << std::endl;
@@ -274,16 +294,53 @@ FGMRES_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
 {
     if (use_preconditioner)
     {
-        m_preconditioner->setup( *this->m_A, reuse_matrix_structure );
+        m_preconditioner->setup( this->m_A->getPreconditionerOperator(), reuse_matrix_structure );
     }
 
     ViewType oldView = this->m_A->currentView();
     this->m_A->setViewExterior();
     //should we warn the user about the extra computational work?
     use_scalar_L2_norm = (this->m_nrm.size() == 1 || this->m_use_scalar_norm) && this->m_norm_type == L2;
-    subspace.setup(this->m_A->get_num_cols()*this->m_A->get_block_dimy(), this->m_A->get_block_dimy(), this->tag);
     residual.tag = (this->tag + 1) * 100 - 2;
 
+    if ( m_compact )
+    {
+        const int N = this->m_A->get_num_cols() * this->m_A->get_block_dimy();
+        const int block_dimy = this->m_A->get_block_dimy();
+        m_V_basis.setup( m_krylov_size + 1, N, block_dimy, this->tag, m_basis_storage );
+
+        if ( !m_fixed_preconditioner )
+        {
+            m_Z_basis.setup( m_krylov_size, N, block_dimy, this->tag + 1, m_basis_storage );
+        }
+
+        m_V_work.resize( 2 );
+
+        for ( int i = 0; i < 2; i++ )
+        {
+            m_V_work[i].resize( N );
+            m_V_work[i].set_block_dimy( block_dimy );
+            m_V_work[i].set_block_dimx( 1 );
+            m_V_work[i].dirtybit = 1;
+            m_V_work[i].delayed_send = 1;
+            m_V_work[i].tag = (this->tag + 1) * 100 - 4 + i;
+        }
+
+        m_Z_work.resize( N );
+        m_Z_work.set_block_dimy( block_dimy );
+        m_Z_work.set_block_dimx( 1 );
+        m_Z_work.dirtybit = 1;
+        m_Z_work.delayed_send = 1;
+        m_Z_work.tag = (this->tag + 1) * 100 - 5;
+        // the whole basis is kept, so x is only formed at the end of a restart cycle
+        update_x_every_iteration = false;
+        update_r_every_iteration = !use_scalar_L2_norm && Base::m_monitor_convergence;
+        this->m_A->setView(oldView);
+        return;
+    }
+
+    subspace.setup(this->m_A->get_num_cols()*this->m_A->get_block_dimy(), this->m_A->get_block_dimy(), this->tag);
+
     if ( this->m_R == 1 || this->m_max_iters == 1 )
     {
         update_x_every_iteration = true;
@@ -355,6 +412,7 @@ FGMRES_Solver<T_Config>::solve_init( VVector &b, VVector &x, bool xIsZero )
     residual.set_block_dimy( this->m_A->get_block_dimy() );
     residual.dirtybit = 1;
     residual.delayed_send = 1;
+    m_restart_iter = 0;
 }
 
 //check for convergence
@@ -379,7 +437,7 @@ FGMRES_Solver<TConfig>::checkConvergenceGMRES(bool check_V_0)
         {
             if ( check_V_0 )
             {
-                get_norm( A, subspace.V(0), A.get_block_dimy(), this->m_norm_type, this->m_nrm );
+                get_norm( A, m_compact ? V_work(0) : subspace.V(0), A.get_block_dimy(), this->m_norm_type, this->m_nrm );
                 return this->converged();
             }
             else
@@ -407,6 +465,11 @@ template<class T_Config>
 AMGX_STATUS
 FGMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
 {
+    if ( m_compact )
+    {
+        return solve_iteration_compact( b, x );
+    }
+
     AMGX_STATUS conv_stat = AMGX_ST_CONVERGED;
 
     Operator<T_Config> &A = *this->m_A;
@@ -568,6 +631,170 @@ FGMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
     return Base::m_monitor_convergence ? conv_stat : AMGX_ST_CONVERGED;
 }
 
+// Same iteration as above, with the basis held in m_V_basis / m_Z_basis. Each new basis vector is rounded
+// to the storage precision right away and the rounded vector is what gets preconditioned, so the
+// Arnoldi relation holds for the stored basis. With a fixed preconditioner Z is never stored and
+// x += M^-1 (V * y) is formed at the end of the cycle instead, as in GMRES.
+template<class T_Config>
+AMGX_STATUS
+FGMRES_Solver<T_Config>::solve_iteration_compact( VVector &b, VVector &x )
+{
+    AMGX_STATUS conv_stat = AMGX_ST_CONVERGED;
+
+    Operator<T_Config> &A = *this->m_A;
+    ViewType oldView = A.currentView();
+    A.setViewExterior();
+    int offset, size;
+    A.getOffsetAndSizeForView(A.getViewExterior(), &offset, &size);
+    int m = (this->m_curr_iter - m_restart_iter) % m_R; //current iteration within restart
+
+    if (m == 0)
+    {
+        // compute initial residual r0 = b - Ax
+        axmb( A, x, b, V_work(0), offset, size );
+        this->beta = get_norm(A, V_work(0), L2);
+
+        if ( (this->m_curr_iter == 0) &&
+             isDone( (conv_stat = checkConvergenceGMRES( true ) ) ) )
+        {
+            return conv_stat;
+        }
+
+        scal( V_work(0), ValueTypeB(1.0 / this->beta), offset, size );
+        thrust_wrapper::fill<AMGX_host>( m_s.begin(), m_s.end(), ValueTypeB(0.0) );
+        m_s[0] = this->beta;
+        m_V_basis.store( A, 0, V_work(0) );
+
+        if ( m_V_basis.is_compressed() )
+        {
+            m_V_basis.load( A, 0, V_work(0) );
+        }
+    }
+
+    // z_m = M^-1 v_m
+    if (use_preconditioner)
+    {
+        m_preconditioner->solve( V_work(m), m_Z_work, true );
+    }
+    else
+    {
+        copy( V_work(m), m_Z_work, offset, size );
+    }
+
+    if ( !m_fixed_preconditioner )
+    {
+        m_Z_basis.store( A, m, m_Z_work );
+
+        // apply A to the rounded z_m the solution update will use, so that the Arnoldi relation holds
+        if ( m_Z_basis.is_compressed() )
+        {
+            m_Z_basis.load( A, m, m_Z_work );
+        }
+    }
+
+    //obtain v_m+1 := A*z_m
+    A.apply( m_Z_work, V_work(m + 1) );
+
+    // Modified Gram-Schmidt against the stored basis
+    for ( int i = 0; i <= m; i++ )
+    {
+        m_H(i, m) = m_V_basis.dot( A, i, V_work(m + 1) );
+        m_V_basis.axpy( A, i, V_work(m + 1), -m_H(i, m) );
+    }
+
+    m_H(m + 1, m) = get_norm(A, V_work(m + 1), L2);
+    scal( V_work(m + 1), ValueTypeB(1.0) / m_H(m + 1, m), offset, size );
+    m_V_basis.store( A, m + 1, V_work(m + 1) );
+
+    if ( m_V_basis.is_compressed() )
+    {
+        m_V_basis.load( A, m + 1, V_work(m + 1) );
+    }
+
+    this->gamma[m] = m_s[m];
+    PlaneRotation( m_H, m_cs, m_sn, m_s, m );
+
+    if ( update_r_every_iteration )
+    {
+        // r_m = (gamma_m+1*c_m)*v_m+1 + (-gamma_m+1*s_m/gamma_m)*r_m-1)
+        if ( m == 0 )
+        {
+            axpby( V_work(1), V_work(0), residual, m_s[m + 1]*m_cs[m], ValueTypeB(-1.0 * m_s[m + 1]*m_sn[m]), offset, size );
+        }
+        else
+        {
+            axpby( V_work(m + 1), residual, residual, m_s[m + 1]*m_cs[m], ValueTypeB(-1.0 * m_s[m + 1]*m_sn[m] / gamma[m]), offset, size );
+        }
+    }
+
+    this->beta = abs( m_s[m + 1] );
+    conv_stat = checkConvergenceGMRES( false );
+
+    if ( m == m_R - 1 || this->is_last_iter() || isDone(conv_stat) )
+    {
+        // Solve upper triangular system in place
+        for (int j = m; j >= 0; j--)
+        {
+            m_s[j] /= m_H(j, j);
+
+            for (int k = j - 1; k >= 0; k--)
+            {
+                m_s[k] -= m_H(k, j) * m_s[j];
+            }
+        }
+
+        if ( m_fixed_preconditioner )
+        {
+            // x += M^-1 * [V]*m_s
+            thrust_wrapper::fill<T_Config::memSpace>( m_Z_work.begin(), m_Z_work.end(), ValueTypeB(0.0) );
+            cudaCheckError();
+
+            for (int j = 0; j <= m; j++)
+            {
+                m_V_basis.axpy( A, j, m_Z_work, m_s[j] );
+            }
+
+            m_Z_work.dirtybit = 1;
+
+            if (use_preconditioner)
+            {
+                m_preconditioner->solve( m_Z_work, V_work(0), true );
+            }
+            else
+            {
+                copy( m_Z_work, V_work(0), offset, size );
+            }
+
+            axpy( V_work(0), x, ValueTypeB(1.0), offset, size );
+        }
+        else
+        {
+            // x += [Z]*m_s
+            for (int j = 0; j <= m; j++)
+            {
+                m_Z_basis.axpy( A, j, x, m_s[j] );
+            }
+        }
+
+        // with a rounded basis the recurrences drift away from the true residual, so convergence is
+        // confirmed with b - Ax and the next iteration restarts from it if it does not hold
+        if ( (m_V_basis.is_compressed() || m_Z_basis.is_compressed()) && conv_stat == AMGX_ST_CONVERGED )
+        {
+            axmb( A, x, b, V_work(0), offset, size );
+            this->beta = get_norm(A, V_work(0), L2);
+            conv_stat = checkConvergenceGMRES( true );
+
+            if ( !isDone(conv_stat) )
+            {
+                m_restart_iter = this->m_curr_iter + 1;
+            }
+        }
+    }
+
+    A.setView(oldView);
+    return Base::m_monitor_convergence ? conv_stat : AMGX_ST_CONVERGED;
+}
+
 template<class T_Config>
 void
 FGMRES_Solver<T_Config>::solve_finalize( VVector &b, VVector &x )
@@ -41,6 +41,13 @@ GMRES_Solver<T_Config>::GMRES_Solver( AMG_Config &cfg, const std::string &cfg_sc
 
     m_R = cfg.AMG_Config::template getParameter<int>("gmres_n_restart", cfg_scope);
     m_krylov_size = std::min( this->m_max_iters, m_R );
+    m_basis_storage = getKrylovBasisStorage(cfg.AMG_Config::template getParameter<std::string>("gmres_basis_storage", cfg_scope));
+
+    // a single iteration never reads the basis back
+    if ( this->m_max_iters == 1 )
+    {
+        m_basis_storage = KRYLOV_BASIS_FULL;
+    }
 
     if ( this->m_norm_type != L2 )
     {
@@ -51,7 +58,7 @@ GMRES_Solver<T_Config>::GMRES_Solver( AMG_Config &cfg, const std::string &cfg_sc
     m_s.resize( m_krylov_size + 1 );
     m_cs.resize( m_krylov_size );
     m_sn.resize( m_krylov_size );
-    m_V_vectors.resize( m_krylov_size + 1 );
+    m_V_vectors.resize( m_basis_storage == KRYLOV_BASIS_FULL ? m_krylov_size + 1 : 2 );
 }
 
 template<class T_Config>
@@ -66,6 +73,11 @@ GMRES_Solver<T_Config>::printSolverParameters() const
 {
     std::cout << "gmres_n_restart=" << this->m_R << std::endl;
 
+    if (m_basis_storage != KRYLOV_BASIS_FULL)
+    {
+        std::cout << "gmres_basis_storage=" << (m_basis_storage == KRYLOV_BASIS_FLOAT ? "FLOAT" : "BFLOAT16") << std::endl;
+    }
+
     if (!no_preconditioner)
     {
         std::cout << "preconditioner: " << this->m_preconditioner->getName() << " with scope name: " << this->m_preconditioner->getScope() << std::endl;
@@ -85,22 +97,25 @@ GMRES_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
         FatalError( "GMRES solver only works on block matrix if configuration parameter use_scalar_norm=1", AMGX_ERR_NOT_SUPPORTED_TARGET );
     }
 
-    if (!no_preconditioner) { m_preconditioner->setup( *this->m_A, reuse_matrix_structure ); }
+    if (!no_preconditioner) { m_preconditioner->setup( this->m_A->getPreconditionerOperator(), reuse_matrix_structure ); }
 
-    // Make sure vectors already have decent sizes.
-    assert( m_V_vectors.size() >= m_krylov_size + 1 );
     // The number of elements in temporary vectors.
     const int N = static_cast<int>( this->m_A->get_num_cols() * this->m_A->get_block_dimy() );
 
     // Allocate memory needed for iterating.
-    for ( int i = 0 ; i <= m_krylov_size ; ++i )
+    for ( int i = 0 ; i < m_V_vectors.size() ; ++i )
     {
         m_V_vectors[i].resize(N);
     }
 
     m_Z_vector.resize(N);
 
-    for ( int i = 0 ; i <= m_krylov_size ; ++i )
+    if ( m_basis_storage != KRYLOV_BASIS_FULL )
+    {
+        m_basis.setup( m_krylov_size + 1, N, this->m_A->get_block_dimy(), this->tag, m_basis_storage );
+    }
+
+    for ( int i = 0 ; i < m_V_vectors.size() ; ++i )
     {
         m_V_vectors[i].set_block_dimy(this->m_A->get_block_dimy());
         m_V_vectors[i].set_block_dimx(1);
@@ -212,7 +227,9 @@ static __host__ void PlaneRotation( cusp::array2d<ValueType, cusp::host_memory,
 template<class T_Config>
 void
 GMRES_Solver<T_Config>::solve_init( VVector &b, VVector &x, bool xIsZero )
-{}
+{
+    m_restart_iter = 0;
+}
 
 template<class T_Config>
 AMGX_STATUS
@@ -283,7 +300,7 @@ GMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
 
     AMGX_STATUS conv_stat = AMGX_ST_NOT_CONVERGED;
 
-    int i = this->m_curr_iter % m_R; //current iteration within restart
+    int i = (this->m_curr_iter - m_restart_iter) % m_R; //current iteration within restart
 
     if (i == 0)
     {
@@ -305,35 +322,56 @@ GMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
         Cublas::scal( size, PodTypeB(-1.0 / beta), m_V_vectors[0].raw() + offset, 1 );                // V(0) = -V(0)/beta //
         thrust_wrapper::fill<AMGX_host>(m_s.begin(), m_s.end(), types::util<ValueTypeB>::get_zero());
         m_s[0] = types::util<ValueTypeB>::get_one() * beta;
+
+        // keep working on the rounded vector, so the preconditioner sees the basis that is stored
+        if ( m_basis.is_compressed() )
+        {
+            m_basis.store( A, 0, m_V_vectors[0] );
+            m_basis.load( A, 0, m_V_vectors[0] );
+        }
     }
 
     // Run one iteration of preconditioner with zero initial guess
     if (no_preconditioner)
     {
-        copy(m_V_vectors[i], m_Z_vector, offset, size);
+        copy(V(i), m_Z_vector, offset, size);
     }
     else
     {
-        m_V_vectors[i].delayed_send = 1;
+        V(i).delayed_send = 1;
         m_Z_vector.delayed_send = 1;
-        m_preconditioner->solve( m_V_vectors[i], m_Z_vector, true );
-        m_V_vectors[i].delayed_send = 1;
+        m_preconditioner->solve( V(i), m_Z_vector, true );
+        V(i).delayed_send = 1;
         m_Z_vector.delayed_send = 1;
     }
 
-    A.apply(m_Z_vector, m_V_vectors[i + 1]);
+    A.apply(m_Z_vector, V(i + 1));
 
     // Modified Gram-Schmidt
     for ( int k = 0; k <= i; ++k )
     {
+        if ( m_basis.is_compressed() )
+        {
+            m_H(k, i) = m_basis.dot( A, k, V(i + 1) );
+            m_basis.axpy( A, k, V(i + 1), types::util<ValueTypeB>::invert(m_H(k, i)) );
+            continue;
+        }
+
         //  H(k,i) = <V(i+1),V(k)>    //
-        m_H(k, i) = dot(A, m_V_vectors[i + 1], m_V_vectors[k]);
+        m_H(k, i) = dot(A, V(i + 1), V(k));
         // V(i+1) -= H(k, i) * V(k)  //
-        axpy( m_V_vectors[k], m_V_vectors[i + 1], types::util<ValueTypeB>::invert(m_H(k, i)), offset, size );
+        axpy( V(k), V(i + 1), types::util<ValueTypeB>::invert(m_H(k, i)), offset, size );
+    }
+
+    m_H(i + 1, i) = types::util<ValueTypeB>::get_one() * get_norm(A, V(i + 1), L2);
+    scal( V(i + 1), types::util<ValueTypeB>::get_one() / m_H(i + 1, i), offset, size );
+
+    if ( m_basis.is_compressed() )
+    {
+        m_basis.store( A, i + 1, V(i + 1) );
+        m_basis.load( A, i + 1, V(i + 1) );
     }
 
-    m_H(i + 1, i) = types::util<ValueTypeB>::get_one() * get_norm(A, m_V_vectors[i + 1], L2);
-    scal( m_V_vectors[i + 1], types::util<ValueTypeB>::get_one() / m_H(i + 1, i), offset, size );
     PlaneRotation( m_H, m_cs, m_sn, m_s, i );
 
     // Check for convergence
@@ -365,7 +403,14 @@ GMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
 
         for (int j = 0; j <= i; j++)
         {
-            axpy( m_V_vectors[j], m_Z_vector, m_s[j], offset, size );
+            if ( m_basis.is_compressed() )
+            {
+                m_basis.axpy( A, j, m_Z_vector, m_s[j] );
+            }
+            else
+            {
+                axpy( m_V_vectors[j], m_Z_vector, m_s[j], offset, size );
+            }
         }
 
         // Call the preconditioner to get M^-1*(sum_m vm*ym), store in m_V_Vectors[0]
@@ -385,6 +430,21 @@ GMRES_Solver<T_Config>::solve_iteration( VVector &b, VVector &x, bool xIsZero )
         // Update the solution
         // Add to x0
         axpy( m_V_vectors[0], x, types::util<ValueTypeB>::get_one(), offset, size );
+
+        // with a rounded basis the estimate |s[i+1]| drifts away from the true residual, so convergence
+        // is confirmed with b - Ax and the next iteration restarts from it if it does not hold
+        if ( m_basis.is_compressed() && conv_stat == AMGX_ST_CONVERGED )
+        {
+            A.apply(x, m_V_vectors[0]);
+            axpy( b, m_V_vectors[0], types::util<ValueTypeB>::get_minus_one(), offset, size );
+            this->m_nrm[0] = get_norm(A, m_V_vectors[0], L2);
+            conv_stat = this->converged();
+
+            if ( !isDone(conv_stat) )
+            {
+                m_restart_iter = this->m_curr_iter + 1;
+            }
+        }
     }
 
     this->m_A->setView(oldView);
@@ -123,7 +123,7 @@ IDR_Solver_Base<T_Config>::solver_setup(bool reuse_matrix_structure)
     // Setup the preconditionner
     if (!no_preconditioner)
     {
-        m_preconditioner->setup(A, reuse_matrix_structure);
+        m_preconditioner->setup(A.getPreconditionerOperator(), reuse_matrix_structure);
     }
 
     A.setView(oldView);
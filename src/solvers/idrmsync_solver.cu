@@ -193,7 +193,7 @@ IDRMSYNC_Solver_Base<T_Config>::solver_setup(bool reuse_matrix_structure)
     // Setup the preconditionner
     if (!no_preconditioner)
     {
-        m_preconditioner->setup(*this->m_A, reuse_matrix_structure);
+        m_preconditioner->setup(this->m_A->getPreconditionerOperator(), reuse_matrix_structure);
     }
 
     this->m_A->setView(oldView);
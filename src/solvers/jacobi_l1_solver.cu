@@ -169,6 +169,40 @@ __global__ void jacobi_smooth_kernel(const IndexType num_rows,
 }
 
 
+// one sweep on x + e[aggregates], the corrected vector is never stored
+template<typename IndexType, typename ValueTypeA, typename ValueTypeB>
+__global__ void jacobi_smooth_with_correction_kernel(const IndexType num_rows,
+        const IndexType *Ap,
+        const IndexType *Aj,
+        const ValueTypeA *Ax,
+        const ValueTypeA *d,
+        const ValueTypeB *b,
+        const ValueTypeB *x,
+        const ValueTypeB *e,
+        const IndexType *aggregates,
+        const ValueTypeB omega,
+        ValueTypeB *xout)
+{
+    IndexType tidx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    for (int ridx = tidx; ridx < num_rows; ridx += blockDim.x * gridDim.x)
+    {
+        IndexType row_start = Ap[ridx];
+        IndexType row_end   = Ap[ridx + 1];
+        ValueTypeB Axi = 0.0;
+
+        for (int j = row_start; j < row_end; j++)
+        {
+            IndexType col = Aj[j];
+            Axi += Ax[j] * (x[col] + e[aggregates[col]]);
+        }
+
+        ValueTypeA dd = d[ridx];
+        xout[ridx] = x[ridx] + e[aggregates[ridx]] + omega * (b[ridx] - Axi) / ( isNotCloseToZero(dd) ? dd : epsilon(dd) );
+    }
+}
+
+
 template<typename IndexType, typename ValueTypeA, typename ValueTypeB, int blockrows_per_cta, int blockrows_per_warp, int bsize>
 __global__ void jacobi_smooth_4x4_kernel(const IndexType num_rows,
         const IndexType *row_offsets,
@@ -456,6 +490,23 @@ JacobiL1Solver_Base<T_Config>::solve_finalize( VVector &b, VVector &x )
 {
 }
 
+template<class T_Config>
+bool
+JacobiL1Solver_Base<T_Config>::smooth_with_correction( VVector &b, VVector &x, const VVector &e, const IVector &aggregates )
+{
+    Matrix<T_Config> &A = *this->m_explicit_A;
+
+    // the fused sweep reads x without a halo exchange
+    if (A.get_block_dimx() != 1 || A.get_block_dimy() != 1 || A.hasProps(DIAG) || !A.is_matrix_singleGPU() || x.size() != A.get_num_rows())
+    {
+        return false;
+    }
+
+    smooth_with_correction_1x1(A, b, x, e, aggregates);
+    x.dirtybit = 1;
+    return true;
+}
+
 
 
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
@@ -482,6 +533,31 @@ void JacobiL1Solver<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >
 }
 
 
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void JacobiL1Solver<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::smooth_with_correction_1x1(Matrix_h &A, VVector &b, VVector &x, const VVector &e, const typename Matrix_h::IVector &aggregates)
+{
+    VVector newx((int)x.size());
+
+    //for each row
+    for (int i = 0; i < A.get_num_rows(); i++)
+    {
+        ValueTypeB Axi = 0.0;
+
+        //for each column, on the corrected x
+        for (int j = A.row_offsets[i]; j < A.row_offsets[i + 1]; j++)
+        {
+            int col = A.col_indices[j];
+            Axi += A.values[j] * (x[col] + e[aggregates[col]]);
+        }
+
+        ValueTypeA d = this->m_d[i];
+        newx[i] = x[i] + e[aggregates[i]] + (b[i] - Axi) /  ( isNotCloseToZero( d) ? d : epsilon(d) );
+    }
+
+    x.swap(newx);
+}
+
+
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void JacobiL1Solver<TemplateConfig<AMGX_host, t_vecPrec, t_matPrec, t_indPrec> >::smooth_4x4(Matrix_h &A, VVector &b, VVector &x, ViewType separation_flags)
 {
@@ -519,6 +595,19 @@ void JacobiL1Solver<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec>
 }
 
 
+template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
+void JacobiL1Solver<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::smooth_with_correction_1x1(Matrix_d &A, VVector &b, VVector &x, const VVector &e, const IVector &aggregates)
+{
+    VVector xout(x.size());
+    const int num_rows = A.get_num_rows();
+    const int nthreads_per_block = 128;
+    const int nblocks = std::min( AMGX_GRID_MAX_SIZE, num_rows / nthreads_per_block + 1 );
+    jacobi_smooth_with_correction_kernel<<<nblocks, nthreads_per_block>>>(num_rows, A.row_offsets.raw(), A.col_indices.raw(), A.values.raw(), this->m_d.raw(), b.raw(), x.raw(), e.raw(), aggregates.raw(), this->weight, xout.raw());
+    cudaCheckError();
+    x.swap(xout);
+}
+
+
 template <AMGX_VecPrecision t_vecPrec, AMGX_MatPrecision t_matPrec, AMGX_IndPrecision t_indPrec>
 void JacobiL1Solver<TemplateConfig<AMGX_device, t_vecPrec, t_matPrec, t_indPrec> >::smooth_4x4(Matrix_d &A, VVector &b, VVector &x, ViewType separation_flags)
 {
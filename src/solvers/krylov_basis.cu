@@ -0,0 +1,395 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <solvers/krylov_basis.h>
+#include <blas.h>
+#include <error.h>
+#include <thrust_wrapper.h>
+#include <amgx_types/util.h>
+#include <distributed/distributed_manager.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/functional.h>
+#include <string.h>
+
+namespace amgx
+{
+
+KrylovBasisStorage getKrylovBasisStorage(const std::string &name)
+{
+    if (name == "FULL")
+    {
+        return KRYLOV_BASIS_FULL;
+    }
+
+    if (name == "FLOAT")
+    {
+        return KRYLOV_BASIS_FLOAT;
+    }
+
+    if (name == "BFLOAT16")
+    {
+        return KRYLOV_BASIS_BFLOAT16;
+    }
+
+    FatalError("Unknown Krylov basis storage " + name + ", expected FULL, FLOAT or BFLOAT16", AMGX_ERR_CONFIGURATION);
+}
+
+namespace
+{
+
+// bfloat16 is the upper half of a float, rounded to nearest even
+struct encode_bfloat16
+{
+    template <class T>
+    __host__ __device__ uint16_t operator()(const T &x) const
+    {
+        float f = static_cast<float>(x);
+        uint32_t u;
+        memcpy(&u, &f, sizeof(u));
+        u += 0x7fffu + ((u >> 16) & 1u);
+        return static_cast<uint16_t>(u >> 16);
+    }
+};
+
+template <class T>
+struct decode_bfloat16
+{
+    __host__ __device__ T operator()(const uint16_t &x) const
+    {
+        uint32_t u = static_cast<uint32_t>(x) << 16;
+        float f;
+        memcpy(&f, &u, sizeof(f));
+        return static_cast<T>(f);
+    }
+};
+
+template <class From, class To>
+struct convert_value
+{
+    __host__ __device__ To operator()(const From &x) const { return static_cast<To>(x); }
+};
+
+template <class T>
+struct krylov_basis_product
+{
+    template <class Tuple>
+    __host__ __device__ T operator()(const Tuple &t) const
+    {
+        return static_cast<T>(amgx::thrust::get<0>(t)) * static_cast<T>(amgx::thrust::get<1>(t));
+    }
+};
+
+template <class T>
+struct krylov_basis_axpy
+{
+    T alpha;
+    krylov_basis_axpy(T alpha) : alpha(alpha) {}
+    __host__ __device__ T operator()(const T &v, const T &w) const { return alpha * v + w; }
+};
+
+// the fused kernels, written against the decoded view of a compressed vector
+template <AMGX_MemorySpace MemSpace, class T, class Container, class Decoder>
+struct CompressedBasisOps
+{
+    template <class ConstPointer, class Encoder>
+    static void store(Container &v, ConstPointer w, int offset, int size, Encoder encode)
+    {
+        thrust_wrapper::transform<MemSpace>(w + offset, w + offset + size, v.begin() + offset, encode);
+    }
+
+    template <class Pointer>
+    static void load(const Container &v, Pointer w, int offset, int size)
+    {
+        thrust_wrapper::transform<MemSpace>(v.begin() + offset, v.begin() + offset + size, w + offset, Decoder());
+    }
+
+    template <class ConstPointer>
+    static T dot(const Container &v, ConstPointer w, int offset, int size)
+    {
+        typedef amgx::thrust::transform_iterator<Decoder, typename Container::const_iterator> DecodedIterator;
+        DecodedIterator decoded(v.begin() + offset, Decoder());
+        return thrust_wrapper::transform_reduce<MemSpace>(
+                   amgx::thrust::make_zip_iterator(amgx::thrust::make_tuple(decoded, w + offset)),
+                   amgx::thrust::make_zip_iterator(amgx::thrust::make_tuple(decoded + size, w + offset + size)),
+                   krylov_basis_product<T>(), T(0), amgx::thrust::plus<T>());
+    }
+
+    template <class Pointer>
+    static void axpy(const Container &v, Pointer w, T alpha, int offset, int size)
+    {
+        typedef amgx::thrust::transform_iterator<Decoder, typename Container::const_iterator> DecodedIterator;
+        DecodedIterator decoded(v.begin() + offset, Decoder());
+        thrust_wrapper::transform<MemSpace>(decoded, decoded + size, w + offset, w + offset, krylov_basis_axpy<T>(alpha));
+    }
+};
+
+// raw pointers of the working vectors, wrapped for the memory space so thrust dispatches correctly
+template <AMGX_MemorySpace MemSpace>
+struct KrylovBasisPointer;
+
+template <>
+struct KrylovBasisPointer<AMGX_host>
+{
+    template <class T> static T *wrap(T *p) { return p; }
+};
+
+template <>
+struct KrylovBasisPointer<AMGX_device>
+{
+    template <class T> static amgx::thrust::device_ptr<T> wrap(T *p) { return amgx::thrust::device_pointer_cast(p); }
+};
+
+template <class TConfig, bool IsComplex>
+struct KrylovBasisCompressed;
+
+template <class TConfig>
+struct KrylovBasisCompressed<TConfig, true>
+{
+    typedef KrylovBasis<TConfig> Basis;
+    typedef typename Basis::ValueTypeB ValueTypeB;
+
+    static void store(typename Basis::FloatVector *, typename Basis::Bfloat16Vector *, const ValueTypeB *, int, int)
+    {
+        FatalError("Compressed Krylov basis storage is not supported for complex values", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+
+    static void load(const typename Basis::FloatVector *, const typename Basis::Bfloat16Vector *, ValueTypeB *, int, int)
+    {
+        FatalError("Compressed Krylov basis storage is not supported for complex values", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+
+    static ValueTypeB dot(const typename Basis::FloatVector *, const typename Basis::Bfloat16Vector *, const ValueTypeB *, int, int)
+    {
+        FatalError("Compressed Krylov basis storage is not supported for complex values", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+
+    static void axpy(const typename Basis::FloatVector *, const typename Basis::Bfloat16Vector *, ValueTypeB *, ValueTypeB, int, int)
+    {
+        FatalError("Compressed Krylov basis storage is not supported for complex values", AMGX_ERR_NOT_IMPLEMENTED);
+    }
+};
+
+// exactly one of the float / bfloat16 vectors is non-null
+template <class TConfig>
+struct KrylovBasisCompressed<TConfig, false>
+{
+    typedef KrylovBasis<TConfig> Basis;
+    typedef typename Basis::ValueTypeB ValueTypeB;
+    typedef KrylovBasisPointer<TConfig::memSpace> Ptr;
+    typedef CompressedBasisOps<TConfig::memSpace, ValueTypeB, typename Basis::FloatVector, convert_value<float, ValueTypeB> > FloatOps;
+    typedef CompressedBasisOps<TConfig::memSpace, ValueTypeB, typename Basis::Bfloat16Vector, decode_bfloat16<ValueTypeB> > Bfloat16Ops;
+
+    static void store(typename Basis::FloatVector *f, typename Basis::Bfloat16Vector *h, const ValueTypeB *w, int offset, int size)
+    {
+        if (f != NULL)
+        {
+            FloatOps::store(*f, Ptr::wrap(w), offset, size, convert_value<ValueTypeB, float>());
+        }
+        else
+        {
+            Bfloat16Ops::store(*h, Ptr::wrap(w), offset, size, encode_bfloat16());
+        }
+    }
+
+    static void load(const typename Basis::FloatVector *f, const typename Basis::Bfloat16Vector *h, ValueTypeB *w, int offset, int size)
+    {
+        if (f != NULL)
+        {
+            FloatOps::load(*f, Ptr::wrap(w), offset, size);
+        }
+        else
+        {
+            Bfloat16Ops::load(*h, Ptr::wrap(w), offset, size);
+        }
+    }
+
+    static ValueTypeB dot(const typename Basis::FloatVector *f, const typename Basis::Bfloat16Vector *h, const ValueTypeB *w, int offset, int size)
+    {
+        return (f != NULL) ? FloatOps::dot(*f, Ptr::wrap(w), offset, size) : Bfloat16Ops::dot(*h, Ptr::wrap(w), offset, size);
+    }
+
+    static void axpy(const typename Basis::FloatVector *f, const typename Basis::Bfloat16Vector *h, ValueTypeB *w, ValueTypeB alpha, int offset, int size)
+    {
+        if (f != NULL)
+        {
+            FloatOps::axpy(*f, Ptr::wrap(w), alpha, offset, size);
+        }
+        else
+        {
+            Bfloat16Ops::axpy(*h, Ptr::wrap(w), alpha, offset, size);
+        }
+    }
+};
+
+} // anonymous namespace
+
+template <class TConfig>
+void KrylovBasis<TConfig>::setup(int num_vectors, int N, int block_dimy, int tag, KrylovBasisStorage storage)
+{
+    if (storage != KRYLOV_BASIS_FULL && types::util<ValueTypeB>::is_complex)
+    {
+        FatalError("Compressed Krylov basis storage is not supported for complex values, use FULL", AMGX_ERR_NOT_SUPPORTED_TARGET);
+    }
+
+    if (storage != m_storage)
+    {
+        clear();
+    }
+
+    m_storage = storage;
+
+    switch (m_storage)
+    {
+        case KRYLOV_BASIS_FULL:
+            m_full.resize(num_vectors);
+
+            for (int i = 0; i < num_vectors; i++)
+            {
+                m_full[i].resize(N);
+                m_full[i].set_block_dimy(block_dimy);
+                m_full[i].set_block_dimx(1);
+                m_full[i].dirtybit = 1;
+                m_full[i].delayed_send = 1;
+                m_full[i].tag = tag * 100 + i;
+            }
+
+            break;
+
+        case KRYLOV_BASIS_FLOAT:
+            m_float.resize(num_vectors);
+
+            for (int i = 0; i < num_vectors; i++)
+            {
+                m_float[i].resize(N);
+            }
+
+            break;
+
+        case KRYLOV_BASIS_BFLOAT16:
+            m_bfloat16.resize(num_vectors);
+
+            for (int i = 0; i < num_vectors; i++)
+            {
+                m_bfloat16[i].resize(N);
+            }
+
+            break;
+    }
+}
+
+template <class TConfig>
+void KrylovBasis<TConfig>::clear()
+{
+    m_full.clear();
+    m_float.clear();
+    m_bfloat16.clear();
+}
+
+template <class TConfig>
+int KrylovBasis<TConfig>::get_num_vectors() const
+{
+    switch (m_storage)
+    {
+        case KRYLOV_BASIS_FLOAT:
+            return static_cast<int>(m_float.size());
+
+        case KRYLOV_BASIS_BFLOAT16:
+            return static_cast<int>(m_bfloat16.size());
+
+        default:
+            return static_cast<int>(m_full.size());
+    }
+}
+
+template <class TConfig>
+void KrylovBasis<TConfig>::store(const Operator<TConfig> &A, int i, const VVector &w)
+{
+    int offset, size;
+    A.getOffsetAndSizeForView(A.getViewExterior(), &offset, &size);
+
+    if (!is_compressed())
+    {
+        copy(w, m_full[i], offset, size);
+        m_full[i].dirtybit = 1;
+        return;
+    }
+
+    KrylovBasisCompressed<TConfig, types::util<ValueTypeB>::is_complex>::store(
+        m_storage == KRYLOV_BASIS_FLOAT ? &m_float[i] : NULL, m_storage == KRYLOV_BASIS_BFLOAT16 ? &m_bfloat16[i] : NULL,
+        w.raw(), offset, size);
+    cudaCheckError();
+}
+
+template <class TConfig>
+void KrylovBasis<TConfig>::load(const Operator<TConfig> &A, int i, VVector &w) const
+{
+    int offset, size;
+    A.getOffsetAndSizeForView(A.getViewExterior(), &offset, &size);
+
+    if (!is_compressed())
+    {
+        copy(m_full[i], w, offset, size);
+    }
+    else
+    {
+        KrylovBasisCompressed<TConfig, types::util<ValueTypeB>::is_complex>::load(
+            m_storage == KRYLOV_BASIS_FLOAT ? &m_float[i] : NULL, m_storage == KRYLOV_BASIS_BFLOAT16 ? &m_bfloat16[i] : NULL,
+            w.raw(), offset, size);
+        cudaCheckError();
+    }
+
+    w.dirtybit = 1;
+}
+
+template <class TConfig>
+typename KrylovBasis<TConfig>::ValueTypeB KrylovBasis<TConfig>::dot(const Operator<TConfig> &A, int i, const VVector &w) const
+{
+    if (!is_compressed())
+    {
+        return amgx::dot(A, m_full[i], w);
+    }
+
+    int offset, size;
+    A.getOffsetAndSizeForView(A.getViewExterior(), &offset, &size);
+    ValueTypeB reduce = KrylovBasisCompressed<TConfig, types::util<ValueTypeB>::is_complex>::dot(
+                            m_storage == KRYLOV_BASIS_FLOAT ? &m_float[i] : NULL, m_storage == KRYLOV_BASIS_BFLOAT16 ? &m_bfloat16[i] : NULL,
+                            w.raw(), offset, size);
+
+    if (A.is_matrix_distributed())
+    {
+        A.getManager()->global_reduce_sum(&reduce);
+    }
+
+    cudaCheckError();
+    return reduce;
+}
+
+template <class TConfig>
+void KrylovBasis<TConfig>::axpy(const Operator<TConfig> &A, int i, VVector &w, ValueTypeB alpha) const
+{
+    int offset, size;
+    A.getOffsetAndSizeForView(A.getViewExterior(), &offset, &size);
+
+    if (!is_compressed())
+    {
+        amgx::axpy(m_full[i], w, alpha, offset, size);
+        return;
+    }
+
+    KrylovBasisCompressed<TConfig, types::util<ValueTypeB>::is_complex>::axpy(
+        m_storage == KRYLOV_BASIS_FLOAT ? &m_float[i] : NULL, m_storage == KRYLOV_BASIS_BFLOAT16 ? &m_bfloat16[i] : NULL,
+        w.raw(), alpha, offset, size);
+    cudaCheckError();
+}
+
+/****************************************
+ * Explict instantiations
+ ***************************************/
+#define AMGX_CASE_LINE(CASE) template class KrylovBasis<TemplateMode<CASE>::Type>;
+AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+AMGX_FORCOMPLEX_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
+} // namespace amgx
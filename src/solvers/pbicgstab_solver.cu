@@ -112,7 +112,7 @@ PBiCGStab_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
     // Setup the preconditioner.
     if (!no_preconditioner)
     {
-        m_preconditioner->setup( *this->m_A, reuse_matrix_structure );
+        m_preconditioner->setup( this->m_A->getPreconditionerOperator(), reuse_matrix_structure );
     }
 
     this->m_A->setView(oldView);
@@ -46,7 +46,7 @@ PCG_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
 
     if (!no_preconditioner)
     {
-        m_preconditioner->setup(*this->m_A, reuse_matrix_structure);
+        m_preconditioner->setup(this->m_A->getPreconditionerOperator(), reuse_matrix_structure);
     }
 
     // The number of elements in temporary vectors.
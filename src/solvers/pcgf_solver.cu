@@ -41,7 +41,7 @@ PCGF_Solver<T_Config>::solver_setup(bool reuse_matrix_structure)
 {
     if (!no_preconditioner)
     {
-        m_preconditioner->setup( *this->m_A, reuse_matrix_structure );
+        m_preconditioner->setup( this->m_A->getPreconditionerOperator(), reuse_matrix_structure );
     }
 
     // The number of elements in temporary vectors.
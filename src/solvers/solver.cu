@@ -5,6 +5,7 @@
 #include <solvers/solver.h>
 #include <scalers/scaler.h>
 #include <assert.h>
+#include <algorithm>
 #include <blas.h>
 #include <multiply.h>
 #include <util.h>
@@ -28,7 +29,8 @@ Solver<TConfig>::Solver(AMG_Config &cfg, const std::string &cfg_scope,
                         ThreadManager *tmng) :
     m_cfg(&cfg), m_cfg_scope(cfg_scope), m_is_solver_setup(false), m_A(NULL), 
     m_r(NULL), m_num_iters(0), m_curr_iter(0), m_ref_count(1), tag(0), 
-    m_solver_name("SolverNameNotSet"), m_skip_glued_setup(false), m_tmng(tmng)
+    m_solver_name("SolverNameNotSet"), m_skip_glued_setup(false), m_tmng(tmng),
+    m_lagged_nrm(NULL), m_lagged_issued(0), m_nrm_exact(true), m_nrm_lag(0)
 {
     m_norm_factor = types::util<PODValueB>::get_one();
     m_verbosity_level = cfg.getParameter<int>("verbosity_level", cfg_scope);
@@ -36,6 +38,8 @@ Solver<TConfig>::Solver(AMG_Config &cfg, const std::string &cfg_scope,
     m_monitor_residual = cfg.getParameter<int>("monitor_residual", cfg_scope) != 0;
     m_store_res_history = cfg.getParameter<int>("store_res_history", cfg_scope) != 0;
     m_obtain_timings = cfg.getParameter<int>("obtain_timings", cfg_scope) != 0;
+    m_check_frequency = std::max(1, cfg.getParameter<int>("convergence_check_frequency", cfg_scope));
+    m_check_lag = std::max(0, cfg.getParameter<int>("convergence_check_lag", cfg_scope));
     m_scaling = cfg.getParameter<std::string>("scaling", cfg_scope);
 
     if ( m_scaling.compare("NONE") != 0 ) //create scaler object
@@ -72,6 +76,11 @@ Solver<TConfig>::Solver(AMG_Config &cfg, const std::string &cfg_scope,
             "Cannot store residual information if residual is not monitored (i.e. store_res_history=1 and monitor_residual=0) ",
             AMGX_ERR_BAD_PARAMETERS);
 
+    if (m_store_res_history && (m_check_frequency > 1 || m_check_lag > 0))
+        FatalError(
+            "Cannot store residual information if the residual is not checked at every iteration (i.e. store_res_history=1 and convergence_check_frequency>1 or convergence_check_lag>0) ",
+            AMGX_ERR_BAD_PARAMETERS);
+
     // Get the max number of iterations/the type of norm and the convergence object.
     m_max_iters = cfg.getParameter<int>("max_iters", cfg_scope);
     m_norm_type = cfg.getParameter<NormType>("norm", cfg_scope);
@@ -129,6 +138,16 @@ Solver<TConfig>::~Solver() noexcept(false)
         cudaEventDestroy(m_iter_stop);
     }
 
+    if (m_lagged_nrm != NULL)
+    {
+        for (int i = 0; i < m_lagged_events.size(); i++)
+        {
+            cudaEventDestroy(m_lagged_events[i]);
+        }
+
+        amgx::memory::cudaFreeHost(m_lagged_nrm);
+    }
+
     delete m_r;
     delete m_convergence;
 
@@ -253,6 +272,14 @@ AMGX_STATUS Solver<TConfig>::converged(const VVector &b, VVector &x)
 {
     AMGX_CPU_PROFILER( "Solver::converged_bx " );
 
+    // neither the residual nor its norm are needed between two checks
+    if (m_monitor_convergence && !is_check_iter())
+    {
+        m_nrm_exact = false;
+        m_nrm_lag = -1;
+        return AMGX_ST_NOT_CONVERGED;
+    }
+
     if (m_monitor_residual)
     {
         this->compute_residual(b, x);
@@ -262,13 +289,77 @@ AMGX_STATUS Solver<TConfig>::converged(const VVector &b, VVector &x)
 
     if (m_monitor_convergence)
     {
+        if (m_check_lag > 0)
+        {
+            return lagged_norm_and_converged();
+        }
+
         this->compute_norm();
+        m_nrm_lag = 0;
         converged = this->converged();
     }
 
     return converged;
 }
 
+template<class TConfig>
+AMGX_STATUS Solver<TConfig>::lagged_norm_and_converged()
+{
+    AMGX_CPU_PROFILER( "Solver::lagged_norm_and_converged " );
+    const bool scalar_norm = m_use_scalar_norm || m_A->get_block_dimy() == 1;
+    const bool async_norm = TConfig::memSpace == AMGX_device && scalar_norm && !m_A->is_matrix_distributed() &&
+                            (m_norm_type == L1 || m_norm_type == L1_SCALED || m_norm_type == L2);
+
+    // The last iteration decides on the current norm, so does everything without an asynchronous norm.
+    if (!async_norm || is_last_iter())
+    {
+        compute_norm();
+        m_nrm_exact = true;
+        m_nrm_lag = 0;
+        return converged();
+    }
+
+    const int num_slots = m_check_lag + 1;
+
+    if (m_lagged_nrm == NULL)
+    {
+        amgx::memory::cudaMallocHost((void **) &m_lagged_nrm, num_slots * sizeof(PODValueB));
+        m_lagged_events.resize(num_slots);
+
+        for (int i = 0; i < num_slots; i++)
+        {
+            cudaEventCreateWithFlags(&m_lagged_events[i], cudaEventDisableTiming);
+        }
+
+        cudaCheckError();
+    }
+
+    // The slot written now was read by the previous check, the copy is ordered behind the work on m_r.
+    const int slot = m_lagged_issued % num_slots;
+    int offset, size;
+    m_A->getOffsetAndSizeForView(OWNED, &offset, &size);
+    nrm_async(*m_r, m_norm_type == L2, m_lagged_nrm + slot, offset, size);
+    cudaEventRecord(m_lagged_events[slot], amgx::thrust::global_thread_handle::get_stream());
+    m_lagged_issued++;
+
+    if (m_lagged_issued <= m_check_lag)
+    {
+        m_nrm_exact = false;
+        m_nrm_lag = -1;
+        return AMGX_ST_NOT_CONVERGED;
+    }
+
+    const int ready = (m_lagged_issued - 1 - m_check_lag) % num_slots;
+    cudaEventSynchronize(m_lagged_events[ready]);
+    const PODValueB nrm = m_lagged_nrm[ready];
+    m_nrm.resize(1);
+    m_nrm[0] = (m_norm_type == L2) ? sqrt(nrm) : (m_norm_type == L1_SCALED ? nrm / m_norm_factor : nrm);
+    m_nrm_exact = false;
+    // checks are m_check_frequency iterations apart, the last iteration never takes the lagged path
+    m_nrm_lag = m_check_lag * m_check_frequency;
+    return converged();
+}
+
 template<class TConfig>
 AMGX_STATUS Solver<TConfig>::converged() const
 {
@@ -321,6 +412,9 @@ template<class TConfig>
 void Solver<TConfig>::setup( Operator<TConfig> &A, bool reuse_matrix_structure)
 {
     AMGX_CPU_PROFILER("Solver::setup ");
+    // smoothers and coarse solvers run inside the AMG setup keep the tag it set
+    amgx::memory::MemoryTagScope memory_tag(amgx::memory::getMemoryTag() == amgx::memory::MEMORY_TAG_OTHER ?
+                                            amgx::memory::MEMORY_TAG_SOLVER : amgx::memory::getMemoryTag());
 
     if (m_verbose)
     {
@@ -434,12 +528,14 @@ void Solver<TConfig>::setup( Operator<TConfig> &A, bool reuse_matrix_structure)
 /// Current implementation is very slow due to all of those scales/unscales, but it produces _correct_ convergence checks.
 /// The way to get rid of these computations: custom kernels of residual norm calculations that will unscale/scale on the fly using current scaler.
     Matrix<TConfig> *m_A =  dynamic_cast<Matrix<TConfig>*>(this->m_A);
-    Matrix<TConfig> &mref_A = *m_A;
-    m_A->template setParameter<int>("scaled", 0);
+
+    if (m_A)
+    {
+        m_A->template setParameter<int>("scaled", 0);
+    }
 
     if ( m_scaling.compare("NONE") != 0 )
     {
-        int lvl = m_A->template getParameter<int>("level");
         // We should not scale if it is preconditioner for some outer solver - in this case finest level matrix will be already scaled.
         // However this could be avoided by providing scaling parameter for outer solver and not inner (or vice versa)
         {
@@ -448,6 +544,7 @@ void Solver<TConfig>::setup( Operator<TConfig> &A, bool reuse_matrix_structure)
                 FatalError("Matrix scaling only works with explicit matrices, set scaling=NONE for operators.", AMGX_ERR_INTERNAL);
             }
 
+            Matrix<TConfig> &mref_A = *m_A;
             m_Scaler->setup( mref_A );
             m_Scaler->scaleMatrix( mref_A, amgx::SCALE );
             m_A->template setParameter<int>("scaled", 1);
@@ -459,14 +556,14 @@ void Solver<TConfig>::setup( Operator<TConfig> &A, bool reuse_matrix_structure)
 
     if ( m_scaling.compare("NONE") != 0 )
     {
-        m_Scaler->scaleMatrix( mref_A, amgx::UNSCALE );
+        m_Scaler->scaleMatrix( *m_A, amgx::UNSCALE );
     }
 
     // Setup the solver
     // Allocate residual vector if needed
     if (m_monitor_residual || is_residual_needed())
     {
-        int needed_size = m_A->get_num_cols() * m_A->get_block_dimy();
+        int needed_size = this->m_A->get_num_cols() * this->m_A->get_block_dimy();
 
         if (m_r == NULL)
         {
@@ -483,7 +580,7 @@ void Solver<TConfig>::setup( Operator<TConfig> &A, bool reuse_matrix_structure)
         }
 
         assert(m_r != NULL && m_r->size() >= needed_size);
-        m_r->set_block_dimy(m_A->get_block_dimy());
+        m_r->set_block_dimy(this->m_A->get_block_dimy());
         m_r->set_block_dimx(1);
         m_r->delayed_send = 1;
     }
@@ -674,6 +771,8 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
 
     // If we monitor convergence, we compute the norm of the residual.
     PODVector_h last_nrm;
+    // Iteration of last_nrm, the initial residual comes before iteration 0
+    int last_nrm_iter = -1;
 
     if (m_monitor_convergence)
     {
@@ -777,12 +876,15 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
     }
 
     AMGX_STATUS conv_stat = AMGX_ST_NOT_CONVERGED;
+    m_lagged_issued = 0;
+    m_nrm_exact = true;
 
     // Run the iterations
     std::stringstream ss;
 
     for (m_curr_iter = 0; m_curr_iter < m_max_iters && !done; ++m_curr_iter)
     {
+        m_nrm_lag = 0;
         // Run one iteration. Compute residual and its norm and decide convergence
         conv_stat = solve_iteration(b, x, xIsZero);
         // Make sure x is not zero anymore.
@@ -790,8 +892,11 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
         // Is it done ?
         done = m_monitor_convergence && isDone(conv_stat);
 
-        // If we print stats... Let's do it.
-        if (m_verbosity_level > 2 && getPrintSolveStats())
+        // If we print stats... Let's do it. Iterations between two checks have no norm to print,
+        // a lagged norm is labelled with the iteration it belongs to.
+        const int nrm_iter = m_curr_iter - m_nrm_lag;
+
+        if (m_verbosity_level > 2 && getPrintSolveStats() && m_nrm_lag >= 0)
         {
             ss.str(std::string());
             ss << std::setw(15) << m_curr_iter;
@@ -799,20 +904,42 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
             print_norm(ss);
             ss << std::setw(15);
 
+            // rate per iteration, also when the previous norm is several iterations back
             for (int i = 0; i < last_nrm.size(); i++)
-                ss << std::fixed << std::setprecision(4) << m_nrm[i] / last_nrm[i]
+            {
+                double rate = m_nrm[i] / last_nrm[i];
+
+                if (nrm_iter - last_nrm_iter > 1)
+                {
+                    rate = std::pow(rate, 1.0 / (nrm_iter - last_nrm_iter));
+                }
+
+                ss << std::fixed << std::setprecision(4) << rate
                    << std::setw(8);
+            }
+
+            if (m_nrm_lag > 0)
+            {
+                ss << " (lagged, iter " << nrm_iter << ")";
+            }
 
             ss << std::endl;
             amgx_output(ss.str().c_str(), static_cast<int>(ss.str().length()));
             last_nrm = m_nrm;
+            last_nrm_iter = nrm_iter;
         }
 
-        if ((m_verbosity_level == 1 || m_verbosity_level == 2) && getPrintSolveStats())
+        if ((m_verbosity_level == 1 || m_verbosity_level == 2) && getPrintSolveStats() && m_nrm_lag >= 0)
         {
             ss.str(std::string());
             ss << std::setw(4) << m_curr_iter << " ";
             print_norm2(ss);
+
+            if (m_nrm_lag > 0)
+            {
+                ss << "(lagged, iter " << nrm_iter << ")";
+            }
+
             ss << std::endl;
             amgx_output(ss.str().c_str(), static_cast<int>(ss.str().length()));
         }
@@ -834,6 +961,15 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
         solve_finalize(b, x);
     }
 
+    // Skipped or lagged checks leave m_nrm behind the solution, the status is decided on the true residual.
+    if (m_monitor_convergence && !m_nrm_exact)
+    {
+        compute_residual(b, x);
+        compute_norm();
+        conv_stat = converged();
+        m_nrm_exact = true;
+    }
+
     if ( m_Scaler != NULL) //rescale solution to match equation scaling
     {
         Matrix<TConfig> *m_A =  dynamic_cast<Matrix<TConfig>*>(this->m_A);
@@ -867,7 +1003,7 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
 #endif
     }
 
-    // Print residual convergence information
+    // Print residual convergence information, m_nrm is the norm of the final residual here
     if (m_verbosity_level > 2 && getPrintSolveStats())
     {
         ss.str(std::string());
@@ -883,24 +1019,24 @@ AMGX_STATUS Solver<TConfig>::solve(Vector<TConfig> &b, Vector<TConfig> &x,
         ss << "         Total Iterations: " << m_num_iters << std::endl;
         ss << "         Avg Convergence Rate: \t\t";
 
-        for (int i = 0; i < last_nrm.size(); i++)
+        for (int i = 0; i < m_nrm.size(); i++)
             ss << std::fixed << std::setw(15)
-               << ((m_nrm_ini[i] > eps) ? pow(last_nrm[i] / m_nrm_ini[i],  types::util<PODValueB>::get_one() / m_num_iters) : m_nrm_ini[i]);
+               << ((m_nrm_ini[i] > eps) ? pow(m_nrm[i] / m_nrm_ini[i],  types::util<PODValueB>::get_one() / m_num_iters) : m_nrm_ini[i]);
 
         ss << std::endl;
         ss << "         Final Residual: \t\t" << std::setprecision(6);
 
-        for (int i = 0; i < last_nrm.size(); i++)
+        for (int i = 0; i < m_nrm.size(); i++)
         {
-            ss << std::scientific << std::setw(15) << last_nrm[i] << std::fixed;
+            ss << std::scientific << std::setw(15) << m_nrm[i] << std::fixed;
         }
 
         ss << std::endl;
         ss << "         Total Reduction in Residual: \t" << std::setprecision(6);
 
-        for (int i = 0; i < last_nrm.size(); i++)
+        for (int i = 0; i < m_nrm.size(); i++)
             ss << std::scientific << std::setw(15)
-               << ((m_nrm_ini[i] > eps) ? last_nrm[i] / m_nrm_ini[i] : m_nrm_ini[i])
+               << ((m_nrm_ini[i] > eps) ? m_nrm[i] / m_nrm_ini[i] : m_nrm_ini[i])
                << std::fixed;
 
         ss << std::endl;
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <structure_hash.h>
+#include <thrust_wrapper.h>
+#include <error.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/functional.h>
+
+namespace amgx
+{
+
+namespace
+{
+
+// splitmix64 finalizer
+__host__ __device__ inline uint64_t mix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+struct hash_word
+{
+    const uint32_t *words;
+    uint64_t seed;
+
+    hash_word(const uint32_t *words, uint64_t seed) : words(words), seed(seed) {}
+
+    __host__ __device__ uint64_t operator()(int64_t i) const
+    {
+        return mix64(seed ^ mix64((uint64_t)i) ^ words[i]);
+    }
+};
+
+template <int MemSpace>
+uint64_t reduceWords(const uint32_t *words, int64_t num_words, uint64_t seed)
+{
+    amgx::thrust::counting_iterator<int64_t> first(0);
+    return thrust_wrapper::transform_reduce<MemSpace>(first, first + num_words, hash_word(words, seed), (uint64_t)0, amgx::thrust::plus<uint64_t>());
+}
+
+} // namespace
+
+uint64_t structureHash(const void *ptr, size_t size, uint64_t seed)
+{
+    uint64_t h = mix64(seed ^ size);
+
+    if (ptr == NULL || size == 0)
+    {
+        return h;
+    }
+
+    cudaPointerAttributes attributes;
+    bool on_device = false;
+
+    if (cudaPointerGetAttributes(&attributes, ptr) == cudaSuccess)
+    {
+        on_device = attributes.type == cudaMemoryTypeDevice || attributes.type == cudaMemoryTypeManaged;
+    }
+    else
+    {
+        // plain host memory unknown to the runtime
+        cudaGetLastError();
+    }
+
+    const int64_t num_words = size / sizeof(uint32_t);
+    const uint32_t *words = (const uint32_t *)ptr;
+    h += on_device ? reduceWords<AMGX_device>(words, num_words, seed) : reduceWords<AMGX_host>(words, num_words, seed);
+    cudaCheckError();
+    const size_t tail = size - num_words * sizeof(uint32_t);
+
+    if (tail > 0)
+    {
+        uint32_t last = 0;
+        cudaMemcpy(&last, words + num_words, tail, cudaMemcpyDefault);
+        cudaCheckError();
+        h += hash_word(&last, seed)(0) ^ mix64(num_words);
+    }
+
+    return h;
+}
+
+} // namespace amgx
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+
+namespace amgx
+{
+
+// the diagnostics of an aggregation and a classical hierarchy are consistent with the sizes of the
+// levels, pairwise aggregates of a Laplacian have a quality bound between 1 and 2, and without the
+// rating the other metrics stay the same
+DECLARE_UNITTEST_BEGIN(AMGDiagnosticsTest);
+
+void setup(const char *config_string, MatrixA &A, HierarchyDiagnostics &diagnostics)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_TRUE(solver.getSolverObject()->getDiagnostics(diagnostics));
+    const std::vector<LevelDiagnostics> &levels = diagnostics.levels;
+    PrintOnFail("%d levels, grid complexity %f, operator complexity %f\n", (int)levels.size(), diagnostics.grid_complexity, diagnostics.operator_complexity);
+    UNITTEST_ASSERT_TRUE(levels.size() > 1);
+    UNITTEST_ASSERT_EQUAL(levels[0].rows, (int64_t)A.get_num_rows());
+    UNITTEST_ASSERT_TRUE(diagnostics.grid_complexity > 1. && diagnostics.operator_complexity > 1.);
+
+    for (size_t l = 0; l + 1 < levels.size(); l++)
+    {
+        PrintOnFail("level %d\n", (int)l);
+        UNITTEST_ASSERT_EQUAL(levels[l].level, (int)l);
+        UNITTEST_ASSERT_EQUAL(levels[l].coarse_rows, levels[l + 1].rows);
+        UNITTEST_ASSERT_TRUE(levels[l].coarsening_ratio > 0. && levels[l].coarsening_ratio < 1.);
+        UNITTEST_ASSERT_TRUE(levels[l].galerkin_fill_ratio > 0.);
+        UNITTEST_ASSERT_TRUE(levels[l].interp_min_row_length >= 1);
+        UNITTEST_ASSERT_TRUE(levels[l].interp_max_row_length >= levels[l].interp_min_row_length);
+    }
+
+    UNITTEST_ASSERT_EQUAL(levels.back().coarse_rows, (int64_t)0);
+    HierarchyDiagnostics unrated;
+    unrated.rate_aggregates = false;
+    UNITTEST_ASSERT_TRUE(solver.getSolverObject()->getDiagnostics(unrated));
+    UNITTEST_ASSERT_EQUAL(unrated.levels.size(), levels.size());
+
+    for (size_t l = 0; l < levels.size(); l++)
+    {
+        UNITTEST_ASSERT_EQUAL(unrated.levels[l].num_aggregates, levels[l].num_aggregates);
+        UNITTEST_ASSERT_EQUAL(unrated.levels[l].num_coarse_points, levels[l].num_coarse_points);
+        UNITTEST_ASSERT_EQUAL(unrated.levels[l].aggregate_quality, 0.);
+        UNITTEST_ASSERT_EQUAL(unrated.levels[l].unrated_aggregates, (int64_t)0);
+
+        for (int k = 0; k < AGGREGATE_HISTOGRAM_BINS; k++)
+        {
+            UNITTEST_ASSERT_EQUAL(unrated.levels[l].aggregate_size_histogram[k], levels[l].aggregate_size_histogram[k]);
+        }
+    }
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 5, 32, 32, 1);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    HierarchyDiagnostics diagnostics;
+    setup("config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_levels=10", A, diagnostics);
+
+    for (size_t l = 0; l + 1 < diagnostics.levels.size(); l++)
+    {
+        const LevelDiagnostics &d = diagnostics.levels[l];
+        PrintOnFail("level %d: %d aggregates, quality %f\n", (int)l, (int)d.num_aggregates, d.aggregate_quality);
+        UNITTEST_ASSERT_TRUE(!d.classical);
+        UNITTEST_ASSERT_EQUAL(d.num_aggregates, d.coarse_rows);
+        int64_t counted = 0, points = 0;
+
+        for (int k = 0; k < AGGREGATE_HISTOGRAM_BINS; k++)
+        {
+            counted += d.aggregate_size_histogram[k];
+            points += (k + 1) * d.aggregate_size_histogram[k];
+        }
+
+        UNITTEST_ASSERT_EQUAL(counted, d.num_aggregates);
+        UNITTEST_ASSERT_EQUAL(d.singletons, d.aggregate_size_histogram[0]);
+        UNITTEST_ASSERT_TRUE(d.max_aggregate_size >= 1 && d.max_aggregate_size <= 2);
+        UNITTEST_ASSERT_EQUAL(points, d.rows);
+        UNITTEST_ASSERT_EQUAL(d.unrated_aggregates, (int64_t)0);
+
+        // on the fine level every pair of points rates 1 / lambda_2 of a scaled 2x2 Laplacian
+        if (l == 0)
+        {
+            UNITTEST_ASSERT_TRUE(d.aggregate_quality >= 1. - 1e-8 && d.aggregate_quality <= 2. + 1e-8);
+        }
+    }
+
+    setup("config_version=2, solver(amg)=AMG, amg:algorithm=CLASSICAL, amg:selector=RS, amg:interpolator=D2, amg:max_levels=10", A, diagnostics);
+    const LevelDiagnostics &d = diagnostics.levels[0];
+    PrintOnFail("%d coarse and %d fine points\n", (int)d.num_coarse_points, (int)d.num_fine_points);
+    UNITTEST_ASSERT_TRUE(d.classical);
+    UNITTEST_ASSERT_EQUAL(d.num_coarse_points, d.coarse_rows);
+    UNITTEST_ASSERT_EQUAL(d.num_coarse_points + d.num_fine_points, d.rows);
+    UNITTEST_ASSERT_TRUE(d.cf_ratio > 0.);
+    UNITTEST_ASSERT_TRUE(d.interp_avg_row_length >= d.interp_min_row_length && d.interp_avg_row_length <= d.interp_max_row_length);
+}
+
+DECLARE_UNITTEST_END(AMGDiagnosticsTest);
+
+AMGDiagnosticsTest <TemplateMode<AMGX_mode_dDDI>::Type> AMGDiagnosticsTest_dDDI;
+AMGDiagnosticsTest <TemplateMode<AMGX_mode_hDDI>::Type> AMGDiagnosticsTest_hDDI;
+
+// the reported complexities are the sums of the level sizes over the fine level, and every Krylov
+// solver preconditioned by AMG reports those of its preconditioner, unpreconditioned ones none
+DECLARE_UNITTEST_BEGIN(AMGComplexityTest);
+
+bool complexity(const std::string &config_string, MatrixA &A, double &grid_complexity, double &operator_complexity)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string.c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    return solver.getSolverObject()->getComplexity(grid_complexity, operator_complexity);
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 5, 32, 32, 1);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    const std::string amg = "amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_iters=1, amg:max_levels=10";
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(("config_version=2, solver(amg)=AMG, " + amg).c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    HierarchyDiagnostics diagnostics;
+    UNITTEST_ASSERT_TRUE(solver.getSolverObject()->getDiagnostics(diagnostics));
+    const std::vector<LevelDiagnostics> &levels = diagnostics.levels;
+    int64_t rows = 0, nnz = 0;
+
+    for (size_t l = 0; l < levels.size(); l++)
+    {
+        rows += levels[l].rows;
+        nnz += levels[l].nnz;
+    }
+
+    // the fine level is the 5-point Laplacian
+    UNITTEST_ASSERT_EQUAL(levels[0].nnz, (int64_t)(5 * 32 * 32 - 4 * 32));
+    double grid_complexity, operator_complexity;
+    UNITTEST_ASSERT_TRUE(solver.getSolverObject()->getComplexity(grid_complexity, operator_complexity));
+    PrintOnFail("%d levels, grid complexity %f, operator complexity %f\n", (int)levels.size(), grid_complexity, operator_complexity);
+    UNITTEST_ASSERT_EQUAL_TOL(grid_complexity, rows / (double)levels[0].rows, 1e-12);
+    UNITTEST_ASSERT_EQUAL_TOL(operator_complexity, nnz / (double)levels[0].nnz, 1e-12);
+    UNITTEST_ASSERT_TRUE(grid_complexity > 1. && operator_complexity > 1.);
+    UNITTEST_ASSERT_EQUAL_TOL(diagnostics.grid_complexity, grid_complexity, 1e-12);
+    UNITTEST_ASSERT_EQUAL_TOL(diagnostics.operator_complexity, operator_complexity, 1e-12);
+    const char *preconditioned[] = {"PCG", "PCGF", "PBICGSTAB", "GMRES", "FGMRES", "IDR", "IDRMSYNC"};
+
+    for (int i = 0; i < 7; i++)
+    {
+        PrintOnFail("%s\n", preconditioned[i]);
+        double g = 0., o = 0.;
+        UNITTEST_ASSERT_TRUE(complexity(std::string("config_version=2, solver(s)=") + preconditioned[i] + ", s:max_iters=1, s:preconditioner(amg)=AMG, " + amg, A, g, o));
+        UNITTEST_ASSERT_EQUAL_TOL(g, grid_complexity, 1e-12);
+        UNITTEST_ASSERT_EQUAL_TOL(o, operator_complexity, 1e-12);
+    }
+
+    double g, o;
+    UNITTEST_ASSERT_TRUE(!complexity("config_version=2, solver(s)=CG, s:max_iters=1", A, g, o));
+    UNITTEST_ASSERT_TRUE(!complexity("config_version=2, solver(s)=PCG, s:max_iters=1, s:preconditioner(j)=BLOCK_JACOBI", A, g, o));
+}
+
+DECLARE_UNITTEST_END(AMGComplexityTest);
+
+AMGComplexityTest <TemplateMode<AMGX_mode_dDDI>::Type> AMGComplexityTest_dDDI;
+
+} //namespace amgx
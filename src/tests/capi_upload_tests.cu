@@ -230,11 +230,169 @@ void run()
 
 DECLARE_UNITTEST_END(CAPIUploadCudaMallocHost);
 
+DECLARE_UNITTEST_BEGIN(CAPIUploadHost);
+
+void run()
+{
+    AMGX_finalize();
+    AMGX_initialize();
+
+    // 1D Laplacian
+    const int nrows = 10;
+    std::vector<int> rows(nrows + 1);
+    std::vector<int> cols;
+    std::vector<double> vals;
+    rows[0] = 0;
+
+    for (int i = 0; i < nrows; ++i)
+    {
+        for (int j = std::max(i - 1, 0); j <= std::min(i + 1, nrows - 1); ++j)
+        {
+            cols.push_back(j);
+            vals.push_back(i == j ? 2.0 : -1.0);
+        }
+
+        rows[i + 1] = cols.size();
+    }
+
+    const int nnz = cols.size();
+    AMGX_config_handle cfg;
+    AMGX_config_create(&cfg, "config_version=2, solver(s)=PCG, s:preconditioner(p)=NOSOLVER, s:max_iters=100, s:tolerance=1e-12, s:monitor_residual=1, exception_handling=1");
+    AMGX_resources_handle rsrc;
+    AMGX_resources_create_simple(&rsrc, cfg);
+
+    AMGX_matrix_handle A;
+    AMGX_matrix_create(&A, rsrc, AMGX_mode_hDDI);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all_host(A, nrows, nnz, 1, 1, rows.data(), cols.data(), vals.data(), NULL), AMGX_RC_OK);
+
+    // the library must not reference the caller's buffers after the call
+    std::vector<int> rows_ref = rows, cols_ref = cols;
+    std::vector<double> vals_ref = vals;
+    std::fill(rows.begin(), rows.end(), -1);
+    std::fill(cols.begin(), cols.end(), -1);
+    std::fill(vals.begin(), vals.end(), 0.);
+
+    int n_out, nnz_out, bx, by;
+    AMGX_matrix_get_size(A, &n_out, &bx, &by);
+    AMGX_matrix_get_nnz(A, &nnz_out);
+    UNITTEST_ASSERT_EQUAL(n_out, nrows);
+    UNITTEST_ASSERT_EQUAL(nnz_out, nnz);
+
+    std::vector<int> rows_out(nrows + 1), cols_out(nnz);
+    std::vector<double> vals_out(nnz);
+    void *diag_out = NULL;
+    AMGX_matrix_download_all(A, rows_out.data(), cols_out.data(), vals_out.data(), &diag_out);
+    UNITTEST_ASSERT_TRUE(rows_out == rows_ref);
+    UNITTEST_ASSERT_TRUE(cols_out == cols_ref);
+    UNITTEST_ASSERT_TRUE(vals_out == vals_ref);
+
+    // the host-mode matrix solves like an uploaded one
+    AMGX_vector_handle b, x;
+    AMGX_solver_handle solver;
+    AMGX_vector_create(&b, rsrc, AMGX_mode_hDDI);
+    AMGX_vector_create(&x, rsrc, AMGX_mode_hDDI);
+    std::vector<double> ones(nrows, 1.), x_out(nrows, 0.);
+    AMGX_vector_upload(b, nrows, 1, ones.data());
+    AMGX_vector_upload(x, nrows, 1, x_out.data());
+    AMGX_solver_create(&solver, rsrc, AMGX_mode_hDDI, cfg);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_setup(solver, A), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_solve(solver, b, x), AMGX_RC_OK);
+    AMGX_vector_download(x, x_out.data());
+
+    // x = A^-1 1 of the 1D Laplacian is (i + 1) (n - i) / 2
+    for (int i = 0; i < nrows; ++i)
+    {
+        UNITTEST_ASSERT_EQUAL_TOL(x_out[i], 0.5 * (i + 1) * (nrows - i), 1e-6);
+    }
+
+    AMGX_solver_destroy(solver);
+    AMGX_vector_destroy(b);
+    AMGX_vector_destroy(x);
+    AMGX_matrix_destroy(A);
+
+    AMGX_matrix_handle A_d;
+    AMGX_matrix_create(&A_d, rsrc, AMGX_mode_dDDI);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all_host(A_d, nrows, nnz, 1, 1, rows_ref.data(), cols_ref.data(), vals_ref.data(), NULL), AMGX_RC_NOT_SUPPORTED_TARGET);
+    AMGX_matrix_destroy(A_d);
+
+    AMGX_resources_destroy(rsrc);
+    AMGX_config_destroy(cfg);
+    AMGX_finalize();
+}
+
+DECLARE_UNITTEST_END(CAPIUploadHost);
+
+// a handle uploaded from triplets and filled again through another path takes the values of the
+// new structure in replace_coefficients, not the triplet order of the first upload
+DECLARE_UNITTEST_BEGIN(CAPIUploadTripletsRefill);
+
+void download_values(AMGX_matrix_handle A, std::vector<double> &vals)
+{
+    int n, nnz, bx, by;
+    AMGX_matrix_get_size(A, &n, &bx, &by);
+    AMGX_matrix_get_nnz(A, &nnz);
+    std::vector<int> rows(n + 1), cols(nnz);
+    vals.resize(nnz);
+    void *diag = NULL;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_download_all(A, rows.data(), cols.data(), vals.data(), &diag), AMGX_RC_OK);
+}
+
+void run()
+{
+    AMGX_finalize();
+    AMGX_initialize();
+    AMGX_config_handle cfg;
+    AMGX_config_create(&cfg, "config_version=2, solver=PCG, exception_handling=1");
+    AMGX_resources_handle rsrc;
+    AMGX_resources_create_simple(&rsrc, cfg);
+    AMGX_matrix_handle A;
+    AMGX_matrix_create(&A, rsrc, AMGX_mode_dDDI);
+
+    // 3x3 with a duplicate (0, 1): 6 triplets, 5 nonzeros
+    const int I[] = {0, 1, 2, 0, 0, 1};
+    const int J[] = {0, 1, 2, 1, 1, 0};
+    const double V[] = {2., 2., 2., -1., -0.5, -1.};
+    std::vector<double> vals;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_coo(A, 3, 6, 1, 1, I, J, V), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_replace_coefficients(A, 3, 6, V, NULL), AMGX_RC_OK);
+    // the diagonal of a triplet upload is part of the triplets
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_replace_coefficients(A, 3, 6, V, V), AMGX_RC_BAD_PARAMETERS);
+
+    // filled again by the generator: nnz is the one of the generated matrix
+    UNITTEST_ASSERT_EQUAL(AMGX_generate_system(A, NULL, NULL, "poisson5", 4, 4, 1, NULL), AMGX_RC_OK);
+    int nnz;
+    AMGX_matrix_get_nnz(A, &nnz);
+    std::vector<double> threes(nnz, 3.);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_replace_coefficients(A, 16, nnz, threes.data(), NULL), AMGX_RC_OK);
+    download_values(A, vals);
+    UNITTEST_ASSERT_TRUE(vals == threes);
+
+    // filled again by a CSR upload: the values go to the CSR slots
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_coo(A, 3, 6, 1, 1, I, J, V), AMGX_RC_OK);
+    const int rows[] = {0, 1, 2, 3};
+    const int cols[] = {0, 1, 2};
+    const double diag[] = {1., 1., 1.};
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all(A, 3, 3, 1, 1, rows, cols, diag, NULL), AMGX_RC_OK);
+    const double new_diag[] = {5., 6., 7.};
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_replace_coefficients(A, 3, 3, new_diag, NULL), AMGX_RC_OK);
+    download_values(A, vals);
+    UNITTEST_ASSERT_TRUE(vals == std::vector<double>(new_diag, new_diag + 3));
+
+    AMGX_matrix_destroy(A);
+    AMGX_resources_destroy(rsrc);
+    AMGX_config_destroy(cfg);
+    AMGX_finalize();
+}
+
+DECLARE_UNITTEST_END(CAPIUploadTripletsRefill);
+
 // or you can specify several desired configs
 CAPIUploadCudaMallocHost <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadCudaMallocHost_dDDI;
 CAPIUploadCudaHostRegister <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadCudaHostRegister_dDDI;
 CAPIUploadNew <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadNew_dDDI;
 CAPIUploadCudaMallocManaged <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadCudaMallocManaged_dDDI;
 CAPIUploadCudaMalloc <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadCudaMalloc_dDDI;
+CAPIUploadHost <TemplateMode<AMGX_mode_hDDI>::Type>  CAPIUploadHost_hDDI;
+CAPIUploadTripletsRefill <TemplateMode<AMGX_mode_dDDI>::Type>  CAPIUploadTripletsRefill_dDDI;
 
 } //namespace amgx
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+#include "classical/strength/strength_base.h"
+#include <classical/selectors/selector.h>
+#include <classical/interpolators/common.h>
+
+namespace amgx
+{
+
+// the bucketed RS first pass assigns every point and leaves every F point with strong connections
+// a strong C neighbour, with either tie-break; splitting it in blocks coarsened in parallel gives
+// about as many coarse points and an AMG that still converges
+DECLARE_UNITTEST_BEGIN(ClassicalRSSelector);
+
+typedef Vector<typename TConfig::template setVecPrec<AMGX_vecBool>::Type> BVector;
+typedef Vector<typename TConfig_h::template setVecPrec<AMGX_vecBool>::Type> BVector_h;
+typedef Vector<typename TConfig::template setVecPrec<AMGX_vecFloat>::Type> FVector;
+
+int select(MatrixA &A, int num_domains, int tie_break = 0)
+{
+    AMG_Config cfg;
+    std::stringstream params;
+    params << "selector=RS, rs_num_domains=" << num_domains << ", rs_tie_break=" << tie_break;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(params.str().c_str()) == AMGX_OK);
+    Strength<TConfig> *strength = StrengthFactory<TConfig>::allocate(cfg, "default");
+    classical::Selector<TConfig> *selector = classical::SelectorFactory<TConfig>::allocate(cfg, "default");
+    BVector s_con(A.get_num_nz(), false);
+    FVector weights(A.get_num_rows(), 0.0f);
+    strength->computeStrongConnectionsAndWeights(A, s_con, weights, 1.1);
+    IVector cf_map(A.get_num_rows(), 0), scratch(A.get_num_rows(), 0);
+    selector->markCoarseFinePoints(A, weights, s_con, cf_map, scratch);
+    delete selector;
+    delete strength;
+    IVector_h cf_map_h = cf_map;
+    BVector_h s_con_h = s_con;
+    IVector_h row_offsets = A.row_offsets, col_indices = A.col_indices;
+    int num_coarse = 0;
+
+    for (int i = 0; i < A.get_num_rows(); i++)
+    {
+        UNITTEST_ASSERT_TRUE(cf_map_h[i] != UNASSIGNED);
+        num_coarse += cf_map_h[i] == COARSE;
+
+        if (cf_map_h[i] != FINE)
+        {
+            continue;
+        }
+
+        bool strong = false, strong_coarse = false;
+
+        for (int k = row_offsets[i]; k < row_offsets[i + 1]; k++)
+        {
+            int col = col_indices[k];
+
+            if (s_con_h[k] && col != i && col < A.get_num_rows())
+            {
+                strong = true;
+                strong_coarse = strong_coarse || cf_map_h[col] == COARSE;
+            }
+        }
+
+        PrintOnFail("%d blocks, tie-break %d: F point %d has no strong C neighbour\n", num_domains, tie_break, i);
+        UNITTEST_ASSERT_TRUE(!strong || strong_coarse);
+    }
+
+    return num_coarse;
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 7, 32, 32, 32);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    int num_coarse = select(A, 1);
+    int num_coarse_blocks = select(A, 4);
+    int num_coarse_lifo = select(A, 1, 1);
+    PrintOnFail("%d coarse points, %d with 4 blocks, %d with last queued ties\n", num_coarse, num_coarse_blocks, num_coarse_lifo);
+    UNITTEST_ASSERT_TRUE(num_coarse > 0);
+    UNITTEST_ASSERT_TRUE(std::abs(num_coarse - num_coarse_blocks) < num_coarse / 10);
+    UNITTEST_ASSERT_TRUE(std::abs(num_coarse - num_coarse_lifo) < num_coarse / 10);
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString("config_version=2, solver(amg)=AMG, amg:algorithm=CLASSICAL, amg:selector=RS, amg:rs_num_domains=4, amg:interpolator=D2, amg:smoother(sm)=JACOBI_L1, amg:max_iters=50, amg:tolerance=1e-8, amg:monitor_residual=1") == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    VVector b(A.get_num_rows(), 1.), x(A.get_num_rows(), 0.);
+    AMGX_STATUS status;
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+    UNITTEST_ASSERT_TRUE(status == AMGX_ST_CONVERGED);
+}
+
+DECLARE_UNITTEST_END(ClassicalRSSelector);
+
+ClassicalRSSelector <TemplateMode<AMGX_mode_dDDI>::Type> ClassicalRSSelector_dDDI;
+ClassicalRSSelector <TemplateMode<AMGX_mode_hDDI>::Type> ClassicalRSSelector_hDDI;
+
+} //namespace amgx
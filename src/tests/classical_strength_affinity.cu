@@ -56,6 +56,21 @@ void run()
         this->PrintOnFail("Deterministic strength: Different weights");
         UNITTEST_ASSERT_EQUAL_TOL(weights, weights2, 1e-4);
     }
+
+    delete strength;
+    // more test vectors than the lanes of a warp
+    AMG_Config cfg_wide;
+    cfg_wide.parseParameterString("strength=AFFINITY, determinism_flag=1, strength_threshold=0.55, affinity_vectors=48");
+    strength = StrengthFactory<TConfig>::allocate(cfg_wide, cfg_scope);
+    generateMatrixRandomStruct<TConfig>::generate(A, 10000, true, 1, true);
+    random_fill(A);
+    BVector s_con(A.get_num_nz(), false);
+    FVector weights(A.get_num_rows(), 0.0f);
+    strength->computeStrongConnectionsAndWeights(A, s_con, weights, -1.);
+    bool someStrong = amgx::thrust::reduce(s_con.begin(), s_con.end());
+    this->PrintOnFail("48 test vectors: No strong connections made");
+    UNITTEST_ASSERT_TRUE(someStrong == true);
+    delete strength;
 }
 
 DECLARE_UNITTEST_END(ClassicalStrengthAffinityTest);
@@ -63,6 +78,7 @@ DECLARE_UNITTEST_END(ClassicalStrengthAffinityTest);
 //ClassicalStrengthTest <TemplateMode<AMGX_mode_hDDI>::Type>  ClassicalStrengthTest_instance_mode_hDDI;
 //ClassicalStrengthTest <TemplateMode<AMGX_mode_hDFI>::Type>  ClassicalStrengthTest_instance_mode_hDFI;
 //ClassicalStrengthTest <TemplateMode<AMGX_mode_hFFI>::Type>  ClassicalStrengthTest_instance_mode_hFFI;
+ClassicalStrengthAffinityTest <TemplateMode<AMGX_mode_hDDI>::Type>  ClassicalStrengthAffinityTest_instance_mode_hDDI;
 ClassicalStrengthAffinityTest <TemplateMode<AMGX_mode_dDDI>::Type>  ClassicalStrengthAffinityTest_instance_mode_dDDI;
 ClassicalStrengthAffinityTest <TemplateMode<AMGX_mode_dDFI>::Type>  ClassicalStrengthAffinityTest_instance_mode_dDFI;
 ClassicalStrengthAffinityTest <TemplateMode<AMGX_mode_dFFI>::Type>  ClassicalStrengthAffinityTest_instance_mode_dFFI;
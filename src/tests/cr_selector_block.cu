@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include <classical/selectors/selector.h>
+
+namespace amgx
+{
+
+// the CR selector splits block matrices, separate diagonals and host matrices through the generic
+// path. On A (x) I, bs decoupled copies of a scalar Poisson matrix, the block relaxation is the
+// scalar one on each component, so it has to pick about as many coarse points as on A (with its
+// diagonal stored separately, so that the device also takes the generic path)
+DECLARE_UNITTEST_BEGIN(CRSelectorBlockTest);
+
+typedef Vector<typename TConfig::template setVecPrec<AMGX_vecBool>::Type> BVector;
+typedef Vector<typename TConfig::template setVecPrec<AMGX_vecFloat>::Type> FVector;
+
+// A (x) I with bs x bs blocks, the diagonal blocks in the rows or after the nonzeros
+void decouple(const Matrix_h &A, int bs, bool diag_prop, Matrix_h &B)
+{
+    const int num_rows = A.get_num_rows();
+    const int bs2 = bs * bs;
+    const int num_nz = A.get_num_nz() - (diag_prop ? num_rows : 0);
+    B.set_initialized(0);
+    B.addProps(CSR | (diag_prop ? DIAG : 0));
+    B.resize(num_rows, num_rows, num_nz, bs, bs, 1);
+    B.values.resize((num_nz + (diag_prop ? num_rows : 1)) * bs2);
+    thrust_wrapper::fill<AMGX_host>(B.values.begin(), B.values.end(), 0.0);
+    int nz = 0;
+
+    for (int i = 0; i < num_rows; i++)
+    {
+        B.row_offsets[i] = nz;
+
+        for (int j = A.row_offsets[i]; j < A.row_offsets[i + 1]; j++)
+        {
+            const int col = A.col_indices[j];
+            const int k = (diag_prop && col == i) ? num_nz + i : nz++;
+
+            if (k < num_nz) { B.col_indices[k] = col; }
+
+            for (int r = 0; r < bs; r++)
+            {
+                B.values[(size_t) k * bs2 + r * bs + r] = A.values[j];
+            }
+        }
+    }
+
+    B.row_offsets[num_rows] = nz;
+    B.computeDiagonal();
+    B.set_initialized(1);
+}
+
+int select(const Matrix_h &B_h)
+{
+    MatrixA B = B_h;
+    AMG_Config cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString("selector=CR") == AMGX_OK);
+    classical::Selector<TConfig> *selector = classical::SelectorFactory<TConfig>::allocate(cfg, "default");
+    BVector s_con(B.get_num_nz(), true);
+    FVector weights(B.get_num_rows(), 0.0f);
+    IVector cf_map(B.get_num_rows(), 0), scratch(B.get_num_rows(), 0);
+    selector->markCoarseFinePoints(B, weights, s_con, cf_map, scratch);
+    delete selector;
+    IVector_h cf_map_h = cf_map;
+    int num_coarse = 0;
+
+    for (int i = 0; i < B.get_num_rows(); i++)
+    {
+        UNITTEST_ASSERT_TRUE(cf_map_h[i] == COARSE || cf_map_h[i] == FINE);
+        num_coarse += cf_map_h[i] == COARSE;
+    }
+
+    UNITTEST_ASSERT_TRUE(num_coarse > 0 && num_coarse < B.get_num_rows());
+    return num_coarse;
+}
+
+void run()
+{
+    Matrix_h A;
+    generatePoissonForTest(A, 1, 0, 5, 32, 32);
+    A.set_initialized(0);
+    A.computeDiagonal();
+    A.set_initialized(1);
+    Matrix_h S;
+    decouple(A, 1, true, S);
+    const int num_coarse = select(S);
+    const int block_sizes[] = {3, 4};
+
+    for (int b = 0; b < 2; b++)
+        for (int diag_prop = 0; diag_prop < 2; diag_prop++)
+        {
+            Matrix_h B;
+            decouple(A, block_sizes[b], diag_prop != 0, B);
+            const int num_coarse_block = select(B);
+            PrintOnFail("block size %d, diag_prop %d: %d coarse points, %d on the scalar matrix\n", block_sizes[b], diag_prop, num_coarse_block, num_coarse);
+            UNITTEST_ASSERT_TRUE(std::abs(num_coarse_block - num_coarse) <= num_coarse / 5);
+        }
+}
+
+DECLARE_UNITTEST_END(CRSelectorBlockTest);
+
+CRSelectorBlockTest <TemplateMode<AMGX_mode_dDDI>::Type> CRSelectorBlockTest_dDDI;
+CRSelectorBlockTest <TemplateMode<AMGX_mode_hDDI>::Type> CRSelectorBlockTest_hDDI;
+
+} //namespace amgx
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amgx_c.h"
+#include "amgxP_c.h"
+#include <structure_hash.h>
+#ifdef AMGX_WITH_MPI
+#include <mpi.h>
+#endif
+
+namespace amgx
+{
+
+// the structure hash is the same wherever the buffer lives and changes with the pattern, a
+// distributed matrix re-uploaded with the same structure keeps its maps and takes the new values,
+// and one re-uploaded with a different structure, or after a local upload, is rebuilt instead of
+// reusing the maps of an earlier upload
+DECLARE_UNITTEST_BEGIN(DistributedReuploadTest);
+
+typedef std::vector<int64_t> Offsets;
+
+#ifdef AMGX_WITH_MPI
+// rows [offsets[my_id], offsets[my_id + 1]) of a matrix coupling i with i - stride and i + stride,
+// for stride 1 the 1D Laplacian
+void upload(AMGX_matrix_handle A, int stride, double scale, const Offsets &offsets, int my_id)
+{
+    const int64_t num_global = offsets.back();
+    std::vector<int> rows(1, 0);
+    std::vector<int64_t> cols;
+    std::vector<double> vals;
+
+    for (int64_t i = offsets[my_id]; i < offsets[my_id + 1]; i++)
+    {
+        for (int64_t j = i - stride; j <= i + stride; j += stride)
+        {
+            if (j >= 0 && j < num_global)
+            {
+                cols.push_back(j);
+                vals.push_back(scale * (i == j ? 2. : -1.));
+            }
+        }
+
+        rows.push_back(cols.size());
+    }
+
+    AMGX_distribution_handle dist;
+    AMGX_distribution_create(&dist, NULL);
+    AMGX_distribution_set_partition_data(dist, AMGX_DIST_PARTITION_OFFSETS, offsets.data());
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_distributed(A, num_global, rows.size() - 1, cols.size(), 1, 1, rows.data(), cols.data(), vals.data(), NULL, dist), AMGX_RC_OK);
+    AMGX_distribution_destroy(dist);
+}
+
+int value_only_uploads(AMGX_matrix_handle A)
+{
+    int count = -1;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_get_value_only_uploads(A, &count), AMGX_RC_OK);
+    return count;
+}
+
+// solves A x = 1 and checks x against the 1D Laplacian scaled by scale
+void check_solution(AMGX_resources_handle rsrc, AMGX_config_handle cfg, AMGX_matrix_handle A, double scale, const Offsets &offsets, int my_id)
+{
+    const int64_t num_global = offsets.back();
+    const int n = (int)(offsets[my_id + 1] - offsets[my_id]);
+    AMGX_vector_handle b, x;
+    AMGX_solver_handle solver;
+    AMGX_vector_create(&b, rsrc, AMGX_mode_dDDI);
+    AMGX_vector_create(&x, rsrc, AMGX_mode_dDDI);
+    AMGX_vector_bind(b, A);
+    AMGX_vector_bind(x, A);
+    std::vector<double> ones(n, 1.), x_h(n, 0.);
+    AMGX_vector_upload(b, n, 1, ones.data());
+    AMGX_vector_upload(x, n, 1, x_h.data());
+    AMGX_solver_create(&solver, rsrc, AMGX_mode_dDDI, cfg);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_setup(solver, A), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_solve(solver, b, x), AMGX_RC_OK);
+    AMGX_vector_download(x, x_h.data());
+
+    for (int i = 0; i < n; i++)
+    {
+        const int64_t gi = offsets[my_id] + i;
+        UNITTEST_ASSERT_EQUAL_TOL(x_h[i], 0.5 * (gi + 1) * (num_global - gi) / scale, 1e-6);
+    }
+
+    AMGX_solver_destroy(solver);
+    AMGX_vector_destroy(b);
+    AMGX_vector_destroy(x);
+}
+#endif
+
+void run()
+{
+    // host and device copies of the same pattern hash alike, a changed entry changes the hash
+    std::vector<int> pattern(100003);
+
+    for (size_t i = 0; i < pattern.size(); i++)
+    {
+        pattern[i] = (int)(i * 7 % 1000);
+    }
+
+    IVector_h pattern_h(pattern.size());
+    std::copy(pattern.begin(), pattern.end(), pattern_h.begin());
+    IVector pattern_d = pattern_h;
+    const uint64_t h = structureHash(pattern.data(), pattern.size() * sizeof(int), 3);
+    UNITTEST_ASSERT_EQUAL(structureHash(pattern_d.raw(), pattern.size() * sizeof(int), 3), h);
+    UNITTEST_ASSERT_TRUE(structureHash(pattern.data(), pattern.size() * sizeof(int), 4) != h);
+    std::swap(pattern[10], pattern[11]);
+    UNITTEST_ASSERT_TRUE(structureHash(pattern.data(), pattern.size() * sizeof(int), 3) != h);
+#ifdef AMGX_WITH_MPI
+    int mpi_initialized;
+    MPI_Initialized(&mpi_initialized);
+
+    if (!mpi_initialized)
+    {
+        int argc = 1;
+        char **argv = NULL;
+        MPI_Init(&argc, &argv);
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int num_ranks, my_id;
+    MPI_Comm_size(comm, &num_ranks);
+    MPI_Comm_rank(comm, &my_id);
+    Offsets offsets(num_ranks + 1);
+
+    for (int r = 0; r <= num_ranks; r++)
+    {
+        offsets[r] = (int64_t)40 * r;
+    }
+
+    AMGX_config_handle cfg;
+    AMGX_config_create(&cfg, "config_version=2, solver(s)=PCG, s:preconditioner(p)=NOSOLVER, s:max_iters=1000, s:tolerance=1e-12, s:monitor_residual=1, exception_handling=1");
+    AMGX_resources_handle rsrc;
+    int device = 0;
+    AMGX_resources_create(&rsrc, cfg, &comm, 1, &device);
+    AMGX_matrix_handle A;
+    AMGX_matrix_create(&A, rsrc, AMGX_mode_dDDI);
+
+    // same number of rows per rank, different columns: the second upload has to rebuild
+    upload(A, 1, 1., offsets, my_id);
+    upload(A, 2, 1., offsets, my_id);
+    UNITTEST_ASSERT_EQUAL(value_only_uploads(A), 0);
+    // back to the first structure with new values
+    upload(A, 1, 2., offsets, my_id);
+    UNITTEST_ASSERT_EQUAL(value_only_uploads(A), 0);
+    check_solution(rsrc, cfg, A, 2., offsets, my_id);
+    // same structure twice in a row: only the values are replaced, the solve sees the new ones
+    upload(A, 1, 3., offsets, my_id);
+    UNITTEST_ASSERT_EQUAL(value_only_uploads(A), 1);
+    check_solution(rsrc, cfg, A, 3., offsets, my_id);
+    upload(A, 1, 4., offsets, my_id);
+    UNITTEST_ASSERT_EQUAL(value_only_uploads(A), 2);
+    check_solution(rsrc, cfg, A, 4., offsets, my_id);
+
+    // a local upload in between changes the structure behind the manager's back
+    if (num_ranks == 1)
+    {
+        std::vector<int> rows(1, 0), cols;
+        std::vector<double> vals;
+
+        for (int i = 0; i < 40; i++)
+        {
+            cols.push_back(i);
+            vals.push_back(1.);
+            rows.push_back(cols.size());
+        }
+
+        UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all(A, 40, 40, 1, 1, rows.data(), cols.data(), vals.data(), NULL), AMGX_RC_OK);
+        upload(A, 1, 1., offsets, my_id);
+        UNITTEST_ASSERT_EQUAL(value_only_uploads(A), 0);
+        check_solution(rsrc, cfg, A, 1., offsets, my_id);
+    }
+
+    AMGX_matrix_destroy(A);
+    AMGX_resources_destroy(rsrc);
+    AMGX_config_destroy(cfg);
+#endif
+}
+
+DECLARE_UNITTEST_END(DistributedReuploadTest);
+
+DistributedReuploadTest <TemplateMode<AMGX_mode_dDDI>::Type> DistributedReuploadTest_dDDI;
+
+} //namespace amgx
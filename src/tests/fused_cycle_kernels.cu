@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+
+namespace amgx
+{
+
+// the fused residual/restriction and correction/smoothing kernels compute the same cycle as the
+// separate passes, up to the order of the floating point sums
+DECLARE_UNITTEST_BEGIN(FusedCycleKernels);
+
+int solve(const std::string &config_string, MatrixA &A, VVector &b, VVector &x, AMGX_STATUS &status)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string.c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    x.resize(A.get_num_rows());
+    thrust_wrapper::fill<TConfig::memSpace>(x.begin(), x.end(), types::util<ValueTypeB>::get_zero());
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+    return solver.get_num_iters();
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 7, 24, 24, 24);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.), x, x_fused;
+    const std::string base = "config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother(sm)=JACOBI_L1, amg:presweeps=2, amg:postsweeps=2, amg:max_levels=6, amg:max_iters=100, amg:tolerance=1e-8, amg:monitor_residual=1";
+    AMGX_STATUS status, status_fused;
+    int iters = solve(base, A, b, x, status);
+    int iters_fused = solve(base + ", amg:fused_cycle_kernels=1", A, b, x_fused, status_fused);
+    PrintOnFail("%d iterations, %d with fused kernels\n", iters, iters_fused);
+    UNITTEST_ASSERT_TRUE(status == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(status_fused == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(std::abs(iters - iters_fused) <= 1);
+    Vector_h xh = x, xh_fused = x_fused;
+    UNITTEST_ASSERT_EQUAL_TOL(xh, xh_fused, 1e-6);
+}
+
+DECLARE_UNITTEST_END(FusedCycleKernels);
+
+FusedCycleKernels <TemplateMode<AMGX_mode_dDDI>::Type> FusedCycleKernels_dDDI;
+FusedCycleKernels <TemplateMode<AMGX_mode_hDDI>::Type> FusedCycleKernels_hDDI;
+
+} //namespace amgx
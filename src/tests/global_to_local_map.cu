@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include <distributed/global_to_local_map.h>
+#include <set>
+
+namespace amgx
+{
+
+// halo renumbering of off-diagonal global columns with repeats: every distinct column gets the
+// next local index after the owned rows in ascending global order, columns of other ranks that
+// were never referenced stay unmapped, and a table sized too small grows instead of failing
+DECLARE_UNITTEST_BEGIN(GlobalToLocalMapTest);
+
+void check(int num_rows, const std::vector<int64_t> &halo)
+{
+    GlobalToLocalMap map;
+    std::vector<int64_t> local_to_global;
+    map.renumber(halo.data(), halo.size(), num_rows, local_to_global);
+    const std::set<int64_t> distinct(halo.begin(), halo.end());
+    PrintOnFail("%d halo references, %d distinct\n", (int)halo.size(), (int)distinct.size());
+    UNITTEST_ASSERT_TRUE(!map.overflowed());
+    UNITTEST_ASSERT_EQUAL(map.size(), distinct.size());
+    UNITTEST_ASSERT_TRUE(std::vector<int64_t>(distinct.begin(), distinct.end()) == local_to_global);
+
+    for (size_t i = 0; i < local_to_global.size(); i++)
+    {
+        UNITTEST_ASSERT_EQUAL(map[local_to_global[i]], num_rows + (int)i);
+    }
+
+    for (size_t i = 0; i < halo.size(); i++)
+    {
+        UNITTEST_ASSERT_TRUE(map[halo[i]] >= num_rows);
+    }
+
+    UNITTEST_ASSERT_EQUAL(map[(int64_t)1 << 40], -1);
+}
+
+void run()
+{
+    // rank owning global rows [1000, 1100) of a 1D Laplacian, the halo is 999 and 1100, each
+    // referenced once
+    std::vector<int64_t> halo;
+    halo.push_back(1100);
+    halo.push_back(999);
+    check(100, halo);
+
+    // a 2D block with every halo column referenced by up to four rows, plus columns above 2^31
+    halo.clear();
+
+    for (int rep = 0; rep < 4; rep++)
+    {
+        for (int64_t j = 0; j < 2000; j++)
+        {
+            halo.push_back(j * 7 + 3);
+            halo.push_back(((int64_t)1 << 33) + j);
+        }
+    }
+
+    check(5000, halo);
+
+    // a single column repeated many times, the initial table is far smaller than the input
+    check(10, std::vector<int64_t>(10000, 42));
+
+    // all distinct, the table has to grow from its initial quarter size
+    halo.clear();
+
+    for (int64_t j = 0; j < 50000; j++)
+    {
+        halo.push_back(50000 - j);
+    }
+
+    check(1, halo);
+    check(0, std::vector<int64_t>());
+}
+
+DECLARE_UNITTEST_END(GlobalToLocalMapTest);
+
+GlobalToLocalMapTest <TemplateMode<AMGX_mode_hDDI>::Type> GlobalToLocalMapTest_hDDI;
+
+} //namespace amgx
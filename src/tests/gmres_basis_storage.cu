@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+#include <multiply.h>
+#include <blas.h>
+
+namespace amgx
+{
+
+// a compressed Krylov basis or an FGMRES without stored preconditioned vectors still has to converge
+// to the full tolerance, measured on the true residual b - Ax rather than on the recurrences
+DECLARE_UNITTEST_BEGIN(GMRESBasisStorage);
+
+static const double tolerance = 1e-10;
+
+// solves from x = 0 and checks ||b - Ax|| / ||b|| against the tolerance, returns the iterations
+int solve(const std::string &config_string, MatrixA &A, VVector &b, AMGX_STATUS &status)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string.c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    VVector x(A.get_num_rows(), 0.);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+    VVector r(A.get_num_rows());
+    Vector_h nrm(1), nrm_b(1);
+    multiply( A, x, r );
+    axpby( b, r, r, ValueTypeB( 1 ), ValueTypeB( -1 ) );
+    get_norm( A, r, 1, L2, nrm );
+    get_norm( A, b, 1, L2, nrm_b );
+    PrintOnFail("%s: true relative residual %e\n", config_string.c_str(), nrm[0] / nrm_b[0]);
+    UNITTEST_ASSERT_TRUE(nrm[0] <= tolerance * (1. + 1e-6) * nrm_b[0]);
+    return solver.get_num_iters();
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 27, 20, 20, 20);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.);
+    const char *solvers[] = {"GMRES", "FGMRES"};
+
+    for (int s = 0; s < 2; s++)
+    {
+        const std::string base = std::string("config_version=2, solver(gm)=") + solvers[s] + ", gm:preconditioner(bj)=BLOCK_JACOBI, bj:max_iters=1, gm:gmres_n_restart=30, gm:max_iters=500, gm:tolerance=1e-10, gm:norm=L2, gm:convergence=RELATIVE_INI_CORE, gm:monitor_residual=1";
+        AMGX_STATUS status, status_float, status_bf16;
+        int iters = solve(base, A, b, status);
+        int iters_float = solve(base + ", gm:gmres_basis_storage=FLOAT", A, b, status_float);
+        int iters_bf16 = solve(base + ", gm:gmres_basis_storage=BFLOAT16", A, b, status_bf16);
+        PrintOnFail("%s: %d iterations, %d with a float basis, %d with a bfloat16 basis\n", solvers[s], iters, iters_float, iters_bf16);
+        UNITTEST_ASSERT_TRUE(status == AMGX_ST_CONVERGED);
+        UNITTEST_ASSERT_TRUE(status_float == AMGX_ST_CONVERGED);
+        UNITTEST_ASSERT_TRUE(status_bf16 == AMGX_ST_CONVERGED);
+        UNITTEST_ASSERT_TRUE(iters_float <= iters + 2);
+
+        if (s == 1)
+        {
+            AMGX_STATUS status_fixed;
+            int iters_fixed = solve(base + ", gm:fgmres_fixed_preconditioner=1", A, b, status_fixed);
+            PrintOnFail("FGMRES: %d iterations with a fixed preconditioner\n", iters_fixed);
+            UNITTEST_ASSERT_TRUE(status_fixed == AMGX_ST_CONVERGED);
+            UNITTEST_ASSERT_TRUE(iters_fixed <= iters + 1);
+        }
+    }
+}
+
+DECLARE_UNITTEST_END(GMRESBasisStorage);
+
+GMRESBasisStorage <TemplateMode<AMGX_mode_dDDI>::Type> GMRESBasisStorage_dDDI;
+
+} //namespace amgx
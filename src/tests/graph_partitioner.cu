@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include <distributed/graph_partitioner.h>
+#include "test_utils.h"
+
+namespace amgx
+
+{
+
+// checks validity, balance and determinism of the k-way partitioner, and that it cuts
+// fewer edges than the equal-rows split on a 3D Poisson problem
+DECLARE_UNITTEST_BEGIN(GraphPartitionerTest);
+
+void run()
+{
+    Matrix_h A;
+    generatePoissonForTest(A, 1, 0, 7, 24, 24, 24);
+    const int n = A.get_num_rows();
+    const double imbalance = 1.05;
+
+    for (int num_parts = 4; num_parts <= 16; num_parts *= 2)
+    {
+        std::vector<int> part(n, -1), part2(n, -1);
+        int64_t cut = partitionGraphKway(n, A.row_offsets.raw(), A.col_indices.raw(), num_parts, part.data(), imbalance);
+        partitionGraphKway(n, A.row_offsets.raw(), A.col_indices.raw(), num_parts, part2.data(), imbalance);
+        UNITTEST_ASSERT_TRUE(part == part2);
+        std::vector<int> sizes(num_parts, 0);
+
+        for (int i = 0; i < n; i++)
+        {
+            UNITTEST_ASSERT_TRUE(part[i] >= 0 && part[i] < num_parts);
+            sizes[part[i]]++;
+        }
+
+        for (int p = 0; p < num_parts; p++)
+        {
+            PrintOnFail("part %d of %d has %d rows\n", p, num_parts, sizes[p]);
+            UNITTEST_ASSERT_TRUE(sizes[p] > 0 && sizes[p] <= imbalance * n / num_parts + 1);
+        }
+
+        // equal-rows split of a lexicographic grid cuts num_parts - 1 full planes
+        int64_t equal_rows_cut = 0;
+
+        for (int i = 0; i < n; i++)
+        {
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                int j = A.col_indices[jj];
+                equal_rows_cut += (j > i && (int64_t)i * num_parts / n != (int64_t)j * num_parts / n) ? 1 : 0;
+            }
+        }
+
+        PrintOnFail("%d parts: edge cut %ld, equal rows edge cut %ld\n", num_parts, (long)cut, (long)equal_rows_cut);
+        UNITTEST_ASSERT_TRUE(cut <= equal_rows_cut);
+    }
+}
+
+DECLARE_UNITTEST_END(GraphPartitionerTest);
+
+GraphPartitionerTest <TemplateMode<AMGX_mode_hDDI>::Type> GraphPartitionerTest_hDDI;
+
+} //namespace amgx
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2011 - 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+#include "amgx_c.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace amgx
+{
+
+// a solver set up from an imported coarse-grid structure has to rebuild the same hierarchy
+// and converge in the same number of iterations as the solver the structure was taken from
+DECLARE_UNITTEST_BEGIN(HierarchyCheckpoint);
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 27, 20, 20, 20);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.), x0(A.get_num_rows(), 0.);
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString("config_version=2, solver(pcg)=PCG, pcg:preconditioner(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_iters=1, amg:max_levels=10, pcg:max_iters=100, pcg:tolerance=1e-8, pcg:monitor_residual=1") == AMGX_OK);
+    Resources res;
+    AMGX_STATUS status;
+    std::vector<std::vector<int> > structure, structure_restored;
+    int iters, iters_restored;
+    {
+        AMG_Solver<TConfig> solver(&res, cfg);
+        VVector x = x0;
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+        UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+        iters = solver.get_num_iters();
+        UNITTEST_ASSERT_TRUE(solver.getSolverObject()->exportCoarseStructure(structure));
+    }
+    {
+        AMG_Solver<TConfig> solver(&res, cfg);
+        VVector x = x0;
+        UNITTEST_ASSERT_TRUE(solver.getSolverObject()->importCoarseStructure(structure));
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+        UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+        iters_restored = solver.get_num_iters();
+        UNITTEST_ASSERT_TRUE(solver.getSolverObject()->exportCoarseStructure(structure_restored));
+    }
+    PrintOnFail("%d levels exported, %d levels after restore\n", (int)structure.size(), (int)structure_restored.size());
+    UNITTEST_ASSERT_TRUE(structure.size() > 1 && structure == structure_restored);
+    PrintOnFail("%d iterations, %d iterations after restore\n", iters, iters_restored);
+    UNITTEST_ASSERT_EQUAL(iters, iters_restored);
+}
+
+DECLARE_UNITTEST_END(HierarchyCheckpoint);
+
+// the same through a file written by AMGX_solver_save_aggregates, a file with an aggregate index
+// out of range is coarsened again and a truncated file is rejected
+DECLARE_UNITTEST_BEGIN(HierarchyCheckpointFile);
+
+// sets up a solver for A, loading the aggregates from load_file if given and saving it to
+// save_file if given, and returns the number of iterations of the solve
+int solve(AMGX_resources_handle rsrc, AMGX_config_handle cfg, AMGX_matrix_handle A, int n, const char *load_file, const char *save_file)
+{
+    AMGX_solver_handle solver;
+    AMGX_vector_handle b, x;
+    std::vector<double> b_h(n, 1.), x_h(n, 0.);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_create(&solver, rsrc, AMGX_mode_dDDI, cfg), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&b, rsrc, AMGX_mode_dDDI), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&x, rsrc, AMGX_mode_dDDI), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_upload(b, n, 1, b_h.data()), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_upload(x, n, 1, x_h.data()), AMGX_RC_OK);
+
+    if (load_file)
+    {
+        UNITTEST_ASSERT_EQUAL(AMGX_solver_load_aggregates(solver, load_file), AMGX_RC_OK);
+    }
+
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_setup(solver, A), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_solve(solver, b, x), AMGX_RC_OK);
+
+    if (save_file)
+    {
+        UNITTEST_ASSERT_EQUAL(AMGX_solver_save_aggregates(solver, save_file), AMGX_RC_OK);
+    }
+
+    int iters;
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_get_iterations_number(solver, &iters), AMGX_RC_OK);
+    AMGX_solver_destroy(solver);
+    AMGX_vector_destroy(b);
+    AMGX_vector_destroy(x);
+    return iters;
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 27, 20, 20, 20);
+    const int n = A_h.get_num_rows();
+    AMGX_config_handle cfg;
+    UNITTEST_ASSERT_EQUAL(AMGX_config_create(&cfg, "config_version=2, solver(pcg)=PCG, pcg:preconditioner(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_iters=1, amg:max_levels=10, pcg:max_iters=100, pcg:tolerance=1e-8, pcg:monitor_residual=1, exception_handling=1"), AMGX_RC_OK);
+    AMGX_resources_handle rsrc;
+    int device = 0;
+    UNITTEST_ASSERT_EQUAL(AMGX_resources_create(&rsrc, cfg, NULL, 1, &device), AMGX_RC_OK);
+    AMGX_matrix_handle A;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_create(&A, rsrc, AMGX_mode_dDDI), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all(A, n, A_h.get_num_nz(), 1, 1, A_h.row_offsets.raw(), A_h.col_indices.raw(), A_h.values.raw(), NULL), AMGX_RC_OK);
+    const char *fname = ".temp_aggregates.bin";
+    const char *fname_copy = ".temp_aggregates_copy.bin";
+    const int iters = solve(rsrc, cfg, A, n, NULL, fname);
+    const int iters_restored = solve(rsrc, cfg, A, n, fname, fname_copy);
+    PrintOnFail("%d iterations, %d iterations after loading the aggregates\n", iters, iters_restored);
+    UNITTEST_ASSERT_EQUAL(iters, iters_restored);
+    std::vector<char> saved, restored;
+    {
+        std::ifstream f1(fname, std::ios::binary), f2(fname_copy, std::ios::binary);
+        saved.assign(std::istreambuf_iterator<char>(f1), std::istreambuf_iterator<char>());
+        restored.assign(std::istreambuf_iterator<char>(f2), std::istreambuf_iterator<char>());
+    }
+    UNITTEST_ASSERT_TRUE(saved.size() > 40 && saved == restored);
+    // first aggregate of the fine level, after the magic, the version and level count, the
+    // level length and the four level sizes
+    std::vector<char> corrupted = saved;
+    const int bad_aggregate = n;
+    std::copy((const char *)&bad_aggregate, (const char *)&bad_aggregate + sizeof(int), corrupted.begin() + 40);
+    {
+        std::ofstream f(fname, std::ios::binary | std::ios::trunc);
+        f.write(corrupted.data(), corrupted.size());
+    }
+    UNITTEST_ASSERT_EQUAL(solve(rsrc, cfg, A, n, fname, fname_copy), iters);
+    {
+        std::ifstream f(fname_copy, std::ios::binary);
+        restored.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    UNITTEST_ASSERT_TRUE(saved == restored);
+    {
+        std::ofstream f(fname, std::ios::binary | std::ios::trunc);
+        f.write(saved.data(), saved.size() / 2);
+    }
+    AMGX_solver_handle solver;
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_create(&solver, rsrc, AMGX_mode_dDDI, cfg), AMGX_RC_OK);
+    UNITTEST_ASSERT_TRUE(AMGX_solver_load_aggregates(solver, fname) != AMGX_RC_OK);
+    AMGX_solver_destroy(solver);
+    std::remove(fname);
+    std::remove(fname_copy);
+    AMGX_matrix_destroy(A);
+    AMGX_resources_destroy(rsrc);
+    AMGX_config_destroy(cfg);
+}
+
+DECLARE_UNITTEST_END(HierarchyCheckpointFile);
+
+// solvers sharing resources with a setup cache reuse the structure of a known matrix
+DECLARE_UNITTEST_BEGIN(SetupStructureCacheTest);
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 27, 20, 20, 20);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.), x0(A.get_num_rows(), 0.);
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString("config_version=2, setup_cache_size=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_iters=100, amg:tolerance=1e-8, amg:monitor_residual=1") == AMGX_OK);
+    int device = 0;
+    Resources res(&cfg, NULL, 1, &device);
+    AMGX_STATUS status;
+    std::vector<std::vector<int> > structure[2];
+    int iters[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        AMG_Solver<TConfig> solver(&res, cfg);
+        VVector x = x0;
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+        UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+        iters[i] = solver.get_num_iters();
+        UNITTEST_ASSERT_TRUE(solver.getSolverObject()->exportCoarseStructure(structure[i]));
+        UNITTEST_ASSERT_EQUAL(res.getSetupCache().size(), (size_t)1);
+        // the first setup misses, the second takes the structure from the cache
+        UNITTEST_ASSERT_EQUAL(res.getSetupCache().hits(), (size_t)i);
+    }
+
+    UNITTEST_ASSERT_TRUE(structure[0].size() > 1 && structure[0] == structure[1]);
+    PrintOnFail("%d iterations, %d iterations from the cached structure\n", iters[0], iters[1]);
+    UNITTEST_ASSERT_EQUAL(iters[0], iters[1]);
+    // without setup_cache_size nothing is stored or looked up
+    AMG_Configuration cfg_off;
+    UNITTEST_ASSERT_TRUE(cfg_off.parseParameterString("config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2") == AMGX_OK);
+    Resources res_off(&cfg_off, NULL, 1, &device);
+    UNITTEST_ASSERT_TRUE(!res_off.getSetupCache().enabled());
+
+    for (int i = 0; i < 2; i++)
+    {
+        AMG_Solver<TConfig> solver(&res_off, cfg_off);
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    }
+
+    UNITTEST_ASSERT_EQUAL(res_off.getSetupCache().size(), (size_t)0);
+    UNITTEST_ASSERT_EQUAL(res_off.getSetupCache().hits(), (size_t)0);
+}
+
+DECLARE_UNITTEST_END(SetupStructureCacheTest);
+
+HierarchyCheckpoint <TemplateMode<AMGX_mode_dDDI>::Type> HierarchyCheckpoint_dDDI;
+HierarchyCheckpointFile <TemplateMode<AMGX_mode_dDDI>::Type> HierarchyCheckpointFile_dDDI;
+SetupStructureCacheTest <TemplateMode<AMGX_mode_dDDI>::Type> SetupStructureCacheTest_dDDI;
+
+} //namespace amgx
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+#include <solvers/algebraic_multigrid_solver.h>
+
+namespace amgx
+{
+
+// the levels amg_host_levels_auto moves to the host are the coarse tail with the largest gain in
+// the recorded cycle costs, the hierarchy really has them on the host, and wherever they are the
+// cycle computes the same correction
+DECLARE_UNITTEST_BEGIN(HostLevelsAuto);
+
+typedef AMG<TConfig::vecPrec, TConfig::matPrec, TConfig::indPrec> AMGType;
+
+int solve(const std::string &config_string, MatrixA &A, VVector &b, AMGX_STATUS &status)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string.c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    VVector x(A.get_num_rows(), 0.);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+    return solver.get_num_iters();
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 7, 32, 32, 32);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.);
+    const std::string base = "config_version=2, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother=JACOBI_L1, amg:max_iters=100, amg:tolerance=1e-8, amg:monitor_residual=1";
+    AMGX_STATUS status, status_auto;
+    int iters = solve(base, A, b, status);
+    int iters_auto = solve(base + ", amg:amg_host_levels_auto=1", A, b, status_auto);
+    PrintOnFail("%d iterations, %d with the coarse levels placed by the cost model\n", iters, iters_auto);
+    UNITTEST_ASSERT_TRUE(status == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(status_auto == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(std::abs(iters - iters_auto) <= 1);
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString((base + ", amg:amg_host_levels_auto=1").c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    AlgebraicMultigrid_Solver<TConfig> *amg_solver = dynamic_cast<AlgebraicMultigrid_Solver<TConfig> *>(solver.getSolverObject());
+    UNITTEST_ASSERT_TRUE(amg_solver != NULL);
+    const std::vector<typename AMGType::LevelPlacement> &placement = amg_solver->getAMG().getLevelPlacement();
+    HierarchyDiagnostics diagnostics;
+    UNITTEST_ASSERT_TRUE(amg_solver->getDiagnostics(diagnostics));
+    const int num_levels = (int)diagnostics.levels.size();
+    const int num_timed = (int)placement.size();
+    // at least the coarsest level is timed, never the finest
+    UNITTEST_ASSERT_TRUE(num_timed >= 1 && num_timed < num_levels);
+    // the cost model: the moved levels are the tail whose cycle gain minus the transfer at its first
+    // level is largest, if that is positive
+    int first_moved = num_timed;
+    double tail_gain = 0., best_gain = 0.;
+
+    for (int k = num_timed - 1; k >= 0; k--)
+    {
+        UNITTEST_ASSERT_EQUAL(placement[k].level, num_levels - num_timed + k);
+        tail_gain += placement[k].device_time - placement[k].host_time;
+
+        if (tail_gain - placement[k].transfer_time > best_gain)
+        {
+            best_gain = tail_gain - placement[k].transfer_time;
+            first_moved = k;
+        }
+    }
+
+    const typename AMGType::LevelPlacement &coarsest = placement.back();
+    PrintOnFail("%d levels, %d timed, first moved %d; coarsest: device %e s, host %e s, transfer %e s\n", num_levels, num_timed, first_moved, coarsest.device_time, coarsest.host_time, coarsest.transfer_time);
+
+    for (int k = 0; k < num_timed; k++)
+    {
+        UNITTEST_ASSERT_EQUAL(placement[k].on_host, k >= first_moved);
+    }
+
+    // a coarsest level that is cheaper on the host including the transfer has to be moved
+    if (coarsest.host_time + coarsest.transfer_time < coarsest.device_time)
+    {
+        UNITTEST_ASSERT_TRUE(first_moved < num_timed);
+    }
+
+    // and the hierarchy has exactly those levels on the host
+    for (int l = 0; l < num_levels; l++)
+    {
+        PrintOnFail("level %d\n", l);
+        UNITTEST_ASSERT_EQUAL(diagnostics.levels[l].on_host, l >= num_levels - num_timed + first_moved);
+    }
+}
+
+DECLARE_UNITTEST_END(HostLevelsAuto);
+
+HostLevelsAuto <TemplateMode<AMGX_mode_dDDI>::Type> HostLevelsAuto_dDDI;
+
+} //namespace amgx
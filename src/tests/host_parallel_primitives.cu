@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include <thrust_wrapper.h>
+#include "resources.h"
+
+namespace amgx
+{
+
+// host primitives have to give the same results on the OpenMP backend as on the sequential one
+DECLARE_UNITTEST_BEGIN(HostParallelPrimitives);
+
+void run()
+{
+    const size_t saved_threshold = getHostParallelThreshold();
+    const int n = 100000;
+    IVector_h keys(n), values(n);
+    srand(1);
+
+    for (int i = 0; i < n; i++)
+    {
+        keys[i] = rand() % 1000;
+        values[i] = i;
+    }
+
+    IVector_h keys_seq = keys, values_seq = values, scan_seq(n);
+    IVector_h keys_par = keys, values_par = values, scan_par(n);
+    setHostParallelThreshold(0);
+    thrust_wrapper::stable_sort_by_key<AMGX_host>(keys_seq.begin(), keys_seq.end(), values_seq.begin());
+    thrust_wrapper::exclusive_scan<AMGX_host>(keys_seq.begin(), keys_seq.end(), scan_seq.begin());
+    int sum_seq = thrust_wrapper::reduce<AMGX_host>(keys_seq.begin(), keys_seq.end());
+    setHostParallelThreshold(1024);
+    thrust_wrapper::stable_sort_by_key<AMGX_host>(keys_par.begin(), keys_par.end(), values_par.begin());
+    thrust_wrapper::exclusive_scan<AMGX_host>(keys_par.begin(), keys_par.end(), scan_par.begin());
+    int sum_par = thrust_wrapper::reduce<AMGX_host>(keys_par.begin(), keys_par.end());
+    setHostParallelThreshold(saved_threshold);
+    UNITTEST_ASSERT_EQUAL(keys_seq, keys_par);
+    UNITTEST_ASSERT_EQUAL(values_seq, values_par);
+    UNITTEST_ASSERT_EQUAL(scan_seq, scan_par);
+    UNITTEST_ASSERT_EQUAL(sum_seq, sum_par);
+}
+
+DECLARE_UNITTEST_END(HostParallelPrimitives);
+
+// the threshold follows the resources whose work the thread is doing, creating resources does not
+// change it for anyone else
+DECLARE_UNITTEST_BEGIN(HostParallelThresholdScope);
+
+void run()
+{
+    const size_t saved_threshold = getHostParallelThreshold();
+    AMG_Configuration cfg_a, cfg_b;
+    UNITTEST_ASSERT_TRUE(cfg_a.parseParameterString("host_parallel_threshold=100") == AMGX_OK);
+    UNITTEST_ASSERT_TRUE(cfg_b.parseParameterString("host_parallel_threshold=0") == AMGX_OK);
+    int device = 0;
+    Resources res_a(&cfg_a, NULL, 1, &device);
+    Resources res_b(&cfg_b, NULL, 1, &device);
+    UNITTEST_ASSERT_EQUAL(res_a.getHostParallelThreshold(), (size_t)100);
+    UNITTEST_ASSERT_EQUAL(res_b.getHostParallelThreshold(), (size_t)0);
+    UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), saved_threshold);
+    {
+        HostParallelScope scope_a(&res_a);
+        UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), (size_t)100);
+        {
+            HostParallelScope scope_b(&res_b);
+            UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), (size_t)0);
+            HostParallelScope scope_none(NULL);
+            UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), (size_t)0);
+        }
+        UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), (size_t)100);
+    }
+    UNITTEST_ASSERT_EQUAL(getHostParallelThreshold(), saved_threshold);
+}
+
+DECLARE_UNITTEST_END(HostParallelThresholdScope);
+
+HostParallelPrimitives <TemplateMode<AMGX_mode_hDDI>::Type> HostParallelPrimitives_hDDI;
+HostParallelThresholdScope <TemplateMode<AMGX_mode_hDDI>::Type> HostParallelThresholdScope_hDDI;
+
+} //namespace amgx
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+
+namespace amgx
+{
+
+// checking convergence every few iterations or on lagged norms may only add the iterations
+// between the converged residual and the check that sees it, and must end converged
+DECLARE_UNITTEST_BEGIN(LaggedConvergenceCheck);
+
+int solve(const std::string &config_string, MatrixA &A, VVector &b, AMGX_STATUS &status)
+{
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(config_string.c_str()) == AMGX_OK);
+    Resources res;
+    AMG_Solver<TConfig> solver(&res, cfg);
+    VVector x(A.get_num_rows(), 0.);
+    UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(solver.solve(b, x, status), AMGX_OK);
+    return solver.get_num_iters();
+}
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 27, 20, 20, 20);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    VVector b(A.get_num_rows(), 1.);
+    const std::string base = "config_version=2, solver(pcg)=PCG, pcg:preconditioner(bj)=BLOCK_JACOBI, bj:max_iters=1, pcg:max_iters=500, pcg:tolerance=1e-8, pcg:monitor_residual=1";
+    AMGX_STATUS status, status_freq, status_lag;
+    int iters = solve(base, A, b, status);
+    int iters_freq = solve(base + ", pcg:convergence_check_frequency=4", A, b, status_freq);
+    int iters_lag = solve(base + ", pcg:convergence_check_lag=2", A, b, status_lag);
+    PrintOnFail("%d iterations, %d checking every 4th, %d with lag 2\n", iters, iters_freq, iters_lag);
+    UNITTEST_ASSERT_TRUE(status == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(status_freq == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(status_lag == AMGX_ST_CONVERGED);
+    UNITTEST_ASSERT_TRUE(iters_freq % 4 == 0 && iters_freq >= iters && iters_freq < iters + 8);
+    UNITTEST_ASSERT_TRUE(iters_lag >= iters && iters_lag <= iters + 3);
+}
+
+DECLARE_UNITTEST_END(LaggedConvergenceCheck);
+
+LaggedConvergenceCheck <TemplateMode<AMGX_mode_dDDI>::Type> LaggedConvergenceCheck_dDDI;
+
+} //namespace amgx
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <amgx_c.h>
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include <multiply.h>
+#include <blas.h>
+
+namespace amgx
+{
+
+// a Krylov solver on a matrix-free operator converges with an AMG preconditioner built from a
+// cheaper surrogate, and with a Jacobi preconditioner built from the diagonal alone
+DECLARE_UNITTEST_BEGIN(MatrixFreeOperatorTest);
+
+// the assembled 27-point operator stands in for the user's matrix-free product
+static void apply_operator(const void *x, void *y, void *user_data)
+{
+    Matrix_d &A = *static_cast<Matrix_d *>(user_data);
+    int n = A.get_num_rows();
+    Vector_d xv(n), yv(n);
+    cudaMemcpy(xv.raw(), x, n * sizeof(double), cudaMemcpyDefault);
+    multiply(A, xv, yv);
+    cudaMemcpy(y, yv.raw(), n * sizeof(double), cudaMemcpyDefault);
+}
+
+void solve(const char *config_string, Matrix_d &A, Matrix_h *surrogate, const std::vector<double> &diag, std::vector<double> &x_vec, AMGX_SOLVE_STATUS &status)
+{
+    int n = A.get_num_rows();
+    AMGX_config_handle rsrc_cfg = NULL;
+    UNITTEST_ASSERT_EQUAL(AMGX_config_create(&rsrc_cfg, ""), AMGX_OK);
+    int device = 0;
+    AMGX_resources_handle rsrc = NULL;
+    UNITTEST_ASSERT_EQUAL(AMGX_resources_create(&rsrc, rsrc_cfg, NULL, 1, &device), AMGX_OK);
+    AMGX_config_handle cfg;
+    UNITTEST_ASSERT_EQUAL(AMGX_config_create(&cfg, config_string), AMGX_OK);
+    AMGX_solver_handle solver;
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_create(&solver, rsrc, AMGX_mode_dDDI, cfg), AMGX_OK);
+    AMGX_matrix_handle matrix = NULL;
+
+    if (surrogate)
+    {
+        UNITTEST_ASSERT_EQUAL(AMGX_matrix_create(&matrix, rsrc, AMGX_mode_dDDI), AMGX_OK);
+        UNITTEST_ASSERT_EQUAL(AMGX_matrix_upload_all(matrix, n, surrogate->get_num_nz(), 1, 1, surrogate->row_offsets.raw(), surrogate->col_indices.raw(), surrogate->values.raw(), NULL), AMGX_OK);
+    }
+
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_setup_matrix_free(solver, n, 1, apply_operator, &A, surrogate ? NULL : &diag[0], matrix), AMGX_OK);
+    std::vector<double> b_vec(n, 1.);
+    x_vec.assign(n, 0.);
+    AMGX_vector_handle b, x;
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&b, rsrc, AMGX_mode_dDDI), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&x, rsrc, AMGX_mode_dDDI), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_upload(b, n, 1, &b_vec[0]), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_upload(x, n, 1, &x_vec[0]), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_solve(solver, b, x), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_get_status(solver, &status), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_download(x, &x_vec[0]), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_destroy(solver), AMGX_OK);
+
+    if (matrix)
+    {
+        UNITTEST_ASSERT_EQUAL(AMGX_matrix_destroy(matrix), AMGX_OK);
+    }
+
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_destroy(b), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_destroy(x), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_config_destroy(cfg), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_config_destroy(rsrc_cfg), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_resources_destroy(rsrc), AMGX_OK);
+}
+
+// ||1 - A x|| / ||1|| with the assembled operator
+double relative_residual(Matrix_d &A, const std::vector<double> &x_vec)
+{
+    int n = A.get_num_rows();
+    Vector_h xh(n);
+    std::copy(x_vec.begin(), x_vec.end(), xh.begin());
+    Vector_d x = xh, r(n);
+    multiply(A, x, r);
+    Vector_h rh = r;
+    double nrm = 0.;
+
+    for (int i = 0; i < n; i++)
+    {
+        nrm += (1. - rh[i]) * (1. - rh[i]);
+    }
+
+    return std::sqrt(nrm / n);
+}
+
+void run()
+{
+    SignalHandler::hook();
+    AMGX_finalize();
+    UnitTest::amgx_intialized = false;
+    AMGX_initialize();
+    UnitTest::amgx_intialized = true;
+    Matrix_h A_h, surrogate;
+    generatePoissonForTest(A_h, 1, 0, 27, 24, 24, 24);
+    generatePoissonForTest(surrogate, 1, 0, 7, 24, 24, 24);
+    Matrix_d A = A_h;
+    A.set_initialized(0);
+    A.computeDiagonal();
+    A.set_initialized(1);
+    int n = A_h.get_num_rows();
+    std::vector<double> diag(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = A_h.row_offsets[i]; j < A_h.row_offsets[i + 1]; j++)
+        {
+            if (A_h.col_indices[j] == i)
+            {
+                diag[i] = A_h.values[j];
+            }
+        }
+    }
+
+    std::vector<double> x_vec;
+    AMGX_SOLVE_STATUS status;
+    solve("config_version=2, solver(pcg)=PCG, pcg:max_iters=200, pcg:tolerance=1e-8, pcg:monitor_residual=1, pcg:preconditioner(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother=JACOBI_L1, amg:max_iters=1",
+          A, &surrogate, diag, x_vec, status);
+    UNITTEST_ASSERT_TRUE(status == AMGX_SOLVE_SUCCESS);
+    UNITTEST_ASSERT_TRUE(relative_residual(A, x_vec) < 1e-6);
+    solve("config_version=2, solver(pcg)=PCG, pcg:max_iters=500, pcg:tolerance=1e-8, pcg:monitor_residual=1, pcg:preconditioner(bj)=BLOCK_JACOBI, bj:max_iters=1",
+          A, NULL, diag, x_vec, status);
+    UNITTEST_ASSERT_TRUE(status == AMGX_SOLVE_SUCCESS);
+    UNITTEST_ASSERT_TRUE(relative_residual(A, x_vec) < 1e-6);
+}
+
+DECLARE_UNITTEST_END(MatrixFreeOperatorTest);
+
+MatrixFreeOperatorTest <TemplateMode<AMGX_mode_dDDI>::Type> MatrixFreeOperatorTest_dDDI;
+
+} //namespace amgx
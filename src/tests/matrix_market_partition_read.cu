@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include <matrix_io.h>
+#include <fstream>
+
+namespace amgx
+{
+
+// reading the rows of a partition from a row-sorted MatrixMarket file, which locates them by
+// bisection over the file, returns the same rows whether or not the last line ends with a
+// newline and with comment lines in the header and blank lines between and after the entries
+DECLARE_UNITTEST_BEGIN(MatrixMarketPartitionReadTest);
+
+// 1D Laplacian with n rows, blank lines after every seventh entry
+void write(const char *fname, int n, const char *sort_flag, int trailing_blank_lines, bool final_newline)
+{
+    std::ofstream fout(fname, std::ios::binary);
+    fout << "%%MatrixMarket matrix coordinate real general\n";
+    fout << "% written by the partition read test\n";
+    fout << "%%AMGX " << sort_flag << "\n";
+    fout << "%\n";
+    fout << n << " " << n << " " << 3 * n - 2 << "\n";
+    int e = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); j++)
+        {
+            if (e > 0)
+            {
+                fout << "\n";
+            }
+
+            if (e > 0 && e % 7 == 0)
+            {
+                fout << "  \n";
+            }
+
+            fout << i + 1 << " " << j + 1 << " " << (i == j ? 2. : -1.);
+            e++;
+        }
+    }
+
+    for (int k = 0; k < trailing_blank_lines; k++)
+    {
+        fout << "\n";
+    }
+
+    if (final_newline)
+    {
+        fout << "\n";
+    }
+}
+
+void check(const char *fname, int n, const std::vector<int> &part)
+{
+    Matrix_h A;
+    IVector_h rank_rows(part.size());
+    std::copy(part.begin(), part.end(), rank_rows.begin());
+    UNITTEST_ASSERT_TRUE(MatrixIO<TConfig_h>::readSystem(fname, A, AMG_Config(), io_config::MTX, rank_rows) == AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(A.get_num_rows(), (int)part.size());
+
+    for (size_t r = 0; r < part.size(); r++)
+    {
+        const int i = part[r];
+        const int first = std::max(i - 1, 0);
+        PrintOnFail("row %d\n", i);
+        UNITTEST_ASSERT_EQUAL(A.row_offsets[r + 1] - A.row_offsets[r], std::min(i + 1, n - 1) - first + 1);
+
+        for (int k = A.row_offsets[r]; k < A.row_offsets[r + 1]; k++)
+        {
+            const int j = first + k - A.row_offsets[r];
+            UNITTEST_ASSERT_EQUAL(A.col_indices[k], j);
+            UNITTEST_ASSERT_EQUAL(A.values[k], i == j ? 2. : -1.);
+        }
+    }
+}
+
+void run()
+{
+    const int n = 50;
+    const char *fname = ".temp_partition_read.mtx";
+    const char *sort_flags[] = {"rowsorted", "sorted"};
+    // the first rows, a run in the middle and the last rows, whose entries end the file
+    std::vector<int> part;
+
+    for (int i = 0; i < 5; i++) { part.push_back(i); }
+
+    for (int i = 21; i < 23; i++) { part.push_back(i); }
+
+    for (int i = 44; i < n; i++) { part.push_back(i); }
+
+    std::vector<int> last(1, n - 1);
+
+    for (int s = 0; s < 2; s++)
+        for (int trailing = 0; trailing < 3; trailing += 2)
+            for (int newline = 0; newline < 2; newline++)
+            {
+                PrintOnFail("%s, %d blank lines, final newline %d\n", sort_flags[s], trailing, newline);
+                write(fname, n, sort_flags[s], trailing, newline != 0);
+                check(fname, n, part);
+                check(fname, n, last);
+            }
+
+    std::remove(fname);
+}
+
+DECLARE_UNITTEST_END(MatrixMarketPartitionReadTest);
+
+MatrixMarketPartitionReadTest <TemplateMode<AMGX_mode_hDDI>::Type> MatrixMarketPartitionReadTest_hDDI;
+
+} //namespace amgx
@@ -151,11 +151,81 @@ void run()
 DECLARE_UNITTEST_END(MatrixTests);
 
 
+DECLARE_UNITTEST_BEGIN(MatrixTripletAssembly);
+
+void run()
+{
+    // 1D Laplacian assembled element by element: interior nodes receive two contributions
+    const int num_rows = 20;
+    IVector_h I, J;
+    MVector_h V;
+
+    for (int e = num_rows - 2; e >= 0; e--)
+    {
+        const int nodes[2] = {e + 1, e};
+
+        for (int a = 0; a < 2; a++)
+            for (int b = 0; b < 2; b++)
+            {
+                I.push_back(nodes[a]);
+                J.push_back(nodes[b]);
+                V.push_back(nodes[a] == nodes[b] ? 1. : -1.);
+            }
+    }
+
+    MatrixA A;
+    IVector d_I = I, d_J = J;
+    MVector d_V = V;
+    A.assembleFromTriplets(num_rows, d_I, d_J, d_V);
+    Matrix_h h_A = A;
+    UNITTEST_ASSERT_EQUAL(h_A.get_num_rows(), num_rows);
+    UNITTEST_ASSERT_EQUAL(h_A.get_num_nz(), 3 * num_rows - 2);
+    UNITTEST_ASSERT_EQUAL(A.getAssemblyMapSize(), (int)I.size());
+
+    for (int row = 0; row < num_rows; row++)
+    {
+        for (int j = h_A.row_offsets[row]; j < h_A.row_offsets[row + 1]; j++)
+        {
+            const int col = h_A.col_indices[j];
+
+            if (j > h_A.row_offsets[row])
+            {
+                UNITTEST_ASSERT_TRUE(h_A.col_indices[j - 1] < col);
+            }
+
+            const double expected = (col != row) ? -1. : ((row == 0 || row == num_rows - 1) ? 1. : 2.);
+            UNITTEST_ASSERT_EQUAL(h_A.values[j], expected);
+        }
+    }
+
+    // doubling the triplets must double the assembled matrix
+    for (int i = 0; i < V.size(); i++)
+    {
+        V[i] = 2. * V[i];
+    }
+
+    d_V = V;
+    A.replaceAssembledValues(d_V);
+    Matrix_h h_A2 = A;
+
+    for (int j = 0; j < h_A.get_num_nz(); j++)
+    {
+        UNITTEST_ASSERT_EQUAL(h_A2.values[j], 2. * h_A.values[j]);
+    }
+}
+
+DECLARE_UNITTEST_END(MatrixTripletAssembly);
+
+
 // if you want to be able run this test for all available configs you can write this:
 #define AMGX_CASE_LINE(CASE) MatrixTests <TemplateMode<CASE>::Type>  MatrixTests_##CASE;
 AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
 #undef AMGX_CASE_LINE
 
+#define AMGX_CASE_LINE(CASE) MatrixTripletAssembly <TemplateMode<CASE>::Type>  MatrixTripletAssembly_##CASE;
+AMGX_FORALL_BUILDS(AMGX_CASE_LINE)
+#undef AMGX_CASE_LINE
+
 // or run for all device configs
 //#define AMGX_CASE_LINE(CASE) SampleTest <TemplateMode<CASE>::Type>  MatrixTests_##CASE;
 //  AMGX_FORALL_BUILDS_DEVICE(AMGX_CASE_LINE)
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "test_utils.h"
+#include "resources.h"
+
+namespace amgx
+{
+
+// bytes of tag and level charged to owner, in device memory or summed over both spaces
+static size_t accounted_bytes(const void *owner, memory::MemoryTag tag, int level, bool device_only = true)
+{
+    std::vector<memory::MemoryReportEntry> entries;
+    size_t device_peak, pinned_peak;
+    memory::getMemoryReport(owner, entries, device_peak, pinned_peak);
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if ((entries[i].device || !device_only) && entries[i].tag == tag && entries[i].level == level)
+        {
+            bytes += entries[i].current_bytes;
+        }
+    }
+
+    return bytes;
+}
+
+static const char *accounting_config = "config_version=2, memory_accounting=1, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother(sm)=MULTICOLOR_DILU, sm:coloring_level=1, amg:max_iters=1, amg:max_levels=4";
+
+// the AMG setup has to account its coarse matrices, transfer operators and smoothers to the
+// levels that own them and to the resources of the solver, and give the memory back to the same
+// counters when the solver goes away; solvers on resources without accounting are not counted
+DECLARE_UNITTEST_BEGIN(MemoryAccounting);
+
+void run()
+{
+    Matrix_h A_h;
+    generatePoissonForTest(A_h, 1, 0, 7, 32, 32, 32);
+    MatrixA A = A_h;
+    A.computeDiagonal();
+    A.set_initialized(1);
+    const int device = 0;
+    AMG_Configuration cfg, cfg_off;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(accounting_config) == AMGX_OK);
+    UNITTEST_ASSERT_TRUE(cfg_off.parseParameterString("config_version=2, memory_accounting=0, solver(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:max_iters=1, amg:max_levels=4") == AMGX_OK);
+    Resources res(&cfg, NULL, 1, &device);
+    Resources res_off(&cfg_off, NULL, 1, &device);
+    UNITTEST_ASSERT_TRUE(res.getMemoryAccounting() && !res_off.getMemoryAccounting());
+    {
+        AMG_Solver<TConfig> solver(&res, cfg);
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+        PrintOnFail("matrix %zu, transfer %zu, smoother %zu bytes\n", accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1),
+                    accounted_bytes(&res, memory::MEMORY_TAG_TRANSFER, 0), accounted_bytes(&res, memory::MEMORY_TAG_SMOOTHER, 0));
+        // the level 1 matrix has at least its row offsets and one value per row
+        UNITTEST_ASSERT_TRUE(accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1) >= A.get_num_rows() / 8 * sizeof(int));
+        UNITTEST_ASSERT_TRUE(accounted_bytes(&res, memory::MEMORY_TAG_TRANSFER, 0) > 0);
+        UNITTEST_ASSERT_TRUE(accounted_bytes(&res, memory::MEMORY_TAG_SMOOTHER, 0) > 0);
+        const size_t matrix_bytes = accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1);
+        // a second solver on resources without accounting neither shows up on its own nor on res
+        {
+            AMG_Solver<TConfig> solver_off(&res_off, cfg_off);
+            UNITTEST_ASSERT_EQUAL(solver_off.setup(A), AMGX_OK);
+            std::vector<memory::MemoryReportEntry> entries;
+            size_t device_peak, pinned_peak;
+            memory::getMemoryReport(&res_off, entries, device_peak, pinned_peak);
+            UNITTEST_ASSERT_TRUE(entries.empty());
+            UNITTEST_ASSERT_EQUAL(device_peak, (size_t)0);
+            UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1), matrix_bytes);
+        }
+        UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1), matrix_bytes);
+    }
+    UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, memory::MEMORY_TAG_MATRIX, 1), (size_t)0);
+    UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, memory::MEMORY_TAG_TRANSFER, 0), (size_t)0);
+    UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, memory::MEMORY_TAG_SMOOTHER, 0), (size_t)0);
+}
+
+DECLARE_UNITTEST_END(MemoryAccounting);
+
+MemoryAccounting <TemplateMode<AMGX_mode_dDDI>::Type> MemoryAccounting_dDDI;
+
+// only device and pinned host memory is accounted: a host-mode hierarchy lives in pageable memory
+// and charges nothing to the device counters of its levels, and whatever was charged is returned
+DECLARE_UNITTEST_BEGIN(MemoryAccountingHost);
+
+void run()
+{
+    Matrix_h A;
+    generatePoissonForTest(A, 1, 0, 7, 16, 16, 16);
+    A.computeDiagonal();
+    A.set_initialized(1);
+    const int device = 0;
+    AMG_Configuration cfg;
+    UNITTEST_ASSERT_TRUE(cfg.parseParameterString(accounting_config) == AMGX_OK);
+    Resources res(&cfg, NULL, 1, &device);
+    const memory::MemoryTag tags[] = {memory::MEMORY_TAG_MATRIX, memory::MEMORY_TAG_TRANSFER, memory::MEMORY_TAG_SMOOTHER};
+    {
+        AMG_Solver<TConfig> solver(&res, cfg);
+        UNITTEST_ASSERT_EQUAL(solver.setup(A), AMGX_OK);
+
+        for (int t = 0; t < 3; t++)
+            for (int level = 0; level < 4; level++)
+            {
+                PrintOnFail("%s, level %d\n", memory::getMemoryTagName(tags[t]), level);
+                UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, tags[t], level), (size_t)0);
+            }
+    }
+
+    for (int t = 0; t < 3; t++)
+        for (int level = -1; level < 4; level++)
+        {
+            UNITTEST_ASSERT_EQUAL(accounted_bytes(&res, tags[t], level, false), (size_t)0);
+        }
+}
+
+DECLARE_UNITTEST_END(MemoryAccountingHost);
+
+MemoryAccountingHost <TemplateMode<AMGX_mode_hDDI>::Type> MemoryAccountingHost_hDDI;
+
+} //namespace amgx
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include "amg_solver.h"
+#include "amgx_c.h"
+#include "test_utils.h"
+#include <problem_generator.h>
+
+namespace amgx
+{
+
+// every generator gives sorted rows with the expected block size, slabs of rows generated on their
+// own match the whole problem, the symmetric problems are symmetric and the C API uploads them
+DECLARE_UNITTEST_BEGIN(ProblemGeneratorTest);
+
+void check(const char *name, int nx, int ny, int nz, const char *options)
+{
+    const ProblemDesc p = parseProblem(name, nx, ny, nz, options);
+    MatrixA A;
+    generateProblem(p, A);
+    Matrix_h A_h = A;
+    const int n = A_h.get_num_rows();
+    const int bs = A_h.get_block_dimy();
+    const int bs_sq = bs * bs;
+    PrintOnFail("problem %s\n", name);
+    UNITTEST_ASSERT_EQUAL(n, (int)p.num_rows());
+    UNITTEST_ASSERT_EQUAL(bs, p.block_size());
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int jj = A_h.row_offsets[i]; jj < A_h.row_offsets[i + 1]; jj++)
+        {
+            UNITTEST_ASSERT_TRUE(jj == A_h.row_offsets[i] || A_h.col_indices[jj] > A_h.col_indices[jj - 1]);
+
+            if (!p.is_symmetric())
+            {
+                continue;
+            }
+
+            // find the transposed entry
+            const int j = A_h.col_indices[jj];
+            int kk = A_h.row_offsets[j];
+
+            while (kk < A_h.row_offsets[j + 1] && A_h.col_indices[kk] != i) { kk++; }
+
+            UNITTEST_ASSERT_TRUE(kk < A_h.row_offsets[j + 1]);
+
+            for (int a = 0; a < bs; a++)
+                for (int b = 0; b < bs; b++)
+                {
+                    UNITTEST_ASSERT_EQUAL_TOL(A_h.values[jj * bs_sq + a * bs + b], A_h.values[kk * bs_sq + b * bs + a], 1e-12);
+                }
+        }
+    }
+
+    std::vector<int> row_offsets;
+    std::vector<int64_t> col_indices;
+    std::vector<double> values;
+    generateProblemRows(p, n / 3, n, row_offsets, col_indices, values);
+    UNITTEST_ASSERT_EQUAL(row_offsets.back(), A_h.row_offsets[n] - A_h.row_offsets[n / 3]);
+
+    for (int e = 0; e < row_offsets.back(); e++)
+    {
+        UNITTEST_ASSERT_EQUAL((int)col_indices[e], A_h.col_indices[A_h.row_offsets[n / 3] + e]);
+    }
+}
+
+void run()
+{
+    check("poisson5", 12, 10, 1, "");
+    check("poisson7", 8, 7, 6, "");
+    check("poisson9", 12, 10, 1, "");
+    check("poisson27", 8, 7, 6, "");
+    check("aniso", 8, 7, 6, "eps=1e-2");
+    check("rotated_aniso", 12, 10, 1, "eps=1e-3, theta=30");
+    check("jump", 8, 8, 8, "contrast=1e4, jump_blocks=2");
+    check("convdiff", 8, 7, 6, "vx=50, vy=-20, vz=10");
+    check("elasticity", 12, 10, 1, "nu=0.3");
+    check("elasticity", 8, 7, 6, "nu=0.45");
+    check("random_spd", 500, 1, 1, "degree=10, seed=7");
+
+    // the C API path with an AMG solve on the generated system
+    if (TConfig::memSpace != AMGX_device)
+    {
+        return;
+    }
+
+    AMGX_Mode mode = (AMGX_Mode)TConfig::mode;
+    AMGX_config_handle rsrc_cfg = NULL, cfg = NULL;
+    AMGX_resources_handle rsrc = NULL;
+    int device = 0;
+    UNITTEST_ASSERT_EQUAL(AMGX_config_create(&rsrc_cfg, ""), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_resources_create(&rsrc, rsrc_cfg, NULL, 1, &device), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_config_create(&cfg, "config_version=2, solver(pcg)=PCG, pcg:max_iters=200, pcg:tolerance=1e-8, pcg:monitor_residual=1, pcg:preconditioner(amg)=AMG, amg:algorithm=AGGREGATION, amg:selector=SIZE_2, amg:smoother=BLOCK_JACOBI, amg:max_iters=1"), AMGX_OK);
+    AMGX_matrix_handle matrix;
+    AMGX_vector_handle b, x;
+    AMGX_solver_handle solver;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_create(&matrix, rsrc, mode), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&b, rsrc, mode), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_create(&x, rsrc, mode), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_generate_system(matrix, b, x, "poisson7", 8, 8, 8, NULL), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_generate_system(matrix, b, x, "elasticity", 16, 16, 16, NULL), AMGX_RC_OK);
+    int n, bx, by;
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_get_size(matrix, &n, &bx, &by), AMGX_RC_OK);
+    UNITTEST_ASSERT_EQUAL(n, 16 * 16 * 16);
+    UNITTEST_ASSERT_EQUAL(bx, 3);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_create(&solver, rsrc, mode, cfg), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_setup(solver, matrix), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_solve(solver, b, x), AMGX_OK);
+    AMGX_SOLVE_STATUS status;
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_get_status(solver, &status), AMGX_OK);
+    UNITTEST_ASSERT_TRUE(status == AMGX_SOLVE_SUCCESS);
+    UNITTEST_ASSERT_EQUAL(AMGX_solver_destroy(solver), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_destroy(b), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_vector_destroy(x), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_matrix_destroy(matrix), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_config_destroy(cfg), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_resources_destroy(rsrc), AMGX_OK);
+    UNITTEST_ASSERT_EQUAL(AMGX_config_destroy(rsrc_cfg), AMGX_OK);
+}
+
+DECLARE_UNITTEST_END(ProblemGeneratorTest);
+
+ProblemGeneratorTest <TemplateMode<AMGX_mode_dDDI>::Type> ProblemGeneratorTest_dDDI;
+ProblemGeneratorTest <TemplateMode<AMGX_mode_hDDI>::Type> ProblemGeneratorTest_hDDI;
+
+} //namespace amgx
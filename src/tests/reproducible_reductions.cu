@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "unit_test.h"
+#include <blas.h>
+#include <thrust_wrapper.h>
+#include "resources.h"
+
+namespace amgx
+{
+
+// reproducible dot products and norms have to be bitwise identical whether the host runs them on one
+// thread or on all of them, and agree with the fast path up to rounding
+DECLARE_UNITTEST_BEGIN(ReproducibleReductions);
+
+void run()
+{
+    const size_t saved_threshold = getHostParallelThreshold();
+    const bool saved_reproducible = getReproducibleReductions();
+    // not a multiple of the chunk size, and large enough for more than one pass over the chunk sums
+    const int n = 5000000 + 123;
+    Vector_h x(n), y(n);
+    x.set_block_dimx(1);
+    x.set_block_dimy(1);
+    y.set_block_dimx(1);
+    y.set_block_dimy(1);
+    srand(1);
+
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = (ValueTypeB)rand() / RAND_MAX - 0.5;
+        y[i] = (ValueTypeB)rand() / RAND_MAX * 1e3;
+    }
+
+    setReproducibleReductions(false);
+    ValueTypeB dot_fast = dotc(x, y);
+    ValueTypeB nrm2_fast = nrm2(x);
+    setReproducibleReductions(true);
+    setHostParallelThreshold(0);
+    ValueTypeB dot_seq = dotc(x, y);
+    ValueTypeB nrm1_seq = nrm1(y);
+    ValueTypeB nrm2_seq = nrm2(x);
+    setHostParallelThreshold(1);
+    ValueTypeB dot_par = dotc(x, y);
+    ValueTypeB nrm1_par = nrm1(y);
+    ValueTypeB nrm2_par = nrm2(x);
+    Vector_d x_d = x, y_d = y;
+    ValueTypeB dot_d = dotc(x_d, y_d);
+    ValueTypeB dot_d2 = dotc(x_d, y_d);
+    ValueTypeB nrm2_d = nrm2(x_d);
+    setHostParallelThreshold(saved_threshold);
+    setReproducibleReductions(saved_reproducible);
+    UNITTEST_ASSERT_EQUAL(dot_seq, dot_par);
+    UNITTEST_ASSERT_EQUAL(nrm1_seq, nrm1_par);
+    UNITTEST_ASSERT_EQUAL(nrm2_seq, nrm2_par);
+    UNITTEST_ASSERT_EQUAL(dot_d, dot_d2);
+    UNITTEST_ASSERT_EQUAL_TOL(dot_seq, dot_fast, 1e-8 * std::fabs(dot_fast));
+    UNITTEST_ASSERT_EQUAL_TOL(nrm2_seq, nrm2_fast, 1e-12 * nrm2_fast);
+    UNITTEST_ASSERT_EQUAL_TOL(dot_d, dot_seq, 1e-8 * std::fabs(dot_seq));
+    UNITTEST_ASSERT_EQUAL_TOL(nrm2_d, nrm2_seq, 1e-12 * nrm2_seq);
+}
+
+DECLARE_UNITTEST_END(ReproducibleReductions);
+
+// the flag follows the resources whose work the thread is doing, creating resources does not
+// change it for anyone else
+DECLARE_UNITTEST_BEGIN(ReproducibleReductionsScopeTest);
+
+void run()
+{
+    const bool saved_reproducible = getReproducibleReductions();
+    AMG_Configuration cfg_a, cfg_b;
+    UNITTEST_ASSERT_TRUE(cfg_a.parseParameterString("reproducible_reductions=1") == AMGX_OK);
+    UNITTEST_ASSERT_TRUE(cfg_b.parseParameterString("reproducible_reductions=0") == AMGX_OK);
+    int device = 0;
+    Resources res_a(&cfg_a, NULL, 1, &device);
+    Resources res_b(&cfg_b, NULL, 1, &device);
+    UNITTEST_ASSERT_TRUE(res_a.getReproducibleReductions());
+    UNITTEST_ASSERT_TRUE(!res_b.getReproducibleReductions());
+    UNITTEST_ASSERT_EQUAL(getReproducibleReductions(), saved_reproducible);
+    {
+        ReproducibleReductionsScope scope_a(&res_a);
+        UNITTEST_ASSERT_TRUE(getReproducibleReductions());
+        {
+            ReproducibleReductionsScope scope_b(&res_b);
+            UNITTEST_ASSERT_TRUE(!getReproducibleReductions());
+            ReproducibleReductionsScope scope_none(NULL);
+            UNITTEST_ASSERT_TRUE(!getReproducibleReductions());
+        }
+        UNITTEST_ASSERT_TRUE(getReproducibleReductions());
+    }
+    UNITTEST_ASSERT_EQUAL(getReproducibleReductions(), saved_reproducible);
+}
+
+DECLARE_UNITTEST_END(ReproducibleReductionsScopeTest);
+
+ReproducibleReductions <TemplateMode<AMGX_mode_dDDI>::Type> ReproducibleReductions_dDDI;
+ReproducibleReductionsScopeTest <TemplateMode<AMGX_mode_hDDI>::Type> ReproducibleReductionsScopeTest_hDDI;
+
+} //namespace amgx
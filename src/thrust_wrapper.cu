@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2024 NVIDIA CORPORATION. All Rights Reserved.
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <thrust_wrapper.h>
+#include <resources.h>
+
+namespace amgx
+{
+
+namespace
+{
+// default of the host_parallel_threshold parameter
+thread_local size_t host_parallel_threshold = 32768;
+}
+
+void setHostParallelThreshold(size_t threshold)
+{
+    host_parallel_threshold = threshold;
+}
+
+size_t getHostParallelThreshold()
+{
+    return host_parallel_threshold;
+}
+
+HostParallelScope::HostParallelScope(const Resources *res) : m_previous(host_parallel_threshold)
+{
+    if (res != NULL)
+    {
+        host_parallel_threshold = res->getHostParallelThreshold();
+    }
+}
+
+HostParallelScope::~HostParallelScope()
+{
+    host_parallel_threshold = m_previous;
+}
+
+} // namespace amgx